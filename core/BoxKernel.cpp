@@ -0,0 +1,146 @@
+#include "BoxKernel.h"
+#include "SimdConfig.h"
+
+#include <cstring>
+#include <limits>
+
+
+// Overlap function: Same separating axis test as SimBox::Overlaps, a lane at a time.
+void BoxKernel::Overlap(const SimBox& _box, const float* _lefts, const float* _tops, const float* _rights, const float* _bottoms,
+	size_t count, uint32_t* outMasks)
+{
+#if defined(IA_SIMD_AVX)
+	std::memset(outMasks, 0, MaskWords(count) * sizeof(uint32_t));
+
+	const __m256 qLeft = _mm256_set1_ps(_box.mLeft);
+	const __m256 qTop = _mm256_set1_ps(_box.mTop);
+	const __m256 qRight = _mm256_set1_ps(_box.mRight);
+	const __m256 qBottom = _mm256_set1_ps(_box.mBottom);
+
+	for (size_t i = 0; i < count; i += 8)
+	{
+		// Overlapping when no axis separates them, i.e. the negation of each early out in SimBox::Overlaps
+		__m256 hit = _mm256_and_ps(
+			_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(_lefts + i), qRight, _CMP_LE_OQ),
+				_mm256_cmp_ps(qLeft, _mm256_loadu_ps(_rights + i), _CMP_LE_OQ)),
+			_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(_tops + i), qBottom, _CMP_LE_OQ),
+				_mm256_cmp_ps(qTop, _mm256_loadu_ps(_bottoms + i), _CMP_LE_OQ)));
+
+		outMasks[i / 32] |= (uint32_t)_mm256_movemask_ps(hit) << (i % 32);
+	}
+
+#elif defined(IA_SIMD_SSE)
+	std::memset(outMasks, 0, MaskWords(count) * sizeof(uint32_t));
+
+	const __m128 qLeft = _mm_set1_ps(_box.mLeft);
+	const __m128 qTop = _mm_set1_ps(_box.mTop);
+	const __m128 qRight = _mm_set1_ps(_box.mRight);
+	const __m128 qBottom = _mm_set1_ps(_box.mBottom);
+
+	for (size_t i = 0; i < count; i += 4)
+	{
+		// Overlapping when no axis separates them, i.e. the negation of each early out in SimBox::Overlaps
+		__m128 hit = _mm_and_ps(
+			_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(_lefts + i), qRight),
+				_mm_cmple_ps(qLeft, _mm_loadu_ps(_rights + i))),
+			_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(_tops + i), qBottom),
+				_mm_cmple_ps(qTop, _mm_loadu_ps(_bottoms + i))));
+
+		outMasks[i / 32] |= (uint32_t)_mm_movemask_ps(hit) << (i % 32);
+	}
+
+#else
+	OverlapScalar(_box, _lefts, _tops, _rights, _bottoms, count, outMasks);
+	return;
+#endif
+
+	// The last group of lanes may have run past count into the padding
+	if (count % 32)
+		outMasks[count / 32] &= (1u << (count % 32)) - 1;
+}
+
+// OverlapScalar function: One box at a time, same results as Overlap.
+void BoxKernel::OverlapScalar(const SimBox& _box, const float* _lefts, const float* _tops, const float* _rights, const float* _bottoms,
+	size_t count, uint32_t* outMasks)
+{
+	std::memset(outMasks, 0, MaskWords(count) * sizeof(uint32_t));
+
+	for (size_t i = 0; i < count; i++)
+	{
+		bool hit = _lefts[i] <= _box.mRight && _box.mLeft <= _rights[i] &&
+			_tops[i] <= _box.mBottom && _box.mTop <= _bottoms[i];
+
+		outMasks[i / 32] |= (uint32_t)hit << (i % 32);
+	}
+}
+
+// OverlapSet function: Runs the kernel once per box, each writing its own row of masks.
+void BoxKernel::OverlapSet(const SimBox* _boxes, size_t numBoxes, const float* _lefts, const float* _tops, const float* _rights,
+	const float* _bottoms, size_t count, uint32_t* outMasks)
+{
+	size_t words = MaskWords(count);
+	for (size_t j = 0; j < numBoxes; j++)
+		Overlap(_boxes[j], _lefts, _tops, _rights, _bottoms, count, outMasks + j * words);
+}
+
+// FirstHit function: Scans the words for the first non-zero one and finds its lowest bit.
+int BoxKernel::FirstHit(const uint32_t* _masks, size_t count)
+{
+	size_t words = MaskWords(count);
+	for (size_t w = 0; w < words; w++)
+	{
+		uint32_t mask = _masks[w];
+		if (!mask)
+			continue;
+
+		int bit = 0;
+		while (!(mask & 1u))
+		{
+			mask >>= 1;
+			bit++;
+		}
+
+		return (int)(w * 32) + bit;
+	}
+
+	return -1;
+}
+
+// Add function: Grows the arrays a whole group of lanes at a time so the kernel never reads past the end.
+void BoxBatch::Add(const SimBox& _box)
+{
+	if (mCount == mLeft.size())
+	{
+		size_t padded = mCount + BoxKernel::LANES;
+		mLeft.resize(padded, 0.0f);
+		mTop.resize(padded, 0.0f);
+		mRight.resize(padded, 0.0f);
+		mBottom.resize(padded, 0.0f);
+	}
+
+	mLeft[mCount] = _box.mLeft;
+	mTop[mCount] = _box.mTop;
+	mRight[mCount] = _box.mRight;
+	mBottom[mCount] = _box.mBottom;
+	mCount++;
+}
+
+// AddNone function: An inside out box, its left is past every right so it can never overlap.
+void BoxBatch::AddNone()
+{
+	const float inf = std::numeric_limits<float>::infinity();
+
+	SimBox none;
+	none.UpdateBox(inf, inf, -inf, -inf);
+	Add(none);
+}
+
+// Overlap function: Runs the kernel over the batch.
+void BoxBatch::Overlap(const SimBox& _box, std::vector<uint32_t>& outMasks) const
+{
+	outMasks.resize(BoxKernel::MaskWords(mCount));
+	if (mCount == 0)
+		return;
+
+	BoxKernel::Overlap(_box, mLeft.data(), mTop.data(), mRight.data(), mBottom.data(), mCount, outMasks.data());
+}
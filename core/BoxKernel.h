@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "SimTypes.h"
+
+
+// BoxKernel namespace: Batched version of SimBox::Overlaps.
+// Tests one box against a packed structure-of-arrays run of boxes and writes
+// a hit bitmask, bit i of word i / 32 is set when box i overlaps. Uses AVX or
+// SSE2 where SimdConfig.h finds them and a plain loop everywhere else, all
+// three give identical results to calling SimBox::Overlaps one pair at a time.
+namespace BoxKernel
+{
+    // The edge arrays must be readable up to count rounded up to a multiple of LANES,
+    // bits for the padding past count are always cleared.
+    static const size_t LANES = 8;
+
+    // MaskWords function: Number of 32 bit words needed to hold the hit bits for count boxes.
+    inline size_t MaskWords(size_t count) { return (count + 31) / 32; }
+
+    // Overlap function: Tests _box against count packed boxes using the widest SIMD available.
+    void Overlap(const SimBox& _box, const float* _lefts, const float* _tops, const float* _rights, const float* _bottoms,
+        size_t count, uint32_t* outMasks);
+
+    // OverlapScalar function: Plain loop version of Overlap, used when no SIMD is available and for benchmarking.
+    void OverlapScalar(const SimBox& _box, const float* _lefts, const float* _tops, const float* _rights, const float* _bottoms,
+        size_t count, uint32_t* outMasks);
+
+    // OverlapSet function: Tests a small set of boxes against the packed boxes,
+    // box j's hits are written to the MaskWords(count) words starting at outMasks + j * MaskWords(count).
+    void OverlapSet(const SimBox* _boxes, size_t numBoxes, const float* _lefts, const float* _tops, const float* _rights,
+        const float* _bottoms, size_t count, uint32_t* outMasks);
+
+    // FirstHit function: Index of the lowest set bit, or -1 when nothing was hit.
+    int FirstHit(const uint32_t* _masks, size_t count);
+}
+
+// BoxBatch class: Packs boxes into the padded edge arrays the kernel reads.
+// Used to gather broadphase candidates so they can be tested in a single call.
+class BoxBatch
+{
+public:
+    void Clear() { mCount = 0; }   // Empties the batch, keeps the memory.
+    void Add(const SimBox& _box);  // Appends a box.
+    void AddNone();                // Appends a box that never overlaps anything, keeps indices lined up.
+
+    // Overlap function: Tests _box against every box in the batch, resizing outMasks to fit.
+    void Overlap(const SimBox& _box, std::vector<uint32_t>& outMasks) const;
+
+    size_t Size() const { return mCount; }
+    const float* GetLefts() const { return mLeft.data(); }
+    const float* GetTops() const { return mTop.data(); }
+    const float* GetRights() const { return mRight.data(); }
+    const float* GetBottoms() const { return mBottom.data(); }
+
+private:
+    std::vector<float> mLeft, mTop, mRight, mBottom;  // Always a multiple of BoxKernel::LANES long.
+    size_t mCount = 0;                                // Number of boxes actually in the batch.
+};
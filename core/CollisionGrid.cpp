@@ -0,0 +1,123 @@
+#include "CollisionGrid.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+
+// Init function: Works out how many cells cover the area and empties every layer.
+void CollisionGrid::Init(float _width, float _height, float _cellSize)
+{
+	assert(_cellSize > 0);
+
+	mCellSize = _cellSize;
+	mInvCellSize = 1.0f / _cellSize;
+	mColumns = std::max(1, (int)std::ceil(_width * mInvCellSize));
+	mRows = std::max(1, (int)std::ceil(_height * mInvCellSize));
+
+	for (int l = 0; l < LAYER_COUNT; l++)
+	{
+		mCells[l].assign(mColumns * mRows, std::vector<uint32_t>());
+		mRanges[l].clear();
+		mStamps[l].clear();
+	}
+}
+
+// Resize function: Drops anything already on the layer and makes room for count colliders.
+void CollisionGrid::Resize(Layer _layer, size_t count)
+{
+	for (std::vector<uint32_t>& cell : mCells[_layer])
+		cell.clear();
+
+	mRanges[_layer].assign(count, CellRange());
+	mStamps[_layer].assign(count, 0);
+}
+
+// Update function: Only re-registers the collider when the block of cells under it has changed.
+void CollisionGrid::Update(Layer _layer, size_t _index, const SimBox& _box)
+{
+	assert(_index < mRanges[_layer].size());
+
+	CellRange range = GetRange(_box);
+	CellRange& current = mRanges[_layer][_index];
+	if (range == current)
+		return;
+
+	Erase(_layer, (uint32_t)_index, current);
+	Insert(_layer, (uint32_t)_index, range);
+	current = range;
+}
+
+// Remove function: Unregisters the collider from every cell it was in.
+void CollisionGrid::Remove(Layer _layer, size_t _index)
+{
+	assert(_index < mRanges[_layer].size());
+
+	CellRange& current = mRanges[_layer][_index];
+	Erase(_layer, (uint32_t)_index, current);
+	current = CellRange();
+}
+
+// Query function: Gathers the colliders in every cell under the box, using a stamp to skip ones already found.
+void CollisionGrid::Query(Layer _layer, const SimBox& _box, std::vector<uint32_t>& out)
+{
+	out.clear();
+
+	// Once the stamp wraps around every collider's stamp has to be cleared so none look already found
+	if (++mQueryStamp == 0)
+	{
+		for (int l = 0; l < LAYER_COUNT; l++)
+			std::fill(mStamps[l].begin(), mStamps[l].end(), 0);
+		mQueryStamp = 1;
+	}
+
+	CellRange range = GetRange(_box);
+	std::vector<uint32_t>& stamps = mStamps[_layer];
+	for (int y = range.mY0; y <= range.mY1; y++)
+		for (int x = range.mX0; x <= range.mX1; x++)
+			for (uint32_t index : Cell(_layer, x, y))
+				if (stamps[index] != mQueryStamp)
+				{
+					stamps[index] = mQueryStamp;
+					out.push_back(index);
+				}
+
+	// Callers resolve hits in index order, the same order the brute force loops used
+	if (out.size() > 1)
+		std::sort(out.begin(), out.end());
+}
+
+// GetRange function: Converts the box's edges to cell coordinates, clamped to the grid.
+CollisionGrid::CellRange CollisionGrid::GetRange(const SimBox& _box) const
+{
+	CellRange range;
+	range.mX0 = std::clamp((int)std::floor(_box.mLeft * mInvCellSize), 0, mColumns - 1);
+	range.mY0 = std::clamp((int)std::floor(_box.mTop * mInvCellSize), 0, mRows - 1);
+	range.mX1 = std::clamp((int)std::floor(_box.mRight * mInvCellSize), 0, mColumns - 1);
+	range.mY1 = std::clamp((int)std::floor(_box.mBottom * mInvCellSize), 0, mRows - 1);
+	return range;
+}
+
+// Insert function: Adds the collider to each cell in the block.
+void CollisionGrid::Insert(Layer _layer, uint32_t _index, const CellRange& _range)
+{
+	for (int y = _range.mY0; y <= _range.mY1; y++)
+		for (int x = _range.mX0; x <= _range.mX1; x++)
+			Cell(_layer, x, y).push_back(_index);
+}
+
+// Erase function: Swaps the collider out of each cell in the block, cells are small so a linear find is fine.
+void CollisionGrid::Erase(Layer _layer, uint32_t _index, const CellRange& _range)
+{
+	for (int y = _range.mY0; y <= _range.mY1; y++)
+		for (int x = _range.mX0; x <= _range.mX1; x++)
+		{
+			std::vector<uint32_t>& cell = Cell(_layer, x, y);
+			std::vector<uint32_t>::iterator it = std::find(cell.begin(), cell.end(), _index);
+			if (it != cell.end())
+			{
+				*it = cell.back();
+				cell.pop_back();
+			}
+		}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "SimTypes.h"
+
+
+// CollisionGrid class: Uniform grid broadphase for the simulation's colliders.
+// The static-ish colliders (the enemies and the ufo) are registered
+// in every cell their box touches. Each tick they are updated in place and only move
+// between cells when their box actually crosses a cell border, so keeping the grid in
+// sync costs next to nothing for a formation that creeps along a few pixels a frame.
+// Projectiles then query the cells under their own box and only the colliders found
+// there go through the narrowphase overlap test.
+class CollisionGrid
+{
+public:
+    // Layer enum: The kinds of collider held in the grid, queries filter on these.
+    enum Layer { ENEMY, UFO, LAYER_COUNT };
+
+    // Init function: Builds an empty grid covering the given area. Boxes outside of it are clamped to the edge cells.
+    void Init(float _width, float _height, float _cellSize);
+
+    // Resize function: Makes room for count colliders on the given layer, all start outside the grid.
+    void Resize(Layer _layer, size_t count);
+
+    // Update function: Moves a collider to its new box, touching the cells only if it changed cells.
+    void Update(Layer _layer, size_t _index, const SimBox& _box);
+
+    // Remove function: Takes a collider out of the grid, e.g. when an enemy dies.
+    void Remove(Layer _layer, size_t _index);
+
+    // Query function: Fills out with the index of every collider on the layer sharing a cell with the box.
+    // Each collider appears once and the results are in ascending index order.
+    void Query(Layer _layer, const SimBox& _box, std::vector<uint32_t>& out);
+
+    int GetColumns() const { return mColumns; }
+    int GetRows() const { return mRows; }
+
+private:
+    // CellRange struct: The inclusive block of cells a collider is registered in.
+    struct CellRange
+    {
+        int mX0 = 0, mY0 = 0, mX1 = -1, mY1 = -1;  // Empty until the first Update.
+
+        bool IsEmpty() const { return mX1 < mX0; }
+        bool operator==(const CellRange& rhs) const
+        {
+            return mX0 == rhs.mX0 && mY0 == rhs.mY0 && mX1 == rhs.mX1 && mY1 == rhs.mY1;
+        }
+    };
+
+    CellRange GetRange(const SimBox& _box) const;  // Cells covered by a box.
+    void Insert(Layer _layer, uint32_t _index, const CellRange& _range);  // Register a collider in a block of cells.
+    void Erase(Layer _layer, uint32_t _index, const CellRange& _range);   // Unregister a collider from a block of cells.
+    std::vector<uint32_t>& Cell(Layer _layer, int x, int y) { return mCells[_layer][y * mColumns + x]; }
+
+    float mCellSize = 64.0f;
+    float mInvCellSize = 1.0f / 64.0f;
+    int mColumns = 0, mRows = 0;
+
+    std::vector<std::vector<uint32_t>> mCells[LAYER_COUNT];  // Collider indices in each cell, one grid per layer.
+    std::vector<CellRange> mRanges[LAYER_COUNT];              // Where each collider is currently registered.
+    std::vector<uint32_t> mStamps[LAYER_COUNT];               // Last query each collider was reported in, stops duplicates.
+    uint32_t mQueryStamp = 0;
+};
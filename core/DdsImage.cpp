@@ -0,0 +1,304 @@
+#include "DdsImage.h"
+
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+// The parts of the file layout the parser reads, see "DDS" in the Direct3D documentation.
+static const uint32_t DDS_MAGIC = 0x20534444;  // "DDS "
+static const size_t HEADER_SIZE = 4 + 124;     // Magic and DDS_HEADER.
+static const size_t DX10_HEADER_SIZE = 20;
+static const uint32_t MAX_DIMENSION = 16384;   // The largest texture Direct3D 11 allows.
+
+static const uint32_t DDPF_ALPHA = 0x2;
+static const uint32_t DDPF_FOURCC = 0x4;
+static const uint32_t DDPF_RGB = 0x40;
+static const uint32_t DDPF_LUMINANCE = 0x20000;
+static const uint32_t DDSD_DEPTH = 0x800000;
+static const uint32_t DDSCAPS2_CUBEMAP = 0x200;
+static const uint32_t DDSCAPS2_VOLUME = 0x200000;
+static const uint32_t DX10_DIMENSION_TEXTURE2D = 3;
+static const uint32_t DX10_MISC_TEXTURECUBE = 0x4;
+
+
+// PixelFormat struct: DDS_PIXELFORMAT, the format description in the older header.
+struct PixelFormat
+{
+	uint32_t mSize, mFlags, mFourCC, mBitCount, mRMask, mGMask, mBMask, mAMask;
+};
+
+static uint32_t ReadU32(const uint8_t* p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static uint32_t FourCC(const char* code)
+{
+	return (uint32_t)(uint8_t)code[0] | (uint32_t)(uint8_t)code[1] << 8 | (uint32_t)(uint8_t)code[2] << 16 | (uint32_t)(uint8_t)code[3] << 24;
+}
+
+// FromPixelFormat function: The DXGI format the old header describes, the same mapping DirectXTK's loader uses.
+static uint32_t FromPixelFormat(const PixelFormat& pf)
+{
+	auto masks = [&pf](uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+		return pf.mRMask == r && pf.mGMask == g && pf.mBMask == b && pf.mAMask == a;
+		};
+
+	if (pf.mFlags & DDPF_RGB)
+	{
+		if (pf.mBitCount == 32)
+		{
+			if (masks(0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000))
+				return Dds::FORMAT_R8G8B8A8_UNORM;
+			if (masks(0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000))
+				return Dds::FORMAT_B8G8R8A8_UNORM;
+			if (masks(0x00ff0000, 0x0000ff00, 0x000000ff, 0))
+				return Dds::FORMAT_B8G8R8X8_UNORM;
+			if (masks(0x3ff00000, 0x000ffc00, 0x000003ff, 0xc0000000))
+				return Dds::FORMAT_R10G10B10A2_UNORM;  // Written with the masks backwards by most tools
+			if (masks(0x0000ffff, 0xffff0000, 0, 0))
+				return Dds::FORMAT_R16G16_UNORM;
+			if (masks(0xffffffff, 0, 0, 0))
+				return Dds::FORMAT_R32_FLOAT;
+		}
+		else if (pf.mBitCount == 16)
+		{
+			if (masks(0x7c00, 0x03e0, 0x001f, 0x8000))
+				return Dds::FORMAT_B5G5R5A1_UNORM;
+			if (masks(0xf800, 0x07e0, 0x001f, 0))
+				return Dds::FORMAT_B5G6R5_UNORM;
+			if (masks(0x0f00, 0x00f0, 0x000f, 0xf000))
+				return Dds::FORMAT_B4G4R4A4_UNORM;
+		}
+	}
+	else if (pf.mFlags & DDPF_LUMINANCE)
+	{
+		if (pf.mBitCount == 8 && masks(0xff, 0, 0, 0))
+			return Dds::FORMAT_R8_UNORM;
+		if (pf.mBitCount == 16 && masks(0xffff, 0, 0, 0))
+			return Dds::FORMAT_R16_UNORM;
+		if (pf.mBitCount == 16 && masks(0x00ff, 0, 0, 0xff00))
+			return Dds::FORMAT_R8G8_UNORM;
+	}
+	else if (pf.mFlags & DDPF_ALPHA)
+	{
+		if (pf.mBitCount == 8)
+			return Dds::FORMAT_A8_UNORM;
+	}
+	else if (pf.mFlags & DDPF_FOURCC)
+	{
+		uint32_t code = pf.mFourCC;
+		if (code == FourCC("DXT1"))
+			return Dds::FORMAT_BC1_UNORM;
+		if (code == FourCC("DXT2") || code == FourCC("DXT3"))
+			return Dds::FORMAT_BC2_UNORM;
+		if (code == FourCC("DXT4") || code == FourCC("DXT5"))
+			return Dds::FORMAT_BC3_UNORM;
+		if (code == FourCC("ATI1") || code == FourCC("BC4U"))
+			return Dds::FORMAT_BC4_UNORM;
+		if (code == FourCC("BC4S"))
+			return Dds::FORMAT_BC4_SNORM;
+		if (code == FourCC("ATI2") || code == FourCC("BC5U"))
+			return Dds::FORMAT_BC5_UNORM;
+		if (code == FourCC("BC5S"))
+			return Dds::FORMAT_BC5_SNORM;
+
+		// Some writers put a D3DFORMAT number in the FourCC
+		if (code == 36)
+			return Dds::FORMAT_R16G16B16A16_UNORM;
+		if (code == 113)
+			return Dds::FORMAT_R16G16B16A16_FLOAT;
+		if (code == 116)
+			return Dds::FORMAT_R32G32B32A32_FLOAT;
+	}
+	return Dds::FORMAT_UNKNOWN;
+}
+
+// FormatSize function: Bytes in a 4x4 block for the compressed formats, bits per pixel for the rest, 0 if it isn't handled.
+static uint32_t FormatSize(uint32_t format, bool& compressed)
+{
+	compressed = true;
+	switch (format)
+	{
+	case Dds::FORMAT_BC1_UNORM: case Dds::FORMAT_BC1_UNORM_SRGB:
+	case Dds::FORMAT_BC4_UNORM: case Dds::FORMAT_BC4_SNORM:
+		return 8;
+	case Dds::FORMAT_BC2_UNORM: case Dds::FORMAT_BC2_UNORM_SRGB:
+	case Dds::FORMAT_BC3_UNORM: case Dds::FORMAT_BC3_UNORM_SRGB:
+	case Dds::FORMAT_BC5_UNORM: case Dds::FORMAT_BC5_SNORM:
+	case Dds::FORMAT_BC6H_UF16: case Dds::FORMAT_BC6H_SF16:
+	case Dds::FORMAT_BC7_UNORM: case Dds::FORMAT_BC7_UNORM_SRGB:
+		return 16;
+	}
+
+	compressed = false;
+	switch (format)
+	{
+	case Dds::FORMAT_R32G32B32A32_FLOAT:
+		return 128;
+	case Dds::FORMAT_R16G16B16A16_FLOAT: case Dds::FORMAT_R16G16B16A16_UNORM:
+		return 64;
+	case Dds::FORMAT_R10G10B10A2_UNORM: case Dds::FORMAT_R8G8B8A8_UNORM: case Dds::FORMAT_R8G8B8A8_UNORM_SRGB:
+	case Dds::FORMAT_R16G16_UNORM: case Dds::FORMAT_R32_FLOAT:
+	case Dds::FORMAT_B8G8R8A8_UNORM: case Dds::FORMAT_B8G8R8X8_UNORM:
+	case Dds::FORMAT_B8G8R8A8_UNORM_SRGB: case Dds::FORMAT_B8G8R8X8_UNORM_SRGB:
+		return 32;
+	case Dds::FORMAT_R8G8_UNORM: case Dds::FORMAT_R16_UNORM:
+	case Dds::FORMAT_B5G6R5_UNORM: case Dds::FORMAT_B5G5R5A1_UNORM: case Dds::FORMAT_B4G4R4A4_UNORM:
+		return 16;
+	case Dds::FORMAT_R8_UNORM: case Dds::FORMAT_A8_UNORM:
+		return 8;
+	}
+	return 0;
+}
+
+const uint8_t* DdsImage::GetData() const
+{
+	return mpFile ? reinterpret_cast<const uint8_t*>(mpFile->GetData()) : mData.data();
+}
+
+size_t DdsImage::GetSize() const
+{
+	return mpFile ? mpFile->GetSize() : mData.size();
+}
+
+size_t DdsImage::GetPixelBytes() const
+{
+	size_t bytes = 0;
+	for (const Level& level : mLevels)
+		bytes += level.mSize;
+	return bytes;
+}
+
+// ParseHeaders function: Only the headers are read, the pixels stay where they are in the file.
+// Fills in all of out but where the file is, which is up to the caller.
+static bool ParseHeaders(const uint8_t* p, size_t size, DdsImage& out, string& error)
+{
+	out = DdsImage();
+	if (size < HEADER_SIZE || ReadU32(p) != DDS_MAGIC || ReadU32(p + 4) != 124)
+	{
+		error = "not a DDS file";
+		return false;
+	}
+
+	uint32_t flags = ReadU32(p + 8);
+	uint32_t height = ReadU32(p + 12);
+	uint32_t width = ReadU32(p + 16);
+	uint32_t mipCount = max(ReadU32(p + 28), 1u);
+	PixelFormat pf;
+	memcpy(&pf, p + 76, sizeof(pf));
+	uint32_t caps2 = ReadU32(p + 112);
+
+	if ((flags & DDSD_DEPTH) || (caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)))
+	{
+		error = "cube maps and volume textures aren't handled";
+		return false;
+	}
+
+	size_t offset = HEADER_SIZE;
+	uint32_t format;
+	if ((pf.mFlags & DDPF_FOURCC) && pf.mFourCC == FourCC("DX10"))
+	{
+		if (size < HEADER_SIZE + DX10_HEADER_SIZE)
+		{
+			error = "the DX10 header is cut short";
+			return false;
+		}
+		format = ReadU32(p + HEADER_SIZE);
+		if (ReadU32(p + HEADER_SIZE + 4) != DX10_DIMENSION_TEXTURE2D || (ReadU32(p + HEADER_SIZE + 8) & DX10_MISC_TEXTURECUBE) ||
+			ReadU32(p + HEADER_SIZE + 12) > 1)
+		{
+			error = "only single 2D textures are handled";
+			return false;
+		}
+		offset += DX10_HEADER_SIZE;
+	}
+	else
+		format = FromPixelFormat(pf);
+
+	bool compressed;
+	uint32_t formatSize = FormatSize(format, compressed);
+	if (formatSize == 0)
+	{
+		error = "pixel format isn't handled";
+		return false;
+	}
+	if (width == 0 || height == 0 || width > MAX_DIMENSION || height > MAX_DIMENSION)
+	{
+		error = "bad dimensions";
+		return false;
+	}
+
+	// A mip count past a 1x1 level is an error in the file, there's nothing left to halve
+	uint32_t maxMips = 1;
+	while ((max(width, height) >> maxMips) > 0)
+		maxMips++;
+	if (mipCount > maxMips)
+	{
+		error = "more mip levels than the size allows";
+		return false;
+	}
+
+	uint32_t w = width, h = height;
+	for (uint32_t i = 0; i < mipCount; i++)
+	{
+		DdsImage::Level level;
+		level.mWidth = w;
+		level.mHeight = h;
+		level.mOffset = offset;
+		size_t rows;
+		if (compressed)
+		{
+			level.mRowPitch = (size_t)max(1u, (w + 3) / 4) * formatSize;
+			rows = max(1u, (h + 3) / 4);
+		}
+		else
+		{
+			level.mRowPitch = ((size_t)w * formatSize + 7) / 8;
+			rows = h;
+		}
+		level.mSize = level.mRowPitch * rows;
+		offset += level.mSize;
+		if (offset > size)
+		{
+			error = "the pixels are cut short";
+			return false;
+		}
+
+		out.mLevels.push_back(level);
+		w = max(1u, w / 2);
+		h = max(1u, h / 2);
+	}
+
+	out.mWidth = width;
+	out.mHeight = height;
+	out.mFormat = format;
+	return true;
+}
+
+bool Dds::Parse(vector<uint8_t> file, DdsImage& out, string& error)
+{
+	if (!ParseHeaders(file.data(), file.size(), out, error))
+		return false;
+	out.mData = move(file);
+	return true;
+}
+
+// Load function: Mapped rather than read into a buffer of its own, which would have to be
+// faulted in page by page as it's filled and is one more copy than the upload needs.
+bool Dds::Load(const string& path, DdsImage& out, string& error)
+{
+	unique_ptr<MappedFile> file = make_unique<MappedFile>(path, true);
+	if (!file->IsOk())
+	{
+		error = file->Exists() ? "can't read the file" : "can't open the file";
+		return false;
+	}
+	if (!ParseHeaders(reinterpret_cast<const uint8_t*>(file->GetData()), file->GetSize(), out, error))
+		return false;
+	out.mpFile = move(file);
+	return true;
+}
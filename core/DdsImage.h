@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+#include "MappedFile.h"
+
+
+// DdsImage struct: A 2D texture read out of a DDS file, every mip level of it, ready to be
+// handed to the device as it is. Nothing in it needs Direct3D, so files can be read and
+// parsed on any thread (or any platform) and only the upload has to happen on the device.
+struct DdsImage
+{
+    // Level struct: Where one mip level is in the file and how its rows are laid out.
+    struct Level
+    {
+        size_t mOffset = 0;
+        size_t mSize = 0;      // Bytes in the whole level.
+        size_t mRowPitch = 0;  // Bytes from one row to the next, or one row of 4x4 blocks when compressed.
+        uint32_t mWidth = 0;
+        uint32_t mHeight = 0;
+    };
+
+    uint32_t mWidth = 0;
+    uint32_t mHeight = 0;
+    uint32_t mFormat = 0;       // A DXGI_FORMAT, the values are in Dds below.
+    std::vector<Level> mLevels; // Largest first.
+    std::vector<uint8_t> mData; // The whole file when it was parsed from memory,
+    std::unique_ptr<MappedFile> mpFile;  // or mapped when it was loaded.
+
+    // The whole file, the levels point into it past the header.
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+    size_t GetPixelBytes() const;  // Bytes in every level together.
+};
+
+// Dds namespace: Reads the DDS files the game's textures are in.
+// Handles 2D textures with or without mips, in the DX10 header or the older pixel format
+// header: block compressed (BC1 to BC7) and the common uncompressed formats. Cube maps,
+// volumes, arrays and anything more unusual are rejected with an error saying so, for the
+// caller to load some other way.
+namespace Dds
+{
+    // The DXGI_FORMAT values the parser hands back, numbered as in dxgiformat.h.
+    enum Format : uint32_t
+    {
+        FORMAT_UNKNOWN = 0,
+        FORMAT_R32G32B32A32_FLOAT = 2,
+        FORMAT_R16G16B16A16_FLOAT = 10,
+        FORMAT_R16G16B16A16_UNORM = 11,
+        FORMAT_R10G10B10A2_UNORM = 24,
+        FORMAT_R8G8B8A8_UNORM = 28,
+        FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+        FORMAT_R16G16_UNORM = 35,
+        FORMAT_R32_FLOAT = 41,
+        FORMAT_R8G8_UNORM = 49,
+        FORMAT_R16_UNORM = 56,
+        FORMAT_R8_UNORM = 61,
+        FORMAT_A8_UNORM = 65,
+        FORMAT_BC1_UNORM = 71,
+        FORMAT_BC1_UNORM_SRGB = 72,
+        FORMAT_BC2_UNORM = 74,
+        FORMAT_BC2_UNORM_SRGB = 75,
+        FORMAT_BC3_UNORM = 77,
+        FORMAT_BC3_UNORM_SRGB = 78,
+        FORMAT_BC4_UNORM = 80,
+        FORMAT_BC4_SNORM = 81,
+        FORMAT_BC5_UNORM = 83,
+        FORMAT_BC5_SNORM = 84,
+        FORMAT_B5G6R5_UNORM = 85,
+        FORMAT_B5G5R5A1_UNORM = 86,
+        FORMAT_B8G8R8A8_UNORM = 87,
+        FORMAT_B8G8R8X8_UNORM = 88,
+        FORMAT_B8G8R8A8_UNORM_SRGB = 91,
+        FORMAT_B8G8R8X8_UNORM_SRGB = 93,
+        FORMAT_BC6H_UF16 = 95,
+        FORMAT_BC6H_SF16 = 96,
+        FORMAT_BC7_UNORM = 98,
+        FORMAT_BC7_UNORM_SRGB = 99,
+        FORMAT_B4G4R4A4_UNORM = 115
+    };
+
+    // Parse function: Takes the whole file and works out where each mip level is in it,
+    // false with the reason in error if it's damaged or in a layout that isn't handled.
+    bool Parse(std::vector<uint8_t> file, DdsImage& out, std::string& error);
+
+    // Load function: Maps a file and parses it. The pages are read in now, so whoever loads
+    // the image does the disk reads rather than whoever uploads it.
+    bool Load(const std::string& path, DdsImage& out, std::string& error);
+}
@@ -0,0 +1,200 @@
+#include "EnemyFormation.h"
+#include "SimdConfig.h"
+
+#include <cassert>
+#include <limits>
+#include <algorithm>
+
+
+// Resize function: Allocates every array padded up to a multiple of LANE_PAD, all enemies dead.
+void EnemyFormation::Resize(size_t count)
+{
+	size_t padded = (count + LANE_PAD - 1) / LANE_PAD * LANE_PAD;
+	mCount = count;
+	mActiveCount = 0;
+
+	mPosX.assign(padded, 0.0f);
+	mPosY.assign(padded, 0.0f);
+	mPrevX.assign(padded, 0.0f);
+	mPrevY.assign(padded, 0.0f);
+	mHalfW.assign(padded, 0.0f);
+	mHalfH.assign(padded, 0.0f);
+	mLeft.assign(padded, 0.0f);
+	mTop.assign(padded, 0.0f);
+	mRight.assign(padded, 0.0f);
+	mBottom.assign(padded, 0.0f);
+	mActive.assign(padded, 0u);
+	mType.assign(padded, 0);
+}
+
+// Set function: Places an enemy and brings it to life.
+void EnemyFormation::Set(size_t i, uint8_t _type, const SimVec2& _pos, const SimVec2& _halfExtents)
+{
+	assert(i < mCount);
+
+	if (!mActive[i])
+		mActiveCount++;
+
+	mType[i] = _type;
+	mPosX[i] = _pos.x;
+	mPosY[i] = _pos.y;
+	mPrevX[i] = _pos.x;  // Placed, not moved, so there's nothing to interpolate from
+	mPrevY[i] = _pos.y;
+	mHalfW[i] = _halfExtents.x;
+	mHalfH[i] = _halfExtents.y;
+	mLeft[i] = _pos.x - _halfExtents.x;
+	mTop[i] = _pos.y - _halfExtents.y;
+	mRight[i] = _pos.x + _halfExtents.x;
+	mBottom[i] = _pos.y + _halfExtents.y;
+	mActive[i] = 0xFFFFFFFFu;
+}
+
+// SavePositions function: Straight copies, the formation is small.
+void EnemyFormation::SavePositions()
+{
+	std::copy(mPosX.begin(), mPosX.end(), mPrevX.begin());
+	std::copy(mPosY.begin(), mPosY.end(), mPrevY.begin());
+}
+
+// Kill function: Removes an enemy from play.
+void EnemyFormation::Kill(size_t i)
+{
+	assert(i < mCount);
+
+	if (mActive[i])
+	{
+		mActive[i] = 0u;
+		mActiveCount--;
+	}
+}
+
+// GetBox function: Gathers a single enemy's collider from the edge arrays.
+SimBox EnemyFormation::GetBox(size_t i) const
+{
+	SimBox box;
+	box.UpdateBox(mLeft[i], mTop[i], mRight[i], mBottom[i]);
+	return box;
+}
+
+// Move function: Moves the alive enemies and rebuilds their colliders using the widest SIMD available.
+EnemyFormation::Bounds EnemyFormation::Move(float dx, float dy)
+{
+#if defined(IA_SIMD_AVX)
+	const size_t n = mPosX.size();
+	const __m256 vdx = _mm256_set1_ps(dx);
+	const __m256 vdy = _mm256_set1_ps(dy);
+	const __m256 vInf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+	const __m256 vNegInf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+	__m256 vMinX = vInf, vMaxX = vNegInf, vMaxY = vNegInf;
+
+	for (size_t i = 0; i < n; i += 8)
+	{
+		// Dead lanes have a zero mask so they don't move and don't count towards the bounds
+		__m256 mask = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)&mActive[i]));
+		__m256 x = _mm256_add_ps(_mm256_loadu_ps(&mPosX[i]), _mm256_and_ps(mask, vdx));
+		__m256 y = _mm256_add_ps(_mm256_loadu_ps(&mPosY[i]), _mm256_and_ps(mask, vdy));
+		__m256 hw = _mm256_loadu_ps(&mHalfW[i]);
+		__m256 hh = _mm256_loadu_ps(&mHalfH[i]);
+
+		_mm256_storeu_ps(&mPosX[i], x);
+		_mm256_storeu_ps(&mPosY[i], y);
+		_mm256_storeu_ps(&mLeft[i], _mm256_sub_ps(x, hw));
+		_mm256_storeu_ps(&mTop[i], _mm256_sub_ps(y, hh));
+		_mm256_storeu_ps(&mRight[i], _mm256_add_ps(x, hw));
+		_mm256_storeu_ps(&mBottom[i], _mm256_add_ps(y, hh));
+
+		vMinX = _mm256_min_ps(vMinX, _mm256_blendv_ps(vInf, x, mask));
+		vMaxX = _mm256_max_ps(vMaxX, _mm256_blendv_ps(vNegInf, x, mask));
+		vMaxY = _mm256_max_ps(vMaxY, _mm256_blendv_ps(vNegInf, y, mask));
+	}
+
+	// Reduce the lanes down to a single value
+	float minX[8], maxX[8], maxY[8];
+	_mm256_storeu_ps(minX, vMinX);
+	_mm256_storeu_ps(maxX, vMaxX);
+	_mm256_storeu_ps(maxY, vMaxY);
+
+	Bounds bounds;
+	bounds.mMinX = *std::min_element(minX, minX + 8);
+	bounds.mMaxX = *std::max_element(maxX, maxX + 8);
+	bounds.mMaxY = *std::max_element(maxY, maxY + 8);
+	bounds.mAny = mActiveCount > 0;
+	return bounds;
+
+#elif defined(IA_SIMD_SSE)
+	const size_t n = mPosX.size();
+	const __m128 vdx = _mm_set1_ps(dx);
+	const __m128 vdy = _mm_set1_ps(dy);
+	const __m128 vInf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	const __m128 vNegInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+	__m128 vMinX = vInf, vMaxX = vNegInf, vMaxY = vNegInf;
+
+	for (size_t i = 0; i < n; i += 4)
+	{
+		// Dead lanes have a zero mask so they don't move and don't count towards the bounds
+		__m128 mask = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&mActive[i]));
+		__m128 x = _mm_add_ps(_mm_loadu_ps(&mPosX[i]), _mm_and_ps(mask, vdx));
+		__m128 y = _mm_add_ps(_mm_loadu_ps(&mPosY[i]), _mm_and_ps(mask, vdy));
+		__m128 hw = _mm_loadu_ps(&mHalfW[i]);
+		__m128 hh = _mm_loadu_ps(&mHalfH[i]);
+
+		_mm_storeu_ps(&mPosX[i], x);
+		_mm_storeu_ps(&mPosY[i], y);
+		_mm_storeu_ps(&mLeft[i], _mm_sub_ps(x, hw));
+		_mm_storeu_ps(&mTop[i], _mm_sub_ps(y, hh));
+		_mm_storeu_ps(&mRight[i], _mm_add_ps(x, hw));
+		_mm_storeu_ps(&mBottom[i], _mm_add_ps(y, hh));
+
+		// SSE2 has no blend, so select with and/andnot/or
+		vMinX = _mm_min_ps(vMinX, _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, vInf)));
+		vMaxX = _mm_max_ps(vMaxX, _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, vNegInf)));
+		vMaxY = _mm_max_ps(vMaxY, _mm_or_ps(_mm_and_ps(mask, y), _mm_andnot_ps(mask, vNegInf)));
+	}
+
+	// Reduce the lanes down to a single value
+	float minX[4], maxX[4], maxY[4];
+	_mm_storeu_ps(minX, vMinX);
+	_mm_storeu_ps(maxX, vMaxX);
+	_mm_storeu_ps(maxY, vMaxY);
+
+	Bounds bounds;
+	bounds.mMinX = *std::min_element(minX, minX + 4);
+	bounds.mMaxX = *std::max_element(maxX, maxX + 4);
+	bounds.mMaxY = *std::max_element(maxY, maxY + 4);
+	bounds.mAny = mActiveCount > 0;
+	return bounds;
+
+#else
+	return MoveScalar(dx, dy);
+#endif
+}
+
+// MoveScalar function: One enemy at a time, same results as Move.
+EnemyFormation::Bounds EnemyFormation::MoveScalar(float dx, float dy)
+{
+	Bounds bounds;
+	bounds.mMinX = std::numeric_limits<float>::infinity();
+	bounds.mMaxX = -std::numeric_limits<float>::infinity();
+	bounds.mMaxY = -std::numeric_limits<float>::infinity();
+
+	const size_t n = mPosX.size();
+	for (size_t i = 0; i < n; i++)
+	{
+		if (!mActive[i])
+			continue;
+
+		float x = mPosX[i] += dx;
+		float y = mPosY[i] += dy;
+		mLeft[i] = x - mHalfW[i];
+		mTop[i] = y - mHalfH[i];
+		mRight[i] = x + mHalfW[i];
+		mBottom[i] = y + mHalfH[i];
+
+		bounds.mMinX = std::min(bounds.mMinX, x);
+		bounds.mMaxX = std::max(bounds.mMaxX, x);
+		bounds.mMaxY = std::max(bounds.mMaxY, y);
+	}
+
+	bounds.mAny = mActiveCount > 0;
+	return bounds;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "SimTypes.h"
+
+
+// EnemyFormation class: Structure-of-arrays storage for the enemy formation.
+// Positions, half extents, colliders, alive flags and types each live in their own
+// contiguous array so the whole formation can be moved, and have its colliders
+// rebuilt, in a single vectorised pass instead of chasing a pointer per enemy.
+// Arrays are padded with dead enemies up to a multiple of LANE_PAD so the SIMD
+// loops never need a scalar tail.
+class EnemyFormation
+{
+public:
+    static const size_t LANE_PAD = 8;  // Widest vector (AVX) holds 8 floats.
+
+    // Bounds struct: Extents of the alive enemies, produced as a side effect of Move.
+    struct Bounds
+    {
+        float mMinX = 0, mMaxX = 0;  // Left and right most enemy centres.
+        float mMaxY = 0;             // Lowest enemy centre.
+        bool mAny = false;           // Whether any enemy is alive.
+    };
+
+    // Resize function: Makes room for count enemies, all of them start dead.
+    void Resize(size_t count);
+
+    // Set function: Places enemy i, brings it to life and sets its collider half extents.
+    void Set(size_t i, uint8_t _type, const SimVec2& _pos, const SimVec2& _halfExtents);
+
+    // SavePositions function: Remembers every enemy's position as it is before the next tick moves it.
+    void SavePositions();
+
+    // Kill function: Removes enemy i from play.
+    void Kill(size_t i);
+
+    // Move function: Moves every alive enemy by (dx, dy), rebuilds their colliders and returns their extents.
+    Bounds Move(float dx, float dy);
+
+    // MoveScalar function: Plain loop version of Move, used when no SIMD is available and for benchmarking.
+    Bounds MoveScalar(float dx, float dy);
+
+    // Accessors for a single enemy.
+    size_t Size() const { return mCount; }
+    size_t GetActiveCount() const { return mActiveCount; }
+    bool IsActive(size_t i) const { return mActive[i] != 0; }
+    uint8_t GetType(size_t i) const { return mType[i]; }
+    SimVec2 GetPos(size_t i) const { return SimVec2(mPosX[i], mPosY[i]); }
+    SimVec2 GetPrevPos(size_t i) const { return SimVec2(mPrevX[i], mPrevY[i]); }  // Position at the last SavePositions.
+    SimBox GetBox(size_t i) const;
+
+    // Raw arrays for batched queries, each holds GetPaddedSize() entries.
+    size_t GetPaddedSize() const { return mPosX.size(); }
+    const float* GetLefts() const { return mLeft.data(); }
+    const float* GetTops() const { return mTop.data(); }
+    const float* GetRights() const { return mRight.data(); }
+    const float* GetBottoms() const { return mBottom.data(); }
+    const uint32_t* GetActiveMasks() const { return mActive.data(); }
+
+private:
+    std::vector<float> mPosX, mPosY;          // Centre of each enemy.
+    std::vector<float> mPrevX, mPrevY;        // Centre of each enemy before the current tick, for interpolation.
+    std::vector<float> mHalfW, mHalfH;        // Half extents of each enemy's collider.
+    std::vector<float> mLeft, mTop, mRight, mBottom;  // Collider edges, rebuilt by Move.
+    std::vector<uint32_t> mActive;            // All bits set when alive so it can be used as a SIMD lane mask.
+    std::vector<uint8_t> mType;               // Simulation::EnemyType of each enemy.
+
+    size_t mCount = 0;        // Number of real (unpadded) enemies.
+    size_t mActiveCount = 0;  // Number of alive enemies.
+};
@@ -0,0 +1,177 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace fs = std::filesystem;
+
+
+// AddOnce function: Adds a path unless it's already been reported.
+static void AddOnce(std::vector<std::string>& paths, const std::string& path)
+{
+	if (std::find(paths.begin(), paths.end(), path) == paths.end())
+		paths.push_back(path);
+}
+
+// Open function: Takes a first look at the directory then asks the OS to watch it, falling back to polling.
+bool FileWatcher::Open(const std::string& directory, const std::string& extension, int pollIntervalMs)
+{
+	Close();
+
+	std::error_code ec;
+	if (!fs::is_directory(directory, ec))
+		return false;
+
+	mDirectory = directory;
+	mExtension = extension;
+	mPollInterval = std::max(pollIntervalMs, 1);
+
+#if defined(__linux__)
+	mFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (mFd >= 0 && inotify_add_watch(mFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		close(mFd);
+		mFd = -1;
+	}
+#endif
+
+	if (mFd < 0)
+		Scan(nullptr);
+
+	return true;
+}
+
+// Close function: Stops watching, closing the inotify instance if there is one.
+void FileWatcher::Close()
+{
+#if defined(__linux__)
+	if (mFd >= 0)
+		close(mFd);
+#endif
+	mFd = -1;
+	mDirectory.clear();
+	mStamps.clear();
+}
+
+// Wait function: Waits however this platform can.
+bool FileWatcher::Wait(std::vector<std::string>& outChanged, int timeoutMs)
+{
+	if (!IsOpen())
+		return false;
+
+	return IsNative() ? WaitNative(outChanged, timeoutMs) : WaitPolling(outChanged, timeoutMs);
+}
+
+// WaitNative function: Sleeps in poll() until inotify has events, then drains them all.
+bool FileWatcher::WaitNative(std::vector<std::string>& outChanged, int timeoutMs)
+{
+	bool changed = false;
+#if defined(__linux__)
+	pollfd pfd = { mFd, POLLIN, 0 };
+	if (poll(&pfd, 1, timeoutMs) <= 0)
+		return false;
+
+	alignas(inotify_event) char buffer[4096];
+	for (;;)
+	{
+		ssize_t len = read(mFd, buffer, sizeof(buffer));
+		if (len <= 0)
+			break;  // Drained (EAGAIN) or closed
+
+		for (char* p = buffer; p < buffer + len; )
+		{
+			const inotify_event* e = (const inotify_event*)p;
+			p += sizeof(inotify_event) + e->len;
+
+			if (e->len == 0)
+				continue;
+
+			fs::path path = fs::path(mDirectory) / e->name;
+			if (IsWatched(path))
+			{
+				AddOnce(outChanged, path.string());
+				changed = true;
+			}
+		}
+	}
+#endif
+	return changed;
+}
+
+// WaitPolling function: Scans every poll interval until something has changed or the time is up.
+bool FileWatcher::WaitPolling(std::vector<std::string>& outChanged, int timeoutMs)
+{
+	auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+	for (;;)
+	{
+		if (Scan(&outChanged))
+			return true;
+
+		auto now = std::chrono::steady_clock::now();
+		if (now >= end)
+			return false;
+
+		std::this_thread::sleep_for(std::min(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::milliseconds(mPollInterval)), end - now));
+	}
+}
+
+// Scan function: New files and ones whose time or size moved count as changed, deleted ones are forgotten.
+// Ones that can't be read for a moment are left as they were.
+bool FileWatcher::Scan(std::vector<std::string>* outChanged)
+{
+	std::error_code ec;
+	std::map<std::string, Stamp> stamps;
+	bool changed = false;
+
+	for (fs::directory_iterator it(mDirectory, ec), end; !ec && it != end; it.increment(ec))
+	{
+		if (!IsWatched(it->path()))
+			continue;
+
+		// A file that can't be looked at right now keeps the stamp it had, so the next scan that
+		// can doesn't take it for new. One that has really gone isn't listed next time.
+		std::string path = it->path().string();
+		auto old = mStamps.find(path);
+		std::error_code typeEc, timeEc, sizeEc;
+		if (!it->is_regular_file(typeEc) && !typeEc)
+			continue;
+		Stamp stamp;
+		stamp.mTime = it->last_write_time(timeEc);
+		stamp.mSize = it->file_size(sizeEc);
+		if (typeEc || timeEc || sizeEc)
+		{
+			if (old != mStamps.end())
+				stamps[path] = old->second;
+			continue;
+		}
+
+		if (old == mStamps.end() || old->second.mTime != stamp.mTime || old->second.mSize != stamp.mSize)
+		{
+			if (outChanged)
+				AddOnce(*outChanged, path);
+			changed = true;
+		}
+		stamps[path] = stamp;
+	}
+
+	// The listing stopped part way, the files it didn't get to are left as they were too
+	if (ec)
+		stamps.insert(mStamps.begin(), mStamps.end());
+
+	mStamps.swap(stamps);
+	return changed;
+}
+
+// IsWatched function: Whether a path has the extension we're watching for.
+bool FileWatcher::IsWatched(const fs::path& path) const
+{
+	return mExtension.empty() || path.extension().string() == mExtension;
+}
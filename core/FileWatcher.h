@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+
+// FileWatcher class: Reports files in a directory that have been written to.
+// On Linux the kernel tells us through inotify, and only once the writer has closed
+// the file so we never see one half saved. Everywhere else the directory is scanned
+// every poll interval and a file counts as changed when its time or size does.
+// Nothing runs in the background, a thread that wants to know calls Wait.
+class FileWatcher
+{
+public:
+    ~FileWatcher() { Close(); }
+
+    // Open function: Starts watching the files in directory ending in extension (".lua"),
+    // returns false if the directory doesn't exist.
+    bool Open(const std::string& directory, const std::string& extension, int pollIntervalMs = 250);
+
+    void Close();
+
+    // Wait function: Blocks for up to timeoutMs for watched files to change and adds the
+    // paths of any that did to outChanged, each once. Returns false if nothing changed.
+    bool Wait(std::vector<std::string>& outChanged, int timeoutMs);
+
+    bool IsOpen() const { return !mDirectory.empty(); }
+
+    // IsNative function: Whether the OS is telling us about changes rather than us polling for them.
+    bool IsNative() const { return mFd >= 0; }
+
+private:
+    // Stamp struct: What a file looked like at the last scan.
+    struct Stamp
+    {
+        std::filesystem::file_time_type mTime;
+        uintmax_t mSize = 0;
+    };
+
+    bool WaitNative(std::vector<std::string>& outChanged, int timeoutMs);
+    bool WaitPolling(std::vector<std::string>& outChanged, int timeoutMs);
+    bool Scan(std::vector<std::string>* outChanged);  // Refreshes the stamps, adding the files that changed if given somewhere to.
+    bool IsWatched(const std::filesystem::path& path) const;
+
+    std::string mDirectory;
+    std::string mExtension;
+    int mPollInterval = 250;
+    std::map<std::string, Stamp> mStamps;  // Every watched file when polling, by path.
+    int mFd = -1;  // inotify instance, -1 when polling.
+};
@@ -0,0 +1,47 @@
+#include "FixedTimestep.h"
+
+#include <cassert>
+
+
+FixedTimestep::FixedTimestep(float tickRate, int maxSteps)
+{
+	SetTickRate(tickRate);
+	SetMaxSteps(maxSteps);
+}
+
+// SetTickRate function: Safe between ticks, the time carried over is kept to a step so the alpha stays in range.
+void FixedTimestep::SetTickRate(float tickRate)
+{
+	assert(tickRate > 0.0f);
+	mStep = 1.0f / tickRate;
+	if (mAccumulator > mStep)
+		mAccumulator = mStep;
+}
+
+void FixedTimestep::SetMaxSteps(int maxSteps)
+{
+	assert(maxSteps > 0);
+	mMaxSteps = maxSteps;
+}
+
+// Advance function: Takes whole steps out of the accumulator, dropping any beyond the catch up limit.
+int FixedTimestep::Advance(float frameTime)
+{
+	if (frameTime > 0.0f)
+		mAccumulator += frameTime;
+
+	int steps = (int)(mAccumulator / mStep);
+	if (steps > mMaxSteps)
+	{
+		// Keep the fraction of a step so the interpolation doesn't jump
+		double excess = (double)(steps - mMaxSteps) * mStep;
+		mDropped += excess;
+		mAccumulator -= excess;
+		steps = mMaxSteps;
+	}
+
+	mAccumulator -= (double)steps * mStep;
+	if (mAccumulator < 0)
+		mAccumulator = 0;  // Rounding can leave a tiny negative
+	return steps;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+
+// FixedTimestep class: Turns variable frame times into a whole number of fixed length ticks.
+// Frame time is added to an accumulator and a tick is taken for every full step in it,
+// so the simulation costs the same and behaves the same at any frame rate. Whatever
+// is left over becomes the interpolation alpha the renderer blends the last two ticks with.
+// After a long stall only maxSteps ticks are run and the rest of the time is dropped,
+// so a slow frame can't cause an even slower one.
+class FixedTimestep
+{
+public:
+    // Constructor: tickRate is in ticks per second.
+    FixedTimestep(float tickRate = 60.0f, int maxSteps = 5);
+
+    void SetTickRate(float tickRate);
+    void SetMaxSteps(int maxSteps);
+
+    // Advance function: Adds a frame's time and returns how many ticks to run for it.
+    int Advance(float frameTime);
+
+    // GetStep function: Length of a tick in seconds, what every tick should be given as its delta time.
+    float GetStep() const { return mStep; }
+
+    // GetAlpha function: How far between the last tick and the next one the current frame is (0 to 1).
+    float GetAlpha() const { return (float)(mAccumulator / mStep); }
+
+    // GetDroppedTime function: Seconds thrown away so far because more than maxSteps were due.
+    double GetDroppedTime() const { return mDropped; }
+
+private:
+    float mStep;               // Seconds per tick.
+    int mMaxSteps;             // Most ticks run for a single frame.
+    double mAccumulator = 0;   // Time not yet simulated, always less than a step after Advance.
+    double mDropped = 0;
+};
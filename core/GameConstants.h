@@ -0,0 +1,64 @@
+#pragma once
+
+// GC (Game Constants) Namespace: Gameplay constants shared by the simulation core and the game.
+// Nothing in here may depend on DirectX or Windows so the core library can build anywhere,
+// anything rendering specific lives in constants.h which extends this namespace.
+namespace GC {
+	// Player Constants
+	const float SHIP_SPEED = 350.0f;          // Speed of the player's ship.
+	const float MISSILE_SPEED = 450.0f;       // Speed of the missiles fired by the player.
+	const float FIRE_DELAY = 0.3f;            // Delay between fires.
+	const float PLAYER_RECOVER_TIME = 2.5f;   // Time the player spends recovering after being hit.
+	const static int PLAYER_LIFES = 3;        // Player's starting lifes if the scripts don't say otherwise.
+	const static int MISSILE_FRAME_COUNT = 4; // Number of frames in the missile's spin animation.
+
+	// Shelter Constants
+	const static int NUM_SHELTERS = 4;			   // Number of shelters in the game.
+	const float SHELTER_OFFSET_Y = 110.0f;         // Vertical offset of the shelters.
+	const static int SHELTER_TEXTURE_STATES = 10;  // Number of states in the shelter sprite sheet, used to size the shelters.
+	const static int SHELTER_MASK_WIDTH = 64;      // Pixels across a shelter's damage mask.
+	const static int SHELTER_MASK_HEIGHT = 48;     // Pixels down a shelter's damage mask.
+	const static int SHELTER_CRATER_RADIUS = 4;    // Radius in mask pixels of the crater a hit leaves.
+	const static int SHELTER_DESTROYED_PERCENT = 5;  // The shelter crumbles once less than this much of it is left.
+
+	// Enemy Constants
+	const static int NUM_ENEMIES = 55;  // Int that holds the maximum amount of enemies
+
+	const float ENEMY_START_SPEED = 10.0f; // Speed of the enemies at the start of every wave.
+	const float ENEMY_SPEED_INC = 3.5f;    // Speed increase of enemies over time.
+	const float ENEMY_UFO_SPEED = 200.0f;  // Speed of the UFO enemy.
+	const float LASER_SPEED = 200.0f;      // Speed of the enemy lasers.
+
+	const static int ENEMY_TIME_BTWN_SHOTS = 1;  // Amount of time between the chance to shoot
+	const static int ENEMY_SHOOT_CHANCE = 3;     // (0-100) Example: 34 equals a 34% chance for the enemy to shoot
+
+	const static int ENEMY_UFO_CHANCE = 5;  // Chance of a ufo spawning (from 0-100) everytime the enemies move down
+
+	// Bullet hell variant, lasers fan out below the enemies in a spiral
+	const float BULLET_HELL_SPREAD = 1.2f;     // Radians either side of straight down the lasers are fired at.
+	const float BULLET_HELL_FILL_TIME = 1.0f;  // Seconds it takes to fill the screen up to the target amount of lasers.
+
+	// Constant variables used for enemy behavior and positioning
+	const static int ENEMY_DOWNSTEP = 15;      // Vertical step for enemies after reaching a boundary
+	const static int ENEMY_LIMIT_OFFSET = 25;  // Offset from screen edges for enemy movement
+	const float ENEMY_GAME_OVER_Y = 600.0f;    // Once the lowest enemy reaches this Y the game is over
+
+	// Enemy positioning and scoring values
+	const static int ENEMIES_PER_ROW = 11;   // Number of enemies per row
+	const static int NUM_ROWS = 5;           // Total number of rows of enemies
+	const static int ROWX_SPACING = 10;      // Horizontal spacing between rows
+	const static int ROWY_SPACING = 50;      // Vertical spacing between rows
+	const static int ENEMY_INITIAL_Y = 120;  // Initial Y position for the top row
+	const static int UFO_INITIAL_Y = 50;     // Initial Y position for the ufo
+
+	// Points Constants
+	const static int OCTOPUS_POINTS = 10;          // Points for defeating an octopus enemy.
+	const static int CRAB_POINTS = 20;             // Points for defeating a crab enemy.
+	const static int SQUID_POINTS = 40;            // Points for defeating a squid enemy.
+	const int UFO_POINTS[4] = { 50,100,150,300 };  // Randomly selected points for defeating a UFO enemy.
+	const static int WAVE_FINISH_POINTS = 1000;    // Bonus points for completing a wave.
+
+	// Score Constants
+	const char* const ENCRYPT_KEY = "=ami%#Ip,Mo@l+sMI]/t$j$`KDwzbQ";   // Key for encrypting and decrypting scores.
+	const char* const LEADERBOARD_ADDRESS = "tcp:127.0.0.1:7301";      // Where the leaderboard daemon listens by default.
+};
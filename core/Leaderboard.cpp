@@ -0,0 +1,135 @@
+#include "Leaderboard.h"
+
+#include <cassert>
+
+#include "Random.h"
+
+using namespace std;
+
+// Priorities come from a fixed hash so the same scores always build the same tree.
+static const uint64_t PRIORITY_KEY = 0x4C65616465726264ull;
+
+
+// Clear function: Drops every entry, keeping the memory.
+void Leaderboard::Clear()
+{
+	mNodes.clear();
+	mRoot = -1;
+	mBest.clear();
+}
+
+// Insert function: Descends like a plain search tree then rotates the node up while it outranks its parent's priority.
+void Leaderboard::Insert(int points, uint32_t id, const string& name)
+{
+	Node node;
+	node.mEntry.mPoints = points;
+	node.mEntry.mId = id;
+	node.mEntry.mName = name;
+	node.mPriority = RandomStream::Hash(PRIORITY_KEY, mNodes.size());
+	mNodes.push_back(node);
+
+	int newNode = (int)mNodes.size() - 1;
+	mRoot = InsertAt(mRoot, newNode);
+
+	auto it = mBest.find(name);
+	if (it == mBest.end())
+		mBest.emplace(name, newNode);
+	else
+	{
+		const Entry& best = mNodes[it->second].mEntry;
+		if (Ahead(points, id, best.mPoints, best.mId))
+			it->second = newNode;
+	}
+}
+
+// InsertAt function: Recursion only goes as deep as the tree, which is O(log n) with random priorities.
+int Leaderboard::InsertAt(int node, int newNode)
+{
+	if (node < 0)
+		return newNode;
+
+	const Entry& e = mNodes[newNode].mEntry;
+	Node& n = mNodes[node];
+	int top = node;
+	if (Ahead(e.mPoints, e.mId, n.mEntry.mPoints, n.mEntry.mId))
+	{
+		n.mLeft = InsertAt(n.mLeft, newNode);
+		if (mNodes[n.mLeft].mPriority > n.mPriority)
+		{
+			// Rotate right
+			top = n.mLeft;
+			n.mLeft = mNodes[top].mRight;
+			mNodes[top].mRight = node;
+		}
+	}
+	else
+	{
+		n.mRight = InsertAt(n.mRight, newNode);
+		if (mNodes[n.mRight].mPriority > n.mPriority)
+		{
+			// Rotate left
+			top = n.mRight;
+			n.mRight = mNodes[top].mLeft;
+			mNodes[top].mLeft = node;
+		}
+	}
+
+	Update(node);
+	if (top != node)
+		Update(top);
+	return top;
+}
+
+// At function: Walks down choosing the side the rank falls in.
+const Leaderboard::Entry& Leaderboard::At(size_t rank) const
+{
+	assert(rank < mNodes.size());
+	int node = mRoot;
+	while (true)
+	{
+		const Node& n = mNodes[node];
+		size_t left = Count(n.mLeft);
+		if (rank == left)
+			return n.mEntry;
+		if (rank < left)
+			node = n.mLeft;
+		else
+		{
+			rank -= left + 1;
+			node = n.mRight;
+		}
+	}
+}
+
+// GetRank function: Counts every node passed on the left on the way down.
+size_t Leaderboard::GetRank(int points, uint32_t id) const
+{
+	size_t rank = 0;
+	int node = mRoot;
+	while (node >= 0)
+	{
+		const Node& n = mNodes[node];
+		if (Ahead(n.mEntry.mPoints, n.mEntry.mId, points, id))
+		{
+			rank += Count(n.mLeft) + 1;
+			node = n.mRight;
+		}
+		else
+			node = n.mLeft;
+	}
+	return rank;
+}
+
+// GetTop function: Collects pointers rather than copying the entries.
+void Leaderboard::GetTop(size_t first, size_t count, vector<const Entry*>& out) const
+{
+	out.clear();
+	ForEach(first, count, [&out](size_t, const Entry& e) { out.push_back(&e); });
+}
+
+// GetBest function: Kept up to date by Insert, so it's a single lookup.
+const Leaderboard::Entry* Leaderboard::GetBest(const string& name) const
+{
+	auto it = mBest.find(name);
+	return it == mBest.end() ? nullptr : &mNodes[it->second].mEntry;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+
+// Leaderboard class: Every score ever saved, ranked, as an order statistic tree.
+// It's a treap: a binary search tree on (points, id) that's kept balanced by also being
+// a heap on a priority hashed from each node's index, and every node counts the nodes
+// below it. That makes inserting, finding the score at a rank and the rank of a score
+// all O(log n), and listing k scores from any rank O(log n + k), however big the history.
+// Nodes live in one vector and link by index, scores are only ever added.
+class Leaderboard
+{
+public:
+    // Entry struct: A ranked score.
+    struct Entry
+    {
+        int mPoints = 0;
+        uint32_t mId = 0;   // Order scores were saved in, the earlier of two equal scores ranks higher.
+        std::string mName;
+    };
+
+    void Reserve(size_t count) { mNodes.reserve(count); }
+    void Clear();
+
+    // Insert function: Adds a score, ids must be unique.
+    void Insert(int points, uint32_t id, const std::string& name);
+
+    size_t Size() const { return mNodes.size(); }
+    bool Empty() const { return mNodes.empty(); }
+
+    // At function: The entry at a rank, 0 is the highest score.
+    const Entry& At(size_t rank) const;
+
+    // GetRank function: How many entries rank above a score of points saved as id,
+    // by default counting every equal score too (where a new score would place).
+    size_t GetRank(int points, uint32_t id = UINT32_MAX) const;
+
+    // GetTop function: Replaces out with the entries ranked first to first + count - 1 (fewer if there aren't that many).
+    void GetTop(size_t first, size_t count, std::vector<const Entry*>& out) const;
+
+    // ForEach function: Calls fn(rank, entry) for the entries ranked first to first + count - 1, in rank order.
+    template<class Fn>
+    void ForEach(size_t first, size_t count, Fn&& fn) const
+    {
+        if (count > 0)
+            Visit(mRoot, 0, first, first + count, fn);
+    }
+
+    // GetBest function: The highest score saved under a name, nullptr if the name has none.
+    const Entry* GetBest(const std::string& name) const;
+
+private:
+    // Node struct: An entry and its place in the tree.
+    struct Node
+    {
+        Entry mEntry;
+        int mLeft = -1;
+        int mRight = -1;
+        uint32_t mPriority = 0;
+        uint32_t mCount = 1;  // Nodes in this subtree, itself included.
+    };
+
+    // Ahead function: Whether a ranks above b.
+    static bool Ahead(int pointsA, uint32_t idA, int pointsB, uint32_t idB)
+    {
+        return pointsA != pointsB ? pointsA > pointsB : idA < idB;
+    }
+
+    uint32_t Count(int node) const { return node < 0 ? 0 : mNodes[node].mCount; }
+    void Update(int node) { mNodes[node].mCount = 1 + Count(mNodes[node].mLeft) + Count(mNodes[node].mRight); }
+    int InsertAt(int node, int newNode);  // Inserts newNode below node, returns the subtree's new root.
+
+    template<class Fn>
+    void Visit(int node, size_t offset, size_t first, size_t last, Fn& fn) const
+    {
+        // offset is the rank of the first node in this subtree, only subtrees overlapping [first, last) are walked
+        while (node >= 0 && offset < last)
+        {
+            const Node& n = mNodes[node];
+            size_t rank = offset + Count(n.mLeft);
+            if (first < rank)
+                Visit(n.mLeft, offset, first, last, fn);
+            if (rank >= first && rank < last)
+                fn(rank, n.mEntry);
+            offset = rank + 1;
+            node = n.mRight;
+        }
+    }
+
+    std::vector<Node> mNodes;
+    int mRoot = -1;
+    std::unordered_map<std::string, int> mBest;  // Node of each name's highest score.
+};
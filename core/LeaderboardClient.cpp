@@ -0,0 +1,279 @@
+#include "LeaderboardClient.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+using namespace LeaderboardProtocol;
+
+static const size_t RECV_CHUNK = 16 * 1024;
+
+
+// Open function: Not reaching the daemon isn't an error, the scores wait for it. Opening again
+// only drops the connection, scores not yet acknowledged go to the new daemon or under the new name.
+bool LeaderboardClient::Open(const string& address, const string& cabinet, uint32_t storeNonce)
+{
+	Disconnect();
+	mAddress = address;
+	mCabinet = cabinet.empty() ? Net::HostName() : cabinet;
+	mStoreNonce = storeNonce;
+	mNextAttempt = Clock::now();
+	return TryConnect();
+}
+
+// Close function: Scores that were never acknowledged are dropped with the connection.
+void LeaderboardClient::Close()
+{
+	Disconnect();
+	mAddress.clear();
+	mUnacked.clear();
+	mTopWanted = 0;
+}
+
+void LeaderboardClient::Submit(uint32_t id, int points, const string& name)
+{
+	mUnacked.push_back({ id, points, name });
+}
+
+void LeaderboardClient::RequestTop(uint32_t count)
+{
+	mTopWanted = max(count, 1u);
+}
+
+// Pump function: Requests are framed as late as possible so everything queued goes out together.
+void LeaderboardClient::Pump()
+{
+	if (!IsOpen())
+		return;
+	if (mSocket == Net::INVALID && !TryConnect())
+		return;
+	if (mConnecting && !FinishConnect())
+		return;
+
+	while (mSent < mUnacked.size())
+	{
+		uint32_t count = (uint32_t)min(mUnacked.size() - mSent, MAX_BATCH);
+		FrameWriter submit(mOut, MSG_SUBMIT);
+		submit.U32(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const Score& score = mUnacked[mSent + i];
+			submit.U32(score.mId);
+			submit.I32(score.mPoints);
+			submit.Name(score.mName);
+		}
+		submit.End();
+		mExpected.push_back({ MSG_SUBMIT, count, Clock::now() });
+		mSent += count;
+	}
+
+	if (mTopWanted > 0 && !mTopInFlight)
+	{
+		FrameWriter top(mOut, MSG_TOP);
+		top.U32(mTopWanted);
+		top.U32(mTopCurrent ? mTopVersion : 0);  // 0 asks for the list whatever version the daemon is on
+		top.End();
+		mExpected.push_back({ MSG_TOP, mTopWanted, Clock::now() });
+		mTopInFlight = true;
+		mTopWanted = 0;
+	}
+
+	if (!Send() || !Receive())
+		Disconnect();
+}
+
+// Wait function: Waits for room to send too when there's something still to go, or for a connect to finish.
+// Offline, it sleeps until the timeout or the next time to try connecting, whichever is first.
+void LeaderboardClient::Wait(int timeoutMs)
+{
+	if (mSocket != Net::INVALID)
+	{
+		Net::PollEntry entry;
+		entry.mSocket = mSocket;
+		entry.mWantWrite = !mOut.empty() || mConnecting;
+		Net::Poll(&entry, 1, timeoutMs);
+	}
+	else if (IsOpen())
+		this_thread::sleep_until(min(Clock::now() + chrono::milliseconds(timeoutMs), mNextAttempt));
+	Pump();
+}
+
+// Flush function: Gives up straight away if the daemon can't be reached.
+bool LeaderboardClient::Flush(int timeoutMs)
+{
+	Clock::time_point end = Clock::now() + chrono::milliseconds(timeoutMs);
+	Pump();
+	while (!mUnacked.empty() && mSocket != Net::INVALID)
+	{
+		int left = (int)chrono::duration_cast<chrono::milliseconds>(end - Clock::now()).count();
+		if (left <= 0)
+			break;
+		Wait(left);
+	}
+	return mUnacked.empty();
+}
+
+// TryConnect function: Only tries once every RETRY_SECONDS, and never waits on the connect.
+// One that's still going is seen through by FinishConnect, one that's done is sent a HELLO first.
+bool LeaderboardClient::TryConnect()
+{
+	Clock::time_point now = Clock::now();
+	if (now < mNextAttempt)
+		return false;
+	mNextAttempt = now + chrono::seconds(RETRY_SECONDS);  // Also how long a connect has to finish
+
+	mSocket = Net::Connect(mAddress, mConnecting);
+	if (mSocket == Net::INVALID)
+		return false;
+	if (!mConnecting)
+		SendHello();
+	return true;
+}
+
+// FinishConnect function: True once the connect has finished, false while it's still going.
+// A connect that failed, or is still going after RETRY_SECONDS, is dropped to try again later.
+bool LeaderboardClient::FinishConnect()
+{
+	Net::PollEntry entry;
+	entry.mSocket = mSocket;
+	entry.mWantWrite = true;
+	Net::Poll(&entry, 1, 0);
+	if (!entry.mWritable && !entry.mReadable)  // Some systems show a failed connect as readable
+	{
+		if (Clock::now() >= mNextAttempt)
+			Disconnect();
+		return false;
+	}
+
+	if (Net::ConnectError(mSocket) != 0)
+	{
+		Disconnect();
+		return false;
+	}
+	mConnecting = false;
+	SendHello();
+	return true;
+}
+
+// SendHello function: The first frame on every connection.
+void LeaderboardClient::SendHello()
+{
+	FrameWriter hello(mOut, MSG_HELLO);
+	hello.U32(VERSION);
+	hello.U64(CabinetKey(mCabinet));
+	hello.U32(mStoreNonce);
+	hello.End();
+}
+
+// Disconnect function: Everything unacknowledged is sent again, in order, on the next connection.
+void LeaderboardClient::Disconnect()
+{
+	if (mSocket == Net::INVALID)
+		return;
+
+	Net::Close(mSocket);
+	mSocket = Net::INVALID;
+	mConnecting = false;
+	mNextAttempt = Clock::now() + chrono::seconds(RETRY_SECONDS);
+
+	for (const Expected& e : mExpected)
+		if (e.mType == MSG_TOP)
+			mTopWanted = max(mTopWanted, e.mCount);  // Ask again
+	mExpected.clear();
+	mSent = 0;
+	mTopInFlight = false;
+	mTopCurrent = false;  // The daemon may have restarted with a different board
+	mIn.clear();
+	mOut.clear();
+}
+
+// Send function: False if the connection has failed, a full socket just leaves the rest for later.
+bool LeaderboardClient::Send()
+{
+	size_t sent = 0;
+	while (sent < mOut.size())
+	{
+		long n = Net::Send(mSocket, mOut.data() + sent, mOut.size() - sent);
+		if (n < 0)
+			return false;
+		if (n == 0)
+			break;
+		sent += (size_t)n;
+	}
+	mOut.erase(0, sent);
+	return true;
+}
+
+// Receive function: False if the connection closed or the daemon sent something it shouldn't have.
+bool LeaderboardClient::Receive()
+{
+	char buffer[RECV_CHUNK];
+	long got;
+	while ((got = Net::Recv(mSocket, buffer, sizeof(buffer))) > 0)
+		mIn.append(buffer, (size_t)got);
+	if (got < 0)
+		return false;
+
+	size_t pos = 0;
+	Message type;
+	const char* data;
+	size_t size;
+	int result;
+	while ((result = NextFrame(mIn, pos, type, data, size)) > 0)
+		if (!Handle(type, data, size))
+			return false;
+
+	mIn.erase(0, pos);
+	return result == 0;
+}
+
+// Handle function: Each reply has to be the one the oldest outstanding request is owed.
+bool LeaderboardClient::Handle(Message type, const char* data, size_t size)
+{
+	if (mExpected.empty())
+		return false;
+
+	Expected expected = mExpected.front();
+	mExpected.pop_front();
+	FrameReader reader(data, size);
+
+	if (type == MSG_ACK && expected.mType == MSG_SUBMIT)
+	{
+		uint32_t count, version;
+		if (!reader.U32(count) || !reader.U32(version) || count != expected.mCount || count > mSent)
+			return false;
+
+		mUnacked.erase(mUnacked.begin(), mUnacked.begin() + count);
+		mSent -= count;
+		mAcked += count;
+		if (mRecordLatency)
+			mLatencies.push_back(chrono::duration<double>(Clock::now() - expected.mSent).count());
+		return true;
+	}
+
+	if (expected.mType != MSG_TOP)
+		return false;
+	mTopInFlight = false;
+
+	if (type == MSG_TOP_SAME)
+	{
+		mTopSame++;
+		mTopCurrent = true;
+		return reader.U32(mTopVersion);
+	}
+
+	uint32_t count;
+	if (type != MSG_TOP_LIST || !reader.U32(mTopVersion) || !reader.U32(mTopTotal) || !reader.U32(count) || count > MAX_TOP)
+		return false;
+
+	mTop.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		mTop[i].mId = i;
+		if (!reader.I32(mTop[i].mPoints) || !reader.Name(mTop[i].mName))
+			return false;
+	}
+	mTopLists++;
+	mTopCurrent = true;
+	return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "NetSocket.h"
+#include "Leaderboard.h"
+#include "LeaderboardProtocol.h"
+
+
+// LeaderboardClient class: A cabinet's connection to the venue's leaderboard daemon.
+// Submit and RequestTop only queue, Pump does the talking and never blocks, so the game
+// can call it every tick. Everything submitted since the last Pump goes in one frame, and
+// frames are sent without waiting for the replies to earlier ones. A score is kept until
+// the daemon acknowledges it, so if the daemon isn't there, or the connection drops, the
+// scores wait and are sent once Pump manages to reconnect (it tries every few seconds,
+// and a connect is left to finish in the background while the game carries on).
+// The top list is cached, refreshing it costs a few bytes when the board hasn't changed.
+class LeaderboardClient
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    ~LeaderboardClient() { Close(); }
+
+    // Open function: Sets the daemon's address (see NetSocket.h), the name this cabinet goes by
+    // (the host name if it's empty) and the nonce of the score file the ids come from (see
+    // ScoreStore::GetNonce), then starts connecting. Returns whether the connect got under way (it may
+    // not have finished yet), if not Pump keeps trying. Calling it again while open keeps the
+    // scores that haven't been acknowledged yet.
+    bool Open(const std::string& address, const std::string& cabinet, uint32_t storeNonce);
+    void Close();  // Drops the connection and every score not acknowledged.
+
+    // Submit function: Queues a score, ids have to go up with each score the cabinet submits.
+    void Submit(uint32_t id, int points, const std::string& name);
+
+    // RequestTop function: Asks for the top count scores, GetTop has them once the reply arrives.
+    void RequestTop(uint32_t count);
+
+    // Pump function: Starts or finishes connecting, sends what's queued and handles any replies.
+    void Pump();
+
+    // Wait function: Blocks up to timeoutMs for the daemon to reply, then pumps.
+    void Wait(int timeoutMs);
+
+    // Flush function: Blocks until every submitted score is acknowledged, false if that doesn't happen within timeoutMs.
+    bool Flush(int timeoutMs);
+
+    bool IsOpen() const { return !mAddress.empty(); }
+    bool IsConnected() const { return mSocket != Net::INVALID && !mConnecting; }
+    bool IsConnecting() const { return mConnecting; }
+
+    // Top list, as of the last TOP reply. GetTopVersion is 0 until one arrives. Versions are only
+    // compared with the daemon the list came from, the first request on every connection gets
+    // the whole list, so GetTopLists is what to watch for the list changing.
+    bool HasTop() const { return mTopVersion != 0; }
+    const std::vector<Leaderboard::Entry>& GetTop() const { return mTop; }
+    uint32_t GetTopTotal() const { return mTopTotal; }  // Scores on the whole board.
+    uint32_t GetTopVersion() const { return mTopVersion; }
+
+    size_t GetUnacknowledged() const { return mUnacked.size(); }
+    uint64_t GetAcknowledged() const { return mAcked; }
+    unsigned int GetTopLists() const { return mTopLists; }  // TOP replies that carried a list.
+    unsigned int GetTopSame() const { return mTopSame; }    // TOP replies saying the list hadn't changed.
+
+    // Latencies, seconds from sending each SUBMIT to its ACK, only kept if asked for.
+    void SetRecordLatency(bool _record) { mRecordLatency = _record; }
+    const std::vector<double>& GetLatencies() const { return mLatencies; }
+    void ClearLatencies() { mLatencies.clear(); }
+
+private:
+    // Score struct: A submitted score waiting to be acknowledged.
+    struct Score
+    {
+        uint32_t mId;
+        int mPoints;
+        std::string mName;
+    };
+
+    // Expected struct: A reply the daemon owes, they come back in the order the requests went.
+    struct Expected
+    {
+        LeaderboardProtocol::Message mType;
+        uint32_t mCount;  // Scores in the SUBMIT.
+        Clock::time_point mSent;
+    };
+
+    static constexpr int RETRY_SECONDS = 5;     // Wait between attempts to reach the daemon.
+    static constexpr size_t MAX_BATCH = 2048;   // Most scores in a SUBMIT, keeps frames well under MAX_FRAME.
+
+    bool TryConnect();
+    bool FinishConnect();
+    void SendHello();
+    void Disconnect();  // Keeps the unacknowledged scores to send again.
+    bool Send();
+    bool Receive();
+    bool Handle(LeaderboardProtocol::Message type, const char* data, size_t size);
+
+    std::string mAddress;
+    std::string mCabinet;
+    uint32_t mStoreNonce = 0;
+    Net::Socket mSocket = Net::INVALID;
+    bool mConnecting = false;          // The socket's connect hasn't finished yet.
+    Clock::time_point mNextAttempt;    // While connecting, when to give up on it.
+    std::string mIn;
+    std::string mOut;
+
+    std::deque<Score> mUnacked;   // Oldest first, the first mSent of them have been sent.
+    size_t mSent = 0;
+    std::deque<Expected> mExpected;
+    uint32_t mTopWanted = 0;      // Scores asked for by RequestTop, 0 if there's no request to send.
+    bool mTopInFlight = false;
+
+    std::vector<Leaderboard::Entry> mTop;
+    uint32_t mTopTotal = 0;
+    uint32_t mTopVersion = 0;
+    bool mTopCurrent = false;     // mTopVersion came from the daemon on this connection.
+
+    uint64_t mAcked = 0;
+    unsigned int mTopLists = 0;
+    unsigned int mTopSame = 0;
+    bool mRecordLatency = false;
+    std::vector<double> mLatencies;
+};
@@ -0,0 +1,127 @@
+#include "LeaderboardProtocol.h"
+
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+using namespace LeaderboardProtocol;
+
+
+// CabinetKey function: The same hash the rest of the game uses for names.
+uint64_t LeaderboardProtocol::CabinetKey(const string& name)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : name)
+		hash = (hash ^ c) * 1099511628211ull;
+	return hash;
+}
+
+// StoreKey function: Carries on the cabinet key's hash with the nonce's bytes.
+uint64_t LeaderboardProtocol::StoreKey(uint64_t cabinetKey, uint32_t nonce)
+{
+	uint64_t hash = cabinetKey;
+	for (int i = 0; i < 4; i++)
+		hash = (hash ^ ((nonce >> (i * 8)) & 0xff)) * 1099511628211ull;
+	return hash;
+}
+
+// FrameWriter constructor: Leaves room for the size, End writes it.
+FrameWriter::FrameWriter(string& out, Message type)
+	: mOut(out), mStart(out.size())
+{
+	U32(0);
+	mOut.push_back((char)type);
+}
+
+void FrameWriter::U32(uint32_t v)
+{
+	char b[4] = { (char)v, (char)(v >> 8), (char)(v >> 16), (char)(v >> 24) };
+	mOut.append(b, 4);
+}
+
+void FrameWriter::U64(uint64_t v)
+{
+	U32((uint32_t)v);
+	U32((uint32_t)(v >> 32));
+}
+
+void FrameWriter::Name(const string& name)
+{
+	size_t length = min<size_t>(name.size(), 255);
+	mOut.push_back((char)length);
+	mOut.append(name.data(), length);
+}
+
+// End function: The size counts the type byte and the message, not itself.
+void FrameWriter::End()
+{
+	uint32_t size = (uint32_t)(mOut.size() - mStart - 4);
+	for (int i = 0; i < 4; i++)
+		mOut[mStart + i] = (char)(size >> (i * 8));
+}
+
+bool FrameReader::U32(uint32_t& v)
+{
+	if (mpEnd - mpData < 4)
+	{
+		mpData = mpEnd;
+		return false;
+	}
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(mpData);
+	v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	mpData += 4;
+	return true;
+}
+
+bool FrameReader::I32(int32_t& v)
+{
+	uint32_t u;
+	if (!U32(u))
+		return false;
+	v = (int32_t)u;
+	return true;
+}
+
+bool FrameReader::U64(uint64_t& v)
+{
+	uint32_t lo, hi;
+	if (!U32(lo) || !U32(hi))
+		return false;
+	v = (uint64_t)lo | ((uint64_t)hi << 32);
+	return true;
+}
+
+bool FrameReader::Name(string& name)
+{
+	if (mpData == mpEnd || (size_t)(mpEnd - mpData) < 1 + (size_t)(unsigned char)*mpData)
+	{
+		mpData = mpEnd;
+		return false;
+	}
+
+	size_t length = (unsigned char)*mpData++;
+	name.assign(mpData, length);
+	mpData += length;
+	return true;
+}
+
+// NextFrame function: Only looks at the buffer, the caller drops what's been read once it's done with it.
+int LeaderboardProtocol::NextFrame(const string& buffer, size_t& pos, Message& type, const char*& data, size_t& size)
+{
+	if (buffer.size() - pos < 4)
+		return 0;
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer.data() + pos);
+	uint32_t frameSize = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	if (frameSize == 0 || frameSize > MAX_FRAME)
+		return -1;
+	if (buffer.size() - pos - 4 < frameSize)
+		return 0;
+
+	type = (Message)p[4];
+	data = buffer.data() + pos + 5;
+	size = frameSize - 1;
+	pos += 4 + frameSize;
+	return 1;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+
+// Leaderboard service protocol: What cabinets and the leaderboard daemon send each other.
+//
+//   frame    u32 size of what follows, u8 message type, the message
+//
+//   HELLO     client  u32 protocol version, u64 cabinet key, u32 store nonce (first frame on a connection)
+//   SUBMIT    client  u32 count, then count of: u32 cabinet's id for the score, i32 points, name
+//   TOP       client  u32 how many scores, u32 board version the client already has (0 for none)
+//   ACK       daemon  u32 scores in the SUBMIT it answers, u32 board version
+//   TOP_LIST  daemon  u32 board version, u32 scores on the board, u32 count, then count of: i32 points, name
+//   TOP_SAME  daemon  u32 board version, the client's copy is still current
+//
+// Names are a u8 length and the characters. Integers are little endian. The daemon answers
+// every SUBMIT and TOP with one frame, in the order they came, so a client can keep sending
+// without waiting and match the replies up by counting. The board version goes up whenever
+// a score is added, and carries on from the saved scores when the daemon restarts, which is
+// what lets a client refresh its top list for a few bytes when nothing has changed. A client
+// only sends a version it got on the same connection. A cabinet's ids only go up, the daemon ignores any it has already
+// had, so resending scores that were never acknowledged can't add them twice. Ids are the cabinet's score file's
+// (see ScoreStore.h), so they start again if the file is replaced: the daemon keeps the ids it has had by
+// cabinet and store nonce, and a new file's nonce starts the cabinet's ids afresh.
+namespace LeaderboardProtocol
+{
+    static const uint32_t VERSION = 2;
+    static const uint32_t MAX_FRAME = 1 << 20;  // Bigger frames mean a broken or hostile peer, the connection is dropped.
+    static const uint32_t MAX_TOP = 1000;       // Most scores a TOP_LIST holds.
+
+    enum Message : uint8_t
+    {
+        MSG_HELLO = 1,
+        MSG_SUBMIT = 2,
+        MSG_TOP = 3,
+        MSG_ACK = 0x81,
+        MSG_TOP_LIST = 0x82,
+        MSG_TOP_SAME = 0x83,
+    };
+
+    // CabinetKey function: FNV-1a of a cabinet's name, how the daemon tells cabinets apart.
+    uint64_t CabinetKey(const std::string& name);
+
+    // StoreKey function: The cabinet key with the store nonce hashed on, what the daemon keeps ids by.
+    uint64_t StoreKey(uint64_t cabinetKey, uint32_t nonce);
+
+    // FrameWriter class: Appends one frame to a send buffer, the size is filled in by End.
+    class FrameWriter
+    {
+    public:
+        FrameWriter(std::string& out, Message type);
+        void U32(uint32_t v);
+        void I32(int32_t v) { U32((uint32_t)v); }
+        void U64(uint64_t v);
+        void Name(const std::string& name);  // Longer than 255 characters is cut short.
+        void End();
+
+    private:
+        std::string& mOut;
+        size_t mStart;
+    };
+
+    // FrameReader class: Reads a message, every read after running off the end fails.
+    class FrameReader
+    {
+    public:
+        FrameReader(const char* data, size_t size) : mpData(data), mpEnd(data + size) {}
+        bool U32(uint32_t& v);
+        bool I32(int32_t& v);
+        bool U64(uint64_t& v);
+        bool Name(std::string& name);
+        bool AtEnd() const { return mpData == mpEnd; }
+
+    private:
+        const char* mpData;
+        const char* mpEnd;
+    };
+
+    // NextFrame function: Finds the frame starting at pos in a receive buffer. Returns 1 and
+    // moves pos past it if it has all arrived, 0 if not yet, -1 if the frame is too big to be real.
+    int NextFrame(const std::string& buffer, size_t& pos, Message& type, const char*& data, size_t& size);
+}
@@ -0,0 +1,372 @@
+#include "LeaderboardServer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+
+using namespace std;
+using namespace LeaderboardProtocol;
+
+static const size_t RECV_CHUNK = 64 * 1024;
+
+
+// Open function: Every saved score is ranked before the first connection is taken.
+bool LeaderboardServer::Open(const string& address, const string& storePath, const string& key)
+{
+	Close();
+	if (!mStore.Open(storePath, key))
+		return false;
+
+	mBoard.Clear();
+	mBoard.Reserve(mStore.GetRecords().size());
+	for (const ScoreRecord& record : mStore.GetRecords())
+		mBoard.Insert(record.mPoints, record.mId, record.GetName());
+	mNextId = mStore.GetNextId();
+	mVersion = mNextId + 1;  // Carries on from the last run, a cabinet's cached list can't match a different board
+	mCabinetsPath = storePath + ".cabinets";
+	if (!LoadCabinets())
+		return false;
+
+	mListener = Net::Listen(address);
+	if (mListener == Net::INVALID)
+		return false;
+
+	mQueuedMarks.clear();
+	mMarksTaken = mWriter.GetQueued();  // The writer counts on from its last run
+	mUnlogged.clear();
+	mWriter.Start(mStore, [this](size_t writtenAfter, uint32_t nextIdAfter) { return LogCabinets(writtenAfter, nextIdAfter); });
+	return true;
+}
+
+// Close function: Stopping the writer is what makes sure the scores are on the disk.
+void LeaderboardServer::Close()
+{
+	for (Connection* c : mConnections)
+	{
+		Net::Close(c->mSocket);
+		delete c;
+	}
+	mConnections.clear();
+
+	Net::Close(mListener);
+	mListener = Net::INVALID;
+	mWriter.Stop();
+}
+
+// Poll function: Replies are sent straight after handling, Poll only waits on a connection
+// when its socket was too full to take them.
+void LeaderboardServer::Poll(int timeoutMs)
+{
+	mPollEntries.resize(mConnections.size() + 1);
+	mPollEntries[0].mSocket = mListener;
+	mPollEntries[0].mWantWrite = false;
+	for (size_t i = 0; i < mConnections.size(); i++)
+	{
+		mPollEntries[i + 1].mSocket = mConnections[i]->mSocket;
+		mPollEntries[i + 1].mWantWrite = !mConnections[i]->mOut.empty();
+	}
+
+	if (Net::Poll(mPollEntries.data(), mPollEntries.size(), timeoutMs) <= 0)
+		return;
+
+	for (size_t i = 0; i < mConnections.size(); i++)
+	{
+		Connection& c = *mConnections[i];
+		if (mPollEntries[i + 1].mReadable)
+			Receive(c);
+		if (!c.mClosed && !c.mOut.empty())
+			Send(c);
+	}
+
+	if (mPollEntries[0].mReadable)
+	{
+		Net::Socket s;
+		while ((s = Net::Accept(mListener)) != Net::INVALID)
+		{
+			Connection* c = new Connection();
+			c->mSocket = s;
+			mConnections.push_back(c);
+		}
+	}
+
+	// Drop the connections that closed or broke the protocol
+	auto closed = remove_if(mConnections.begin(), mConnections.end(), [](Connection* c) {
+		if (!c->mClosed)
+			return false;
+		Net::Close(c->mSocket);
+		delete c;
+		return true;
+		});
+	mConnections.erase(closed, mConnections.end());
+}
+
+// Receive function: Reads everything waiting, then handles every complete frame in it.
+void LeaderboardServer::Receive(Connection& c)
+{
+	char buffer[RECV_CHUNK];
+	long got;
+	while ((got = Net::Recv(c.mSocket, buffer, sizeof(buffer))) > 0)
+		c.mIn.append(buffer, (size_t)got);
+	if (got < 0)
+		c.mClosed = true;
+
+	size_t pos = 0;
+	Message type;
+	const char* data;
+	size_t size;
+	int result;
+	while ((result = NextFrame(c.mIn, pos, type, data, size)) > 0)
+	{
+		if (!Handle(c, type, data, size))
+		{
+			c.mClosed = true;
+			return;
+		}
+	}
+	if (result < 0)
+		c.mClosed = true;
+	c.mIn.erase(0, pos);
+}
+
+// Handle function: A cabinet has to say hello before anything else. Only one connection
+// from a cabinet is taken at a time: a second one is another cabinet with the same name,
+// whose scores would be taken for ones already had, so it's refused.
+bool LeaderboardServer::Handle(Connection& c, Message type, const char* data, size_t size)
+{
+	FrameReader reader(data, size);
+	if (type == MSG_HELLO)
+	{
+		uint32_t version, nonce;
+		if (c.mHello || !reader.U32(version) || version != VERSION || !reader.U64(c.mCabinet) || !reader.U32(nonce) || !reader.AtEnd())
+			return false;
+		c.mStoreKey = StoreKey(c.mCabinet, nonce);
+		for (const Connection* other : mConnections)
+		{
+			if (other != &c && other->mHello && !other->mClosed && other->mCabinet == c.mCabinet)
+			{
+				mRefused++;
+				return false;
+			}
+		}
+		c.mHello = true;
+		return true;
+	}
+
+	if (!c.mHello)
+		return false;
+	if (type == MSG_SUBMIT)
+		return HandleSubmit(c, reader);
+	if (type == MSG_TOP)
+		return HandleTop(c, reader);
+	return false;
+}
+
+// HandleSubmit function: Ranks and queues to be saved every score the cabinet hasn't sent before.
+bool LeaderboardServer::HandleSubmit(Connection& c, FrameReader& reader)
+{
+	uint32_t count;
+	if (!reader.U32(count))
+		return false;
+
+	auto cabinet = mCabinetNextIds.find(c.mStoreKey);
+	bool known = cabinet != mCabinetNextIds.end();
+
+	string name;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t id;
+		int32_t points;
+		if (!reader.U32(id) || !reader.I32(points) || !reader.Name(name))
+			return false;
+
+		if (known && id < cabinet->second)
+		{
+			mDuplicates++;
+			continue;
+		}
+
+		if (!known)
+		{
+			cabinet = mCabinetNextIds.emplace(c.mStoreKey, 0).first;
+			known = true;
+		}
+		cabinet->second = id + 1;
+
+		{
+			lock_guard<mutex> lock(mMarksMutex);
+			mQueuedMarks.emplace_back(c.mStoreKey, id + 1);
+		}
+		mBoard.Insert(points, mNextId++, name);
+		mWriter.Queue(points, name);
+		mAccepted++;
+		mVersion++;
+	}
+	if (!reader.AtEnd())
+		return false;
+
+	FrameWriter ack(c.mOut, MSG_ACK);
+	ack.U32(count);
+	ack.U32(mVersion);
+	ack.End();
+	return true;
+}
+
+// HandleTop function: Only sends the list if it's changed since the version the cabinet has.
+bool LeaderboardServer::HandleTop(Connection& c, FrameReader& reader)
+{
+	uint32_t count, knownVersion;
+	if (!reader.U32(count) || !reader.U32(knownVersion) || !reader.AtEnd())
+		return false;
+
+	if (knownVersion == mVersion)
+	{
+		FrameWriter same(c.mOut, MSG_TOP_SAME);
+		same.U32(mVersion);
+		same.End();
+		return true;
+	}
+
+	count = (uint32_t)min<size_t>(min(count, MAX_TOP), mBoard.Size());
+	FrameWriter list(c.mOut, MSG_TOP_LIST);
+	list.U32(mVersion);
+	list.U32((uint32_t)mBoard.Size());
+	list.U32(count);
+	mBoard.ForEach(0, count, [&list](size_t, const Leaderboard::Entry& e) {
+		list.I32(e.mPoints);
+		list.Name(e.mName);
+		});
+	list.End();
+	return true;
+}
+
+// Send function: Whatever the socket can't take now stays buffered for the next Poll.
+void LeaderboardServer::Send(Connection& c)
+{
+	size_t sent = 0;
+	while (sent < c.mOut.size())
+	{
+		long n = Net::Send(c.mSocket, c.mOut.data() + sent, c.mOut.size() - sent);
+		if (n < 0)
+		{
+			c.mClosed = true;
+			break;
+		}
+		if (n == 0)
+			break;
+		sent += (size_t)n;
+	}
+	c.mOut.erase(0, sent);
+}
+
+// LoadCabinets function: The file is lines of "<score id> <store key>=<next id> ...", each
+// written before the scores it's for were appended and holding the cabinets they changed.
+// A line is only believed if the score file has the scores up to its id, the rest are from
+// appends that never finished. What's believed is written back as a single line.
+bool LeaderboardServer::LoadCabinets()
+{
+	mCabinetNextIds.clear();
+
+	string text;
+	FILE* pFile = fopen(mCabinetsPath.c_str(), "rb");
+	bool existed = pFile != nullptr;
+	if (existed)
+	{
+		char buffer[4096];
+		size_t got;
+		while ((got = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+			text.append(buffer, got);
+		bool ok = !ferror(pFile);
+		fclose(pFile);
+		if (!ok)
+			return false;
+	}
+	else if (filesystem::exists(mCabinetsPath))
+		return false;
+
+	// A line without its newline is one a crash cut short
+	size_t start = 0, end;
+	while ((end = text.find('\n', start)) != string::npos)
+	{
+		string line = text.substr(start, end - start);
+		start = end + 1;
+
+		char* pNext;
+		uint32_t scoreId = (uint32_t)strtoul(line.c_str(), &pNext, 10);
+		if (pNext == line.c_str() || scoreId > mStore.GetNextId())
+			continue;
+		while (*pNext == ' ')
+		{
+			uint64_t key = strtoull(pNext + 1, &pNext, 16);
+			if (*pNext != '=')
+				break;
+			uint32_t nextId = (uint32_t)strtoul(pNext + 1, &pNext, 10);
+			uint32_t& known = mCabinetNextIds[key];
+			known = max(known, nextId);
+		}
+	}
+
+	if (mCabinetNextIds.empty() && !existed)
+		return true;
+
+	string tempPath = mCabinetsPath + ".tmp";
+	pFile = fopen(tempPath.c_str(), "wb");
+	if (!pFile)
+		return false;
+	fprintf(pFile, "%u", mStore.GetNextId());
+	for (const auto& cabinet : mCabinetNextIds)
+		fprintf(pFile, " %llx=%u", (unsigned long long)cabinet.first, cabinet.second);
+	fputc('\n', pFile);
+	bool ok = ScoreFile::SyncFile(pFile);
+	ok = fclose(pFile) == 0 && ok;
+
+	error_code ec;
+	if (ok)
+	{
+		filesystem::rename(tempPath, mCabinetsPath, ec);
+		ok = !ec;
+	}
+	if (ok)
+		ScoreFile::SyncDirectory(mCabinetsPath);
+	else
+		filesystem::remove(tempPath, ec);
+	return ok;
+}
+
+// LogCabinets function: Appends the line for the scores about to be written, synced so it's on the
+// disk before they are. A failed write is cut back off and its cabinets go in the next attempt's line.
+bool LeaderboardServer::LogCabinets(size_t writtenAfter, uint32_t nextIdAfter)
+{
+	{
+		lock_guard<mutex> lock(mMarksMutex);
+		for (; mMarksTaken < writtenAfter && !mQueuedMarks.empty(); mMarksTaken++)
+		{
+			mUnlogged[mQueuedMarks.front().first] = mQueuedMarks.front().second;
+			mQueuedMarks.pop_front();
+		}
+	}
+	if (mUnlogged.empty())
+		return true;
+
+	FILE* pFile = fopen(mCabinetsPath.c_str(), "ab");
+	if (!pFile)
+		return false;
+
+	long start = fseek(pFile, 0, SEEK_END) == 0 ? ftell(pFile) : -1;
+	bool ok = start >= 0 && fprintf(pFile, "%u", nextIdAfter) > 0;
+	for (const auto& cabinet : mUnlogged)
+		ok = ok && fprintf(pFile, " %llx=%u", (unsigned long long)cabinet.first, cabinet.second) > 0;
+	ok = ok && fputc('\n', pFile) != EOF && ScoreFile::SyncFile(pFile);
+	ok = fclose(pFile) == 0 && ok;
+	if (start == 0)
+		ScoreFile::SyncDirectory(mCabinetsPath);
+
+	if (ok)
+		mUnlogged.clear();
+	else if (start >= 0)
+	{
+		error_code ec;
+		filesystem::resize_file(mCabinetsPath, (uintmax_t)start, ec);
+	}
+	return ok;
+}
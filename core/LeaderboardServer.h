@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+
+#include "NetSocket.h"
+#include "Leaderboard.h"
+#include "LeaderboardProtocol.h"
+#include "ScoreStore.h"
+#include "ScoreWriter.h"
+
+
+// LeaderboardServer class: The shared leaderboard the cabinets at a venue submit their scores to.
+// It's one thread polling every connection: a connection's frames are handled as soon as
+// they're all in, however many arrived at once, and the replies are sent together. Scores
+// are ranked in a Leaderboard and saved in the daemon's own score file through a
+// ScoreWriter, so the disk never holds up a reply. See LeaderboardProtocol.h for the frames.
+// Each cabinet score file's next id is kept in a file beside the score file ("<scoreFile>.cabinets"),
+// written by the ScoreWriter just before the scores themselves, so a daemon that restarts
+// still knows which scores it already has when cabinets resend the ones it never acknowledged.
+class LeaderboardServer
+{
+public:
+    ~LeaderboardServer() { Close(); }
+
+    // Open function: Loads the saved scores and cabinets and starts listening, false if any of it fails.
+    bool Open(const std::string& address, const std::string& storePath, const std::string& key);
+
+    // Poll function: Waits up to timeoutMs for traffic, then handles everything that came in.
+    void Poll(int timeoutMs);
+
+    // Close function: Drops every connection and writes any scores still queued.
+    void Close();
+
+    const Leaderboard& GetLeaderboard() const { return mBoard; }
+    size_t GetConnections() const { return mConnections.size(); }
+    uint64_t GetAccepted() const { return mAccepted; }      // Scores added to the board.
+    uint64_t GetDuplicates() const { return mDuplicates; }  // Scores resent by a cabinet that were already on it.
+    uint64_t GetRefused() const { return mRefused; }        // HELLOs from a cabinet already connected, two cabinets sharing a name.
+
+private:
+    // Connection struct: A cabinet's connection and what's buffered either way.
+    struct Connection
+    {
+        Net::Socket mSocket = Net::INVALID;
+        std::string mIn;
+        std::string mOut;
+        uint64_t mCabinet = 0;   // Tells cabinets apart.
+        uint64_t mStoreKey = 0;  // The cabinet and its score file, what its ids are kept by.
+        bool mHello = false;
+        bool mClosed = false;
+    };
+
+    void Receive(Connection& c);
+    bool Handle(Connection& c, LeaderboardProtocol::Message type, const char* data, size_t size);  // False drops the connection.
+    bool HandleSubmit(Connection& c, LeaderboardProtocol::FrameReader& reader);
+    bool HandleTop(Connection& c, LeaderboardProtocol::FrameReader& reader);
+    void Send(Connection& c);
+    bool LoadCabinets();
+    bool LogCabinets(size_t writtenAfter, uint32_t nextIdAfter);  // On the writer's thread.
+
+    Net::Socket mListener = Net::INVALID;
+    std::vector<Connection*> mConnections;
+    std::vector<Net::PollEntry> mPollEntries;
+
+    Leaderboard mBoard;
+    ScoreStore mStore;
+    ScoreWriter mWriter;
+    uint32_t mNextId = 0;        // Id of the next score on the board.
+    uint32_t mVersion = 1;       // Goes up with every score added, starting from the saved scores' next id.
+    std::unordered_map<uint64_t, uint32_t> mCabinetNextIds;  // Lowest id not yet had from each cabinet's score file, by store key.
+    std::string mCabinetsPath;
+
+    // Each queued score's cabinet and the next id it takes that cabinet to, in the order they
+    // were queued, for LogCabinets to take as the writer writes them.
+    std::mutex mMarksMutex;
+    std::deque<std::pair<uint64_t, uint32_t>> mQueuedMarks;
+    size_t mMarksTaken = 0;                                  // Scores queued before the next mark, only the writer's thread uses this and mUnlogged.
+    std::unordered_map<uint64_t, uint32_t> mUnlogged;        // Taken but not yet in the file.
+    uint64_t mAccepted = 0;
+    uint64_t mDuplicates = 0;
+    uint64_t mRefused = 0;
+};
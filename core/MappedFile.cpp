@@ -0,0 +1,108 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+
+#if defined(_WIN32) || !defined(MAP_POPULATE)
+// Prefault function: One read of each page faults the lot in.
+static void Prefault(const char* pData, size_t size)
+{
+	const size_t PAGE = 4096;
+	volatile char sink = 0;
+	for (size_t i = 0; i < size; i += PAGE)
+		sink = sink + pData[i];
+}
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const string& path, bool prefault)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+	mFile = file;
+	mExists = true;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+		return;
+	if (size.QuadPart == 0)
+	{
+		mOk = true;
+		return;
+	}
+
+	mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mMapping)
+		mpData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+	if (mpData)
+	{
+		mSize = (size_t)size.QuadPart;
+		mOk = true;
+		if (prefault)
+			Prefault(mpData, mSize);
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	if (mpData)
+		UnmapViewOfFile(mpData);
+	if (mMapping)
+		CloseHandle(mMapping);
+	if (mFile)
+		CloseHandle(mFile);
+}
+#else
+MappedFile::MappedFile(const string& path, bool prefault)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return;
+	mExists = true;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0)
+	{
+		if (st.st_size == 0)
+			mOk = true;
+		else
+		{
+			int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+			if (prefault)
+				flags |= MAP_POPULATE;  // The kernel maps every page in one go, no fault per page
+#endif
+			void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, flags, fd, 0);
+			if (p != MAP_FAILED)
+			{
+				mpData = static_cast<const char*>(p);
+				mSize = (size_t)st.st_size;
+				mOk = true;
+#ifndef MAP_POPULATE
+				if (prefault)
+					Prefault(mpData, mSize);
+#endif
+			}
+		}
+	}
+	close(fd);  // The mapping keeps the file
+}
+
+MappedFile::~MappedFile()
+{
+	if (mpData)
+		munmap(const_cast<char*>(mpData), mSize);
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+
+// MappedFile class: A whole file mapped read only, for as long as it's in scope.
+// Reading it straight out of the mapping skips copying it into a buffer of its own, and
+// the pages are the OS's file cache so they cost nothing to let go of.
+class MappedFile
+{
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Constructor: prefault reads every page in now rather than on first touch, so a
+    // thread that maps a file to hand it to another does the disk reads itself.
+    explicit MappedFile(const std::string& path, bool prefault = false);
+    ~MappedFile();
+
+    bool Exists() const { return mExists; }
+    bool IsOk() const { return mOk; }  // Mapped, or exists and is empty.
+    const char* GetData() const { return mpData; }
+    size_t GetSize() const { return mSize; }
+
+private:
+#ifdef _WIN32
+    void* mFile = nullptr;     // HANDLEs, windows.h stays out of the header.
+    void* mMapping = nullptr;
+#endif
+    const char* mpData = nullptr;
+    size_t mSize = 0;
+    bool mExists = false;
+    bool mOk = false;
+};
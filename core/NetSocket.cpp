@@ -0,0 +1,284 @@
+#include "NetSocket.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+using namespace std;
+
+
+#ifdef _WIN32
+static bool WouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+static bool InProgress() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+static void CloseRaw(Net::Socket s) { closesocket((SOCKET)s); }
+static int PollRaw(WSAPOLLFD* fds, size_t count, int timeoutMs) { return WSAPoll(fds, (ULONG)count, timeoutMs); }
+typedef WSAPOLLFD PollFd;
+#else
+static bool WouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+static bool InProgress() { return errno == EINPROGRESS; }
+static void CloseRaw(Net::Socket s) { close(s); }
+static int PollRaw(pollfd* fds, size_t count, int timeoutMs) { return poll(fds, (nfds_t)count, timeoutMs); }
+typedef pollfd PollFd;
+#endif
+
+// SetNonBlocking function: Sends and receives return straight away from now on.
+static bool SetNonBlocking(Net::Socket s)
+{
+#ifdef _WIN32
+	u_long on = 1;
+	return ioctlsocket((SOCKET)s, FIONBIO, &on) == 0;
+#else
+	int flags = fcntl(s, F_GETFL, 0);
+	return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+// SetNoDelay function: Small frames go out at once rather than waiting to be merged, only for TCP.
+static void SetNoDelay(Net::Socket s)
+{
+	int on = 1;
+	setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+}
+
+// Finish function: Makes a new socket non blocking, closing it if that fails.
+static Net::Socket Finish(Net::Socket s, bool tcp)
+{
+	if (s == Net::INVALID)
+		return s;
+	if (tcp)
+		SetNoDelay(s);
+	if (!SetNonBlocking(s))
+	{
+		CloseRaw(s);
+		return Net::INVALID;
+	}
+	return s;
+}
+
+// StartConnect function: Makes a new socket non blocking before connecting it, so the connect
+// can't block either. INVALID if it failed straight away, pending if it's still going.
+static Net::Socket StartConnect(Net::Socket s, const sockaddr* addr, socklen_t size, bool tcp, bool& pending)
+{
+	pending = false;
+	s = Finish(s, tcp);
+	if (s == Net::INVALID || connect(s, addr, size) == 0)
+		return s;
+	if (InProgress())
+	{
+		pending = true;
+		return s;
+	}
+	CloseRaw(s);
+	return Net::INVALID;
+}
+
+// ParseTcp function: Splits "tcp:host:port", false if it isn't a TCP address.
+static bool ParseTcp(const string& address, string& host, string& port)
+{
+	if (address.compare(0, 4, "tcp:") != 0)
+		return false;
+	size_t colon = address.rfind(':');
+	if (colon <= 4)
+		return false;
+	host = address.substr(4, colon - 4);
+	port = address.substr(colon + 1);
+	return !host.empty() && !port.empty();
+}
+
+#ifndef _WIN32
+// ParseUnix function: Fills in the socket address for "unix:/path", false if it isn't one or the path is too long.
+static bool ParseUnix(const string& address, sockaddr_un& addr)
+{
+	if (address.compare(0, 5, "unix:") != 0)
+		return false;
+	string path = address.substr(5);
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (path.empty() || path.size() >= sizeof(addr.sun_path))
+		return false;
+	memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	return true;
+}
+#endif
+
+// Init function: Winsock has to be started by every process that uses it.
+bool Net::Init()
+{
+#ifdef _WIN32
+	WSADATA data;
+	return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+	signal(SIGPIPE, SIG_IGN);  // A peer closing shows as a failed send instead
+	return true;
+#endif
+}
+
+// HostName function: Longer names than fit the buffer count as not found.
+string Net::HostName()
+{
+	char name[256];
+	if (gethostname(name, (int)sizeof(name)) != 0)
+		return string();
+	name[sizeof(name) - 1] = '\0';
+	return name;
+}
+
+// Listen function: A Unix socket file left behind by a previous run is replaced.
+Net::Socket Net::Listen(const string& address)
+{
+#ifndef _WIN32
+	sockaddr_un unixAddr;
+	if (ParseUnix(address, unixAddr))
+	{
+		Socket s = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (s == INVALID)
+			return INVALID;
+		unlink(unixAddr.sun_path);
+		if (bind(s, (sockaddr*)&unixAddr, sizeof(unixAddr)) != 0 || listen(s, SOMAXCONN) != 0)
+		{
+			CloseRaw(s);
+			return INVALID;
+		}
+		return Finish(s, false);
+	}
+#endif
+
+	string host, port;
+	addrinfo hints = {}, *pInfo = nullptr;
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+	if (!ParseTcp(address, host, port) || getaddrinfo(host.c_str(), port.c_str(), &hints, &pInfo) != 0)
+		return INVALID;
+
+	Socket s = (Socket)socket(pInfo->ai_family, pInfo->ai_socktype, pInfo->ai_protocol);
+	if (s != INVALID)
+	{
+		int on = 1;
+		setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+		if (bind(s, pInfo->ai_addr, (int)pInfo->ai_addrlen) != 0 || listen(s, SOMAXCONN) != 0)
+		{
+			CloseRaw(s);
+			s = INVALID;
+		}
+	}
+	freeaddrinfo(pInfo);
+	return Finish(s, true);
+}
+
+// Connect function: A TCP address that resolves to several tries the first one the OS will
+// start a connect to, there's no waiting to see which answers.
+Net::Socket Net::Connect(const string& address, bool& pending)
+{
+	pending = false;
+#ifndef _WIN32
+	sockaddr_un unixAddr;
+	if (ParseUnix(address, unixAddr))
+		return StartConnect(socket(AF_UNIX, SOCK_STREAM, 0), (sockaddr*)&unixAddr, sizeof(unixAddr), false, pending);
+#endif
+
+	string host, port;
+	addrinfo hints = {}, *pInfo = nullptr;
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	if (!ParseTcp(address, host, port) || getaddrinfo(host.c_str(), port.c_str(), &hints, &pInfo) != 0)
+		return INVALID;
+
+	Socket s = INVALID;
+	for (addrinfo* p = pInfo; p && s == INVALID; p = p->ai_next)
+		s = StartConnect((Socket)socket(p->ai_family, p->ai_socktype, p->ai_protocol), p->ai_addr, (socklen_t)p->ai_addrlen, true, pending);
+	freeaddrinfo(pInfo);
+	return s;
+}
+
+// ConnectError function: The result of a non blocking connect is kept as the socket's error.
+int Net::ConnectError(Socket s)
+{
+	int error = 0;
+	socklen_t size = sizeof(error);
+	if (getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&error, &size) != 0)
+		return -1;
+	return error;
+}
+
+// Accept function: Unix and TCP connections are told apart by the listener's address family.
+Net::Socket Net::Accept(Socket listener)
+{
+	sockaddr_storage addr;
+	socklen_t size = sizeof(addr);
+	Socket s = (Socket)accept(listener, (sockaddr*)&addr, &size);
+	if (s == INVALID)
+		return INVALID;
+	return Finish(s, addr.ss_family != AF_UNIX);
+}
+
+void Net::Close(Socket s)
+{
+	if (s != INVALID)
+		CloseRaw(s);
+}
+
+// Send function: A full socket buffer isn't an error, the caller tries again when Poll says there's room.
+long Net::Send(Socket s, const void* data, size_t size)
+{
+#ifdef _WIN32
+	int sent = send((SOCKET)s, (const char*)data, (int)size, 0);
+#elif defined(MSG_NOSIGNAL)
+	long sent = (long)send(s, data, size, MSG_NOSIGNAL);
+#else
+	long sent = (long)send(s, data, size, 0);
+#endif
+	if (sent < 0)
+		return WouldBlock() ? 0 : -1;
+	return (long)sent;
+}
+
+// Recv function: 0 from the OS means the peer closed, here that's -1 and 0 means try later.
+long Net::Recv(Socket s, void* data, size_t size)
+{
+#ifdef _WIN32
+	int got = recv((SOCKET)s, (char*)data, (int)size, 0);
+#else
+	long got = (long)recv(s, data, size, 0);
+#endif
+	if (got < 0)
+		return WouldBlock() ? 0 : -1;
+	return got == 0 ? -1 : (long)got;
+}
+
+// Poll function: An error or hang up counts as readable, the Recv that follows reports it.
+int Net::Poll(PollEntry* entries, size_t count, int timeoutMs)
+{
+	vector<PollFd> fds(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		fds[i].fd = entries[i].mSocket;
+		fds[i].events = (short)(POLLIN | (entries[i].mWantWrite ? POLLOUT : 0));
+		fds[i].revents = 0;
+	}
+
+	int ready = PollRaw(fds.data(), count, timeoutMs);
+	for (size_t i = 0; i < count; i++)
+	{
+		entries[i].mReadable = ready > 0 && (fds[i].revents & (POLLIN | POLLERR | POLLHUP)) != 0;
+		entries[i].mWritable = ready > 0 && (fds[i].revents & POLLOUT) != 0;
+	}
+	return ready;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+
+// Net namespace: Just enough sockets for the leaderboard service, on POSIX and Winsock.
+// Addresses are "unix:/path/to/socket" for a Unix domain socket (not on Windows) or
+// "tcp:host:port" for TCP, meant for loopback ("tcp:127.0.0.1:7301"). Every socket handed
+// out is non blocking: Send and Recv return 0 rather than waiting, and Poll is how to wait.
+namespace Net
+{
+#ifdef _WIN32
+    typedef uintptr_t Socket;
+#else
+    typedef int Socket;
+#endif
+    static const Socket INVALID = (Socket)-1;
+
+    // Init function: Starts Winsock and stops a closed connection raising SIGPIPE, call once before anything else.
+    bool Init();
+
+    // HostName function: This machine's name on the network, empty if it can't be found.
+    std::string HostName();
+
+    // Listen function: Creates a listening socket, INVALID if the address is bad or taken.
+    Socket Listen(const std::string& address);
+
+    // Connect function: Starts connecting to a listening socket, INVALID if it can't even start
+    // (a bad address, or nothing listening on a Unix socket). Never waits: pending comes back
+    // true if the connect carries on in the background, then the socket is writable once it's
+    // finished (or readable, if it failed) and ConnectError says how it went.
+    Socket Connect(const std::string& address, bool& pending);
+
+    // ConnectError function: 0 if a pending connect succeeded, otherwise the OS's error for it.
+    int ConnectError(Socket s);
+
+    // Accept function: The next waiting connection, INVALID if there isn't one.
+    Socket Accept(Socket listener);
+
+    void Close(Socket s);
+
+    // Send function: Bytes sent, 0 if the socket can't take any now, -1 if the connection failed.
+    long Send(Socket s, const void* data, size_t size);
+
+    // Recv function: Bytes received, 0 if none have arrived, -1 if the connection closed or failed.
+    long Recv(Socket s, void* data, size_t size);
+
+    // PollEntry struct: A socket to wait on, and what it turned out to be ready for.
+    struct PollEntry
+    {
+        Socket mSocket = INVALID;
+        bool mWantWrite = false;  // Wait for room to send as well as for data.
+        bool mReadable = false;   // Data, a connection to accept, or the connection closing.
+        bool mWritable = false;
+    };
+
+    // Poll function: Waits up to timeoutMs for any entry to be ready, returns how many are, -1 on error.
+    int Poll(PollEntry* entries, size_t count, int timeoutMs);
+}
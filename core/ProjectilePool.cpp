@@ -0,0 +1,207 @@
+#include "ProjectilePool.h"
+#include "BoxKernel.h"
+#include "SimdConfig.h"
+
+#include <cassert>
+
+
+// Init function: Sizes every array to the capacity, after this the pool never allocates.
+void ProjectilePool::Init(size_t capacity)
+{
+	assert(capacity < NOT_LIVE);
+
+	// Pad the live arrays so the SIMD loops and the box kernel can always read whole lanes
+	size_t padded = (capacity + BoxKernel::LANES - 1) / BoxKernel::LANES * BoxKernel::LANES;
+	for (std::vector<float>* v : { &mPosX, &mPosY, &mPrevX, &mPrevY, &mVelX, &mVelY, &mHalfW, &mHalfH, &mLeft, &mTop, &mRight, &mBottom })
+		v->assign(padded, 0.0f);
+	mType.assign(padded, 0);
+	mLiveToSlot.assign(padded, 0);
+	mLiveCount = 0;
+
+	mGenerations.assign(capacity, 0);
+	mSlotToLive.assign(capacity, NOT_LIVE);
+	mFree.clear();
+	mFree.reserve(capacity);
+
+	// Push in reverse so the lowest slots get handed out first
+	for (size_t i = capacity; i > 0; i--)
+		mFree.push_back((uint32_t)(i - 1));
+
+	for (size_t& count : mTypeCounts)
+		count = 0;
+}
+
+// Spawn function: Pops a slot off the free list and appends the projectile to the live list.
+ProjectileHandle ProjectilePool::Spawn(Type _type, const SimVec2& _pos, const SimVec2& _velocity, const SimVec2& _halfExtents)
+{
+	ProjectileHandle handle;
+	if (mFree.empty())
+		return handle;
+
+	uint32_t slot = mFree.back();
+	mFree.pop_back();
+
+	size_t i = mLiveCount++;
+	mType[i] = _type;
+	mPosX[i] = _pos.x;
+	mPosY[i] = _pos.y;
+	mPrevX[i] = _pos.x;
+	mPrevY[i] = _pos.y;
+	mVelX[i] = _velocity.x;
+	mVelY[i] = _velocity.y;
+	mHalfW[i] = _halfExtents.x;
+	mHalfH[i] = _halfExtents.y;
+	mLeft[i] = _pos.x - _halfExtents.x;
+	mTop[i] = _pos.y - _halfExtents.y;
+	mRight[i] = _pos.x + _halfExtents.x;
+	mBottom[i] = _pos.y + _halfExtents.y;
+	mLiveToSlot[i] = slot;
+	mSlotToLive[slot] = (uint32_t)i;
+	mTypeCounts[_type]++;
+
+	handle.mIndex = slot;
+	handle.mGeneration = mGenerations[slot];
+	return handle;
+}
+
+// Free function: Looks the handle up and frees its projectile.
+void ProjectilePool::Free(ProjectileHandle _handle)
+{
+	if (IsValid(_handle))
+		FreeAt(mSlotToLive[_handle.mIndex]);
+}
+
+// FreeAt function: Moves the last live projectile into the gap, bumps the slot's generation and pushes it on the free list.
+void ProjectilePool::FreeAt(size_t i)
+{
+	assert(i < mLiveCount);
+
+	uint32_t slot = mLiveToSlot[i];
+	mTypeCounts[mType[i]]--;
+
+	size_t last = --mLiveCount;
+	if (i != last)
+	{
+		mType[i] = mType[last];
+		mPosX[i] = mPosX[last];
+		mPosY[i] = mPosY[last];
+		mPrevX[i] = mPrevX[last];
+		mPrevY[i] = mPrevY[last];
+		mVelX[i] = mVelX[last];
+		mVelY[i] = mVelY[last];
+		mHalfW[i] = mHalfW[last];
+		mHalfH[i] = mHalfH[last];
+		mLeft[i] = mLeft[last];
+		mTop[i] = mTop[last];
+		mRight[i] = mRight[last];
+		mBottom[i] = mBottom[last];
+		mLiveToSlot[i] = mLiveToSlot[last];
+		mSlotToLive[mLiveToSlot[i]] = (uint32_t)i;
+	}
+
+	mSlotToLive[slot] = NOT_LIVE;
+	mGenerations[slot]++;
+	mFree.push_back(slot);
+}
+
+// FreeAll function: Frees from the back so nothing needs moving.
+void ProjectilePool::FreeAll()
+{
+	while (mLiveCount > 0)
+		FreeAt(mLiveCount - 1);
+}
+
+// Move function: Integrates and rebuilds the colliders a whole register of projectiles at a time.
+// The last group may run past the live count, the padding makes that safe and spawning overwrites it.
+void ProjectilePool::Move(float dTime)
+{
+#if defined(IA_SIMD_AVX)
+	const __m256 dt = _mm256_set1_ps(dTime);
+	for (size_t i = 0; i < mLiveCount; i += 8)
+	{
+		__m256 px = _mm256_loadu_ps(&mPosX[i]);
+		__m256 py = _mm256_loadu_ps(&mPosY[i]);
+		__m256 x = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(&mVelX[i]), dt));
+		__m256 y = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(&mVelY[i]), dt));
+		__m256 hw = _mm256_loadu_ps(&mHalfW[i]);
+		__m256 hh = _mm256_loadu_ps(&mHalfH[i]);
+
+		_mm256_storeu_ps(&mPrevX[i], px);
+		_mm256_storeu_ps(&mPrevY[i], py);
+		_mm256_storeu_ps(&mPosX[i], x);
+		_mm256_storeu_ps(&mPosY[i], y);
+		_mm256_storeu_ps(&mLeft[i], _mm256_sub_ps(x, hw));
+		_mm256_storeu_ps(&mTop[i], _mm256_sub_ps(y, hh));
+		_mm256_storeu_ps(&mRight[i], _mm256_add_ps(x, hw));
+		_mm256_storeu_ps(&mBottom[i], _mm256_add_ps(y, hh));
+	}
+#elif defined(IA_SIMD_SSE)
+	const __m128 dt = _mm_set1_ps(dTime);
+	for (size_t i = 0; i < mLiveCount; i += 4)
+	{
+		__m128 px = _mm_loadu_ps(&mPosX[i]);
+		__m128 py = _mm_loadu_ps(&mPosY[i]);
+		__m128 x = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(&mVelX[i]), dt));
+		__m128 y = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(&mVelY[i]), dt));
+		__m128 hw = _mm_loadu_ps(&mHalfW[i]);
+		__m128 hh = _mm_loadu_ps(&mHalfH[i]);
+
+		_mm_storeu_ps(&mPrevX[i], px);
+		_mm_storeu_ps(&mPrevY[i], py);
+		_mm_storeu_ps(&mPosX[i], x);
+		_mm_storeu_ps(&mPosY[i], y);
+		_mm_storeu_ps(&mLeft[i], _mm_sub_ps(x, hw));
+		_mm_storeu_ps(&mTop[i], _mm_sub_ps(y, hh));
+		_mm_storeu_ps(&mRight[i], _mm_add_ps(x, hw));
+		_mm_storeu_ps(&mBottom[i], _mm_add_ps(y, hh));
+	}
+#else
+	MoveScalar(dTime);
+#endif
+}
+
+// MoveScalar function: One projectile at a time, same results as Move.
+void ProjectilePool::MoveScalar(float dTime)
+{
+	for (size_t i = 0; i < mLiveCount; i++)
+	{
+		mPrevX[i] = mPosX[i];
+		mPrevY[i] = mPosY[i];
+		mPosX[i] += mVelX[i] * dTime;
+		mPosY[i] += mVelY[i] * dTime;
+		mLeft[i] = mPosX[i] - mHalfW[i];
+		mTop[i] = mPosY[i] - mHalfH[i];
+		mRight[i] = mPosX[i] + mHalfW[i];
+		mBottom[i] = mPosY[i] + mHalfH[i];
+	}
+}
+
+// Cull function: Walks the live list backwards so the projectile moved into a freed gap has already been checked.
+void ProjectilePool::Cull(const SimBox& _area)
+{
+	for (size_t i = mLiveCount; i > 0; i--)
+	{
+		size_t p = i - 1;
+		if (mPosX[p] < _area.mLeft || mPosX[p] > _area.mRight || mPosY[p] < _area.mTop || mPosY[p] > _area.mBottom)
+			FreeAt(p);
+	}
+}
+
+// GetLiveHandle function: Makes a handle for the projectile at a position in the live list.
+ProjectileHandle ProjectilePool::GetLiveHandle(size_t i) const
+{
+	assert(i < mLiveCount);
+
+	ProjectileHandle handle;
+	handle.mIndex = mLiveToSlot[i];
+	handle.mGeneration = mGenerations[handle.mIndex];
+	return handle;
+}
+
+// GetBox function: Gathers a single projectile's collider from the edge arrays.
+SimBox ProjectilePool::GetBox(size_t i) const
+{
+	SimBox box;
+	box.UpdateBox(mLeft[i], mTop[i], mRight[i], mBottom[i]);
+	return box;
+}
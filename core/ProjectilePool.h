@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "SimTypes.h"
+
+
+// ProjectileHandle struct: Refers to a projectile in a ProjectilePool.
+// The generation is bumped every time a slot is freed, so a handle kept after its
+// projectile has hit something or left the screen is detected as stale instead of
+// silently pointing at whatever was spawned into the slot next.
+struct ProjectileHandle
+{
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t mIndex = INVALID_INDEX;  // Slot in the pool.
+    uint32_t mGeneration = 0;         // Generation of the slot when the handle was made.
+
+    bool IsNull() const { return mIndex == INVALID_INDEX; }
+};
+
+// ProjectilePool class: Fixed capacity storage for every projectile in the game.
+// All memory is allocated up front by Init, spawning and freeing just pop and push
+// a free list so nothing touches the heap during play.
+// The live projectiles are packed at the front of structure-of-arrays storage, freeing
+// one moves the last live projectile into its place, so movement and collision passes
+// are straight vectorised sweeps over GetLiveCount() entries with no holes to skip.
+// Handles go through a slot table so they stay valid while projectiles are moved around.
+class ProjectilePool
+{
+public:
+    // Type enum: What fired the projectile, new types only need adding here.
+    enum Type : uint8_t { MISSILE, LASER, TYPE_COUNT };
+
+    // Init function: Allocates room for capacity projectiles, any already spawned are lost.
+    void Init(size_t capacity);
+
+    // Spawn function: Takes a free slot, returns a null handle if the pool is full.
+    ProjectileHandle Spawn(Type _type, const SimVec2& _pos, const SimVec2& _velocity, const SimVec2& _halfExtents);
+
+    // Free function: Returns the projectile's slot to the pool, stale handles are ignored.
+    void Free(ProjectileHandle _handle);
+
+    // FreeAt function: Frees the projectile at position i of the live list.
+    void FreeAt(size_t i);
+
+    // FreeAll function: Returns every slot to the pool, all outstanding handles become stale.
+    void FreeAll();
+
+    // Move function: Moves every live projectile by its velocity and rebuilds its collider using the widest SIMD available.
+    // Where each projectile was before is kept for the renderer to interpolate from.
+    void Move(float dTime);
+
+    // MoveScalar function: Plain loop version of Move, used when no SIMD is available and for benchmarking.
+    void MoveScalar(float dTime);
+
+    // Cull function: Frees every projectile whose centre has left the area.
+    void Cull(const SimBox& _area);
+
+    // IsValid function: Whether the handle still refers to a live projectile.
+    bool IsValid(ProjectileHandle _handle) const
+    {
+        return _handle.mIndex < mGenerations.size() && mGenerations[_handle.mIndex] == _handle.mGeneration && mSlotToLive[_handle.mIndex] != NOT_LIVE;
+    }
+
+    // GetLiveIndex function: Position of a projectile in the live list, -1 if the handle is stale.
+    int GetLiveIndex(ProjectileHandle _handle) const { return IsValid(_handle) ? (int)mSlotToLive[_handle.mIndex] : -1; }
+    ProjectileHandle GetLiveHandle(size_t i) const;
+
+    // Accessors for the projectile at position i of the live list (0 to GetLiveCount() - 1).
+    size_t GetLiveCount() const { return mLiveCount; }
+    size_t GetLiveCount(Type _type) const { return mTypeCounts[_type]; }
+    Type GetType(size_t i) const { return (Type)mType[i]; }
+    SimVec2 GetPos(size_t i) const { return SimVec2(mPosX[i], mPosY[i]); }
+    SimVec2 GetPrevPos(size_t i) const { return SimVec2(mPrevX[i], mPrevY[i]); }  // Position before the last Move.
+    SimBox GetBox(size_t i) const;
+
+    // Raw collider arrays for the box kernel, readable up to the capacity rounded up to BoxKernel::LANES.
+    const float* GetLefts() const { return mLeft.data(); }
+    const float* GetTops() const { return mTop.data(); }
+    const float* GetRights() const { return mRight.data(); }
+    const float* GetBottoms() const { return mBottom.data(); }
+
+    size_t GetCapacity() const { return mGenerations.size(); }
+
+private:
+    static constexpr uint32_t NOT_LIVE = 0xFFFFFFFFu;
+
+    // Live projectiles, packed at the front.
+    std::vector<float> mPosX, mPosY;                  // Centre of each projectile.
+    std::vector<float> mPrevX, mPrevY;                // Centre before the last Move, for interpolation.
+    std::vector<float> mVelX, mVelY;                  // Pixels per second.
+    std::vector<float> mHalfW, mHalfH;                // Half extents of each projectile's collider.
+    std::vector<float> mLeft, mTop, mRight, mBottom;  // Collider edges, rebuilt by Move.
+    std::vector<uint8_t> mType;                       // What fired each projectile.
+    std::vector<uint32_t> mLiveToSlot;                // Slot each live projectile belongs to.
+    size_t mLiveCount = 0;
+
+    // Slots, what handles refer to.
+    std::vector<uint32_t> mGenerations;  // Current generation of each slot.
+    std::vector<uint32_t> mSlotToLive;   // Position of each slot in the live list, NOT_LIVE when free.
+    std::vector<uint32_t> mFree;         // Free slots, used as a stack.
+
+    size_t mTypeCounts[TYPE_COUNT] = {};  // Live projectiles of each type.
+};
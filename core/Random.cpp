@@ -0,0 +1,62 @@
+#include "Random.h"
+
+#include <cassert>
+
+
+// Hash function: SplitMix64 jumped straight to the counter'th output, keeping the top 32 bits.
+uint32_t RandomStream::Hash(uint64_t key, uint64_t counter)
+{
+	uint64_t z = key + (counter + 1) * 0x9E3779B97F4A7C15ull;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	z ^= z >> 31;
+	return (uint32_t)(z >> 32);
+}
+
+// Range function: How many integers [min, max] holds, 0 stands for all 2^32 of them.
+uint32_t RandomStream::Range(int min, int max)
+{
+	assert(max >= min);
+	return (uint32_t)((int64_t)max - (int64_t)min + 1);
+}
+
+// FillInts function: Every roll is its own hash so the loop has no chain through the counter.
+void RandomStream::FillInts(int min, int max, int* out, size_t count)
+{
+	uint32_t range = Range(min, max);
+	for (size_t i = 0; i < count; i++)
+		out[i] = min + (int)Reduce(Hash(mKey, mCounter + i), range);
+
+	mCounter += count;
+}
+
+// Seed function: Mixes the seed with an FNV-1a hash of each stream's name.
+void SimRandom::Seed(unsigned int seed)
+{
+	for (int s = 0; s < STREAM_COUNT; s++)
+	{
+		uint64_t nameHash = 14695981039346656037ull;
+		for (const char* c = GetStreamName((Stream)s); *c; c++)
+			nameHash = (nameHash ^ (uint8_t)*c) * 1099511628211ull;
+
+		uint64_t key = ((uint64_t)RandomStream::Hash(seed, nameHash) << 32) | RandomStream::Hash(nameHash, seed);
+		mStreams[s] = RandomStream(key);
+	}
+}
+
+// GetStreamName function: Names are part of the keys, renaming a stream changes what it rolls.
+const char* SimRandom::GetStreamName(Stream _stream)
+{
+	switch (_stream)
+	{
+	case STREAM_SHOOT:
+		return "shoot";
+	case STREAM_UFO:
+		return "ufo";
+	case STREAM_POINTS:
+		return "points";
+	default:
+		assert(false);
+		return "";
+	}
+}
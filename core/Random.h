@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+
+// RandomStream class: A counter based random number generator.
+// Roll n of a stream is a hash of the stream's key and n (the SplitMix64 finaliser),
+// so a stream is only two integers, the same key and counter give the same roll on
+// every platform, and the rolls of a batch don't depend on each other.
+class RandomStream
+{
+public:
+    explicit RandomStream(uint64_t key = 0) : mKey(key) {}
+
+    // Next function: The next 32 random bits.
+    uint32_t Next() { return Hash(mKey, mCounter++); }
+
+    // Int function: Random integer in the inclusive range [min, max].
+    int Int(int min, int max) { return min + (int)Reduce(Next(), Range(min, max)); }
+
+    // FillInts function: Rolls count integers in [min, max] at once, the same ones count calls to Int would give.
+    void FillInts(int min, int max, int* out, size_t count);
+
+    // Counter: How many rolls the stream has made, seeking back replays them.
+    uint64_t GetCounter() const { return mCounter; }
+    void Seek(uint64_t counter) { mCounter = counter; }
+
+    uint64_t GetKey() const { return mKey; }
+
+    // Hash function: The roll at a counter of a stream with the given key.
+    static uint32_t Hash(uint64_t key, uint64_t counter);
+
+private:
+    static uint32_t Range(int min, int max);
+    static uint32_t Reduce(uint32_t bits, uint32_t range) { return range ? (uint32_t)(((uint64_t)bits * range) >> 32) : bits; }
+
+    uint64_t mKey;
+    uint64_t mCounter = 0;
+};
+
+// SimRandom class: The simulation's random numbers, one stream per thing that rolls dice.
+// Each stream's key comes from the game's seed and the stream's name, so rolling more
+// often in one part of the game (or adding a new stream) never changes what another part rolls.
+class SimRandom
+{
+public:
+    enum Stream
+    {
+        STREAM_SHOOT,   // Whether a squid fires when its timer is up.
+        STREAM_UFO,     // Whether the ufo comes out on a downstep.
+        STREAM_POINTS,  // Points for shooting the ufo.
+        STREAM_COUNT
+    };
+
+    explicit SimRandom(unsigned int seed = 0) { Seed(seed); }
+
+    // Seed function: Restarts every stream from a new seed.
+    void Seed(unsigned int seed);
+
+    RandomStream& Get(Stream _stream) { return mStreams[_stream]; }
+    const RandomStream& Get(Stream _stream) const { return mStreams[_stream]; }
+
+    static const char* GetStreamName(Stream _stream);
+
+private:
+    RandomStream mStreams[STREAM_COUNT];
+};
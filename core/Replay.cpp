@@ -0,0 +1,374 @@
+#include "Replay.h"
+
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+
+// Run flags, the fire button plus which values differ from the previous run.
+static const uint8_t RUN_FIRE = 1 << 0;
+static const uint8_t RUN_MOVE = 1 << 1;
+static const uint8_t RUN_TIME = 1 << 2;
+
+// VisitConfig function: Calls fn on every field of the config in file order.
+// Writing, reading and hashing all go through here so they can never disagree.
+template<class C, class Fn>
+static void VisitConfig(C& c, Fn&& fn)
+{
+	fn(c.mScreenWidth);
+	fn(c.mScreenHeight);
+	fn(c.mPlayerLifes);
+	fn(c.mEnemiesPerRow);
+	fn(c.mNumOfRows);
+	fn(c.mRowXSpacing);
+	fn(c.mRowYSpacing);
+	fn(c.mEnemyInitialY);
+	fn(c.mUfoInitialY);
+	fn(c.mEnemyDownstep);
+	fn(c.mEnemyLimitOffset);
+	fn(c.mGridCellSize);
+	fn(c.mProjectileCapacity);
+	fn(c.mBulletHellProjectiles);
+
+	for (auto* v : { &c.mPlayerSize, &c.mMissileSize, &c.mLaserSize, &c.mOctopusSize,
+		&c.mCrabSize, &c.mSquidSize, &c.mUfoSize, &c.mShelterSize })
+	{
+		fn(v->x);
+		fn(v->y);
+	}
+}
+
+static uint32_t FloatBits(float f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+static float BitsFloat(uint32_t bits)
+{
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+static uint64_t ZigZag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+static int64_t UnZigZag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+// HashConfig function: Ints are hashed by value and floats by bit pattern.
+uint64_t Replay::HashConfig(const SimConfig& config)
+{
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&hash](uint32_t v)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				hash ^= (v >> (i * 8)) & 0xFF;
+				hash *= 1099511628211ull;
+			}
+		};
+
+	VisitConfig(config, [&mix](const auto& field)
+		{
+			if constexpr (std::is_same<std::decay_t<decltype(field)>, float>::value)
+				mix(FloatBits(field));
+			else
+				mix((uint32_t)field);
+		});
+
+	return hash;
+}
+
+
+// Open function: Writes the header straight away so a crashed game still leaves a readable start.
+bool ReplayWriter::Open(const char* path, unsigned int seed, const SimConfig& config)
+{
+	Close(0, 0);
+
+	mpFile = fopen(path, "wb");
+	if (!mpFile)
+		return false;
+
+	mBufferUsed = 0;
+	mRunLength = 0;
+	mPrevMoveBits = mPrevTimeBits = 0;
+
+	PutVarint(Replay::MAGIC);
+	PutVarint(Replay::VERSION);
+	PutVarint(seed);
+	PutVarint(Replay::HashConfig(config));
+
+	uint32_t prevBits = 0;
+	VisitConfig(config, [this, &prevBits](const auto& field)
+		{
+			if constexpr (std::is_same<std::decay_t<decltype(field)>, float>::value)
+				PutFloatDelta(field, prevBits);
+			else
+				PutInt(field);
+		});
+
+	return true;
+}
+
+// Record function: Extends the pending run while the input stays the same, otherwise starts a new one.
+void ReplayWriter::Record(const SimInput& input, float dTime)
+{
+	if (!mpFile)
+		return;
+
+	// Compare bit patterns so -0.0f and NaNs are kept exactly
+	if (mRunLength > 0 && input.mFire == mRunInput.mFire &&
+		FloatBits(input.mMoveX) == FloatBits(mRunInput.mMoveX) && FloatBits(dTime) == FloatBits(mRunTime))
+	{
+		mRunLength++;
+		return;
+	}
+
+	FlushRun();
+	mRunInput = input;
+	mRunTime = dTime;
+	mRunLength = 1;
+}
+
+// Close function: Flushes the last run, writes the end marker and trailer.
+void ReplayWriter::Close(unsigned int ticks, int score)
+{
+	if (!mpFile)
+		return;
+
+	FlushRun();
+	PutVarint(0);
+	PutVarint(ticks);
+	PutInt(score);
+	FlushBuffer();
+
+	fclose(mpFile);
+	mpFile = nullptr;
+}
+
+// FlushRun function: Writes the run length, flags and whichever values changed since the last run.
+void ReplayWriter::FlushRun()
+{
+	if (mRunLength == 0)
+		return;
+
+	uint32_t moveBits = FloatBits(mRunInput.mMoveX);
+	uint32_t timeBits = FloatBits(mRunTime);
+
+	uint8_t flags = mRunInput.mFire ? RUN_FIRE : 0;
+	if (moveBits != mPrevMoveBits)
+		flags |= RUN_MOVE;
+	if (timeBits != mPrevTimeBits)
+		flags |= RUN_TIME;
+
+	PutVarint(mRunLength);
+	PutByte(flags);
+	if (flags & RUN_MOVE)
+		PutFloatDelta(mRunInput.mMoveX, mPrevMoveBits);
+	if (flags & RUN_TIME)
+		PutFloatDelta(mRunTime, mPrevTimeBits);
+
+	mRunLength = 0;
+}
+
+void ReplayWriter::FlushBuffer()
+{
+	if (mBufferUsed > 0)
+		fwrite(mBuffer, 1, mBufferUsed, mpFile);
+	mBufferUsed = 0;
+}
+
+void ReplayWriter::PutByte(uint8_t b)
+{
+	if (mBufferUsed == sizeof(mBuffer))
+		FlushBuffer();
+	mBuffer[mBufferUsed++] = b;
+}
+
+// PutVarint function: Seven bits at a time, the top bit says another byte follows.
+void ReplayWriter::PutVarint(uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		PutByte((uint8_t)(v | 0x80));
+		v >>= 7;
+	}
+	PutByte((uint8_t)v);
+}
+
+void ReplayWriter::PutInt(int64_t v)
+{
+	PutVarint(ZigZag(v));
+}
+
+void ReplayWriter::PutFloatDelta(float v, uint32_t& prevBits)
+{
+	uint32_t bits = FloatBits(v);
+	PutInt((int32_t)(bits - prevBits));
+	prevBits = bits;
+}
+
+
+// Open function: Checks the magic and version then reads the seed and config.
+bool ReplayReader::Open(const char* path)
+{
+	Close();
+
+	mpFile = fopen(path, "rb");
+	if (!mpFile)
+		return false;
+
+	mBufferUsed = mBufferRead = 0;
+	mRunInput = SimInput();
+	mRunTime = 0.0f;
+	mRunLeft = 0;
+	mPrevMoveBits = mPrevTimeBits = 0;
+	mEnded = false;
+	mComplete = false;
+	mFinalTicks = 0;
+	mFinalScore = 0;
+
+	uint64_t magic = 0, version = 0, seed = 0;
+	if (!GetVarint(magic) || magic != Replay::MAGIC || !GetVarint(version) || version != Replay::VERSION ||
+		!GetVarint(seed) || !GetVarint(mConfigHash))
+	{
+		Close();
+		return false;
+	}
+	mSeed = (unsigned int)seed;
+
+	bool ok = true;
+	uint32_t prevBits = 0;
+	VisitConfig(mConfig, [this, &ok, &prevBits](auto& field)
+		{
+			if constexpr (std::is_same<std::decay_t<decltype(field)>, float>::value)
+				ok = ok && GetFloatDelta(field, prevBits);
+			else
+			{
+				int64_t v = 0;
+				ok = ok && GetInt(v);
+				field = (int)v;
+			}
+		});
+
+	// The hash doubles as a checksum of the header
+	if (!ok || Replay::HashConfig(mConfig) != mConfigHash)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+// Next function: Hands out the current run a tick at a time, reading the next run when it runs out.
+bool ReplayReader::Next(SimInput& input, float& dTime)
+{
+	if (mRunLeft == 0 && !ReadRun())
+		return false;
+
+	mRunLeft--;
+	input = mRunInput;
+	dTime = mRunTime;
+	return true;
+}
+
+void ReplayReader::Close()
+{
+	if (mpFile)
+		fclose(mpFile);
+	mpFile = nullptr;
+}
+
+// ReadRun function: Reads a run header, or the trailer once the end marker is reached.
+bool ReplayReader::ReadRun()
+{
+	if (mEnded || !mpFile)
+		return false;
+
+	uint64_t length = 0;
+	uint8_t flags = 0;
+	if (!GetVarint(length))
+	{
+		mEnded = true;  // Truncated, the game must have crashed before the replay was closed
+		return false;
+	}
+
+	if (length == 0)
+	{
+		uint64_t ticks = 0;
+		int64_t score = 0;
+		if (GetVarint(ticks) && GetInt(score))
+		{
+			mFinalTicks = (unsigned int)ticks;
+			mFinalScore = (int)score;
+			mComplete = true;
+		}
+		mEnded = true;
+		return false;
+	}
+
+	if (!GetByte(flags) ||
+		((flags & RUN_MOVE) && !GetFloatDelta(mRunInput.mMoveX, mPrevMoveBits)) ||
+		((flags & RUN_TIME) && !GetFloatDelta(mRunTime, mPrevTimeBits)))
+	{
+		mEnded = true;
+		return false;
+	}
+
+	mRunInput.mFire = (flags & RUN_FIRE) != 0;
+	mRunLeft = (uint32_t)length;
+	return true;
+}
+
+bool ReplayReader::GetByte(uint8_t& b)
+{
+	if (mBufferRead == mBufferUsed)
+	{
+		mBufferUsed = fread(mBuffer, 1, sizeof(mBuffer), mpFile);
+		mBufferRead = 0;
+		if (mBufferUsed == 0)
+			return false;
+	}
+
+	b = mBuffer[mBufferRead++];
+	return true;
+}
+
+bool ReplayReader::GetVarint(uint64_t& v)
+{
+	v = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t b;
+		if (!GetByte(b))
+			return false;
+
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if (!(b & 0x80))
+			return true;
+	}
+
+	return false;  // Too long to be a varint we wrote
+}
+
+bool ReplayReader::GetInt(int64_t& v)
+{
+	uint64_t u;
+	if (!GetVarint(u))
+		return false;
+
+	v = UnZigZag(u);
+	return true;
+}
+
+bool ReplayReader::GetFloatDelta(float& v, uint32_t& prevBits)
+{
+	int64_t delta;
+	if (!GetInt(delta))
+		return false;
+
+	prevBits += (uint32_t)delta;
+	v = BitsFloat(prevBits);
+	return true;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#include "SimConfig.h"
+#include "SimTypes.h"
+
+
+// Replay format: Everything needed to play a game back bit for bit.
+//
+//   header   magic "IARP", version, seed, config hash, every SimConfig field
+//   runs     varint tick count, flags byte, then only the fields the flags say changed
+//   end      a run of 0 ticks
+//   trailer  ticks stepped and final score, so a replay can check it ended the same way
+//
+// Ints are zigzag varints, floats are stored as the zigzag varint of the difference of
+// their bit patterns from the last value, so a held stick or a steady frame time costs
+// nothing and a run of identical ticks costs a couple of bytes however long it is.
+namespace Replay
+{
+    static const uint32_t MAGIC = 0x50524149;  // "IARP" little endian.
+    static const uint32_t VERSION = 2;  // 2: Rolls come from SimRandom's streams.
+
+    // HashConfig function: FNV-1a of every config field, tells whether a replay was recorded with the current scripts.
+    uint64_t HashConfig(const SimConfig& config);
+}
+
+// ReplayWriter class: Streams a game's input to a file as it is played.
+// Output goes through a fixed buffer so recording a tick never allocates.
+class ReplayWriter
+{
+public:
+    ~ReplayWriter() { Close(0, 0); }
+
+    // Open function: Starts a new replay, returns false if the file can't be created.
+    bool Open(const char* path, unsigned int seed, const SimConfig& config);
+
+    // Record function: Adds a tick, call with the same input and delta time passed to Simulation::Step.
+    void Record(const SimInput& input, float dTime);
+
+    // Close function: Writes the trailer with how the game ended and closes the file.
+    void Close(unsigned int ticks, int score);
+
+    bool IsOpen() const { return mpFile != nullptr; }
+
+private:
+    void FlushRun();      // Writes the pending run of identical ticks.
+    void FlushBuffer();   // Writes the buffer out to the file.
+    void PutByte(uint8_t b);
+    void PutVarint(uint64_t v);
+    void PutInt(int64_t v);                             // Zigzag varint.
+    void PutFloatDelta(float v, uint32_t& prevBits);    // Varint of the bit pattern difference.
+
+    FILE* mpFile = nullptr;
+    uint8_t mBuffer[4096];
+    size_t mBufferUsed = 0;
+
+    SimInput mRunInput;         // Input of the pending run.
+    float mRunTime = 0.0f;      // Delta time of the pending run.
+    uint32_t mRunLength = 0;    // Ticks in the pending run.
+    uint32_t mPrevMoveBits = 0; // Last written values the deltas are taken from.
+    uint32_t mPrevTimeBits = 0;
+};
+
+// ReplayReader class: Streams a replay back one tick at a time.
+// Input comes through a fixed buffer so reading a tick never allocates.
+class ReplayReader
+{
+public:
+    ~ReplayReader() { Close(); }
+
+    // Open function: Reads the header, returns false if the file is missing, corrupt or from another version.
+    bool Open(const char* path);
+
+    // Next function: Gets the next tick's input and delta time, false once the replay has ended.
+    bool Next(SimInput& input, float& dTime);
+
+    void Close();
+
+    unsigned int GetSeed() const { return mSeed; }
+    const SimConfig& GetConfig() const { return mConfig; }
+    uint64_t GetConfigHash() const { return mConfigHash; }
+
+    // How the recorded game ended, only valid once Next has returned false.
+    // A replay from a game that crashed before closing it has no ending, IsComplete is false.
+    bool IsComplete() const { return mComplete; }
+    unsigned int GetFinalTicks() const { return mFinalTicks; }
+    int GetFinalScore() const { return mFinalScore; }
+
+private:
+    bool GetByte(uint8_t& b);
+    bool GetVarint(uint64_t& v);
+    bool GetInt(int64_t& v);
+    bool GetFloatDelta(float& v, uint32_t& prevBits);
+    bool ReadRun();  // Reads the next run header, false at the end marker or on a truncated file.
+
+    FILE* mpFile = nullptr;
+    uint8_t mBuffer[4096];
+    size_t mBufferUsed = 0;
+    size_t mBufferRead = 0;
+
+    unsigned int mSeed = 0;
+    SimConfig mConfig;
+    uint64_t mConfigHash = 0;
+
+    SimInput mRunInput;
+    float mRunTime = 0.0f;
+    uint32_t mRunLeft = 0;
+    uint32_t mPrevMoveBits = 0;
+    uint32_t mPrevTimeBits = 0;
+    bool mEnded = false;
+    bool mComplete = false;
+
+    unsigned int mFinalTicks = 0;
+    int mFinalScore = 0;
+};
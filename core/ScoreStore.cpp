@@ -0,0 +1,456 @@
+#include "ScoreStore.h"
+#include "MappedFile.h"
+#include "Random.h"
+#include "SimdConfig.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <filesystem>
+#include <chrono>
+#include <random>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+// CheckRecord function: FNV-1a of every byte of the record but the check itself.
+static uint32_t CheckRecord(const ScoreRecord& record)
+{
+	ScoreRecord copy = record;
+	copy.mCheck = 0;
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(&copy);
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < sizeof(copy); i++)
+		hash = (hash ^ p[i]) * 16777619u;
+	return hash;
+}
+
+// MakeRecord function: Fills in a record, check included, ready to be written.
+static ScoreRecord MakeRecord(uint32_t id, int points, const string& name)
+{
+	ScoreRecord record;
+	record.mPoints = points;
+	record.mId = id;
+	record.SetName(name);
+	record.mCheck = CheckRecord(record);
+	return record;
+}
+
+// WriteRecords function: Writes records encrypted, a block at a time so a big file doesn't need a second copy.
+static bool WriteRecords(FILE* pFile, const ScoreRecord* records, size_t count, const string& key)
+{
+	ScoreRecord block[256];
+	while (count > 0)
+	{
+		size_t n = min(count, size(block));
+		memcpy(block, records, n * sizeof(ScoreRecord));
+		ScoreFile::CryptRecords(block, n, key);
+
+		if (fwrite(block, sizeof(ScoreRecord), n, pFile) != n)
+			return false;
+		records += n;
+		count -= n;
+	}
+	return true;
+}
+
+// SyncFile function: Pushes everything written to the file out of the OS's cache onto the disk.
+bool ScoreFile::SyncFile(FILE* pFile)
+{
+	if (fflush(pFile) != 0)
+		return false;
+#ifdef _WIN32
+	return _commit(_fileno(pFile)) == 0;
+#else
+	return fsync(fileno(pFile)) == 0;
+#endif
+}
+
+// SyncDirectory function: Makes a file just created or renamed in the directory survive a crash.
+// Windows has nothing to sync, NTFS journals the directory itself.
+void ScoreFile::SyncDirectory(const string& path)
+{
+#ifndef _WIN32
+	string dir = filesystem::path(path).parent_path().string();
+	int fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		fsync(fd);
+		close(fd);
+	}
+#else
+	(void)path;
+#endif
+}
+
+// WriteHeader function: The file header, always HEADER_SIZE bytes.
+static bool WriteHeader(FILE* pFile, uint32_t nonce)
+{
+	const uint32_t header[4] = { ScoreFile::MAGIC, ScoreFile::VERSION, (uint32_t)sizeof(ScoreRecord), nonce };
+	static_assert(sizeof(header) == ScoreFile::HEADER_SIZE, "header size");
+	return fwrite(header, sizeof(header), 1, pFile) == 1;
+}
+
+// SetName function: Names longer than the record holds are cut short.
+void ScoreRecord::SetName(const string& name)
+{
+	mNameLength = (uint8_t)min(name.size(), NAME_SIZE);
+	memset(mName, 0, sizeof(mName));
+	memcpy(mName, name.data(), mNameLength);
+}
+
+// Crypt function: The key is repeated out a vector past its end, so a full vector of it can be
+// loaded from wherever the data has got to in the key. Each step moves that point on by a vector.
+void ScoreFile::Crypt(void* data, size_t size, const string& key, size_t keyOffset)
+{
+#if defined(IA_SIMD_AVX) || defined(IA_SIMD_SSE)
+#if defined(IA_SIMD_AVX)
+	const size_t width = 32;
+#else
+	const size_t width = 16;
+#endif
+	// Building the pattern costs more than it saves on a record or two
+	if (key.empty() || size < width * 8)
+	{
+		CryptScalar(data, size, key, keyOffset);
+		return;
+	}
+
+	string pattern;
+	pattern.reserve(key.size() + width * 2);
+	while (pattern.size() < key.size() + width)
+		pattern += key;
+
+	unsigned char* p = static_cast<unsigned char*>(data);
+	const char* k = pattern.data();
+	size_t offset = keyOffset % key.size();
+	size_t step = width % key.size();
+	size_t i = 0;
+	for (; i + width <= size; i += width)
+	{
+#if defined(IA_SIMD_AVX)
+		// AVX without AVX2 only has the float XOR, it's the same bits
+		__m256 v = _mm256_xor_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(p + i)),
+			_mm256_loadu_ps(reinterpret_cast<const float*>(k + offset)));
+		_mm256_storeu_ps(reinterpret_cast<float*>(p + i), v);
+#else
+		__m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(k + offset)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), v);
+#endif
+		offset += step;
+		if (offset >= key.size())
+			offset -= key.size();
+	}
+	CryptScalar(p + i, size - i, key, offset);
+#else
+	CryptScalar(data, size, key, keyOffset);
+#endif
+}
+
+// CryptScalar function: Simple XOR, the same the scores have always had.
+void ScoreFile::CryptScalar(void* data, size_t size, const string& key, size_t keyOffset)
+{
+	if (key.empty())
+		return;
+
+	unsigned char* p = static_cast<unsigned char*>(data);
+	size_t k = keyOffset % key.size();
+	for (size_t i = 0; i < size; i++)
+	{
+		p[i] ^= (unsigned char)key[k];
+		if (++k == key.size())
+			k = 0;
+	}
+}
+
+// CryptRecords function: Every record starts the key again, so they're all XORed with the same 32 bytes.
+void ScoreFile::CryptRecords(ScoreRecord* records, size_t count, const string& key)
+{
+	if (key.empty() || count == 0)
+		return;
+
+	alignas(32) unsigned char mask[sizeof(ScoreRecord)] = {};
+	CryptScalar(mask, sizeof(mask), key);
+
+#if defined(IA_SIMD_AVX)
+	const __m256 m = _mm256_load_ps(reinterpret_cast<const float*>(mask));
+	for (size_t i = 0; i < count; i++)
+	{
+		float* p = reinterpret_cast<float*>(&records[i]);
+		_mm256_storeu_ps(p, _mm256_xor_ps(_mm256_loadu_ps(p), m));
+	}
+#elif defined(IA_SIMD_SSE)
+	const __m128i m0 = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+	const __m128i m1 = _mm_load_si128(reinterpret_cast<const __m128i*>(mask + 16));
+	for (size_t i = 0; i < count; i++)
+	{
+		__m128i* p = reinterpret_cast<__m128i*>(&records[i]);
+		_mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), m0));
+		_mm_storeu_si128(p + 1, _mm_xor_si128(_mm_loadu_si128(p + 1), m1));
+	}
+#else
+	for (size_t i = 0; i < count; i++)
+	{
+		unsigned char* p = reinterpret_cast<unsigned char*>(&records[i]);
+		for (size_t b = 0; b < sizeof(ScoreRecord); b++)
+			p[b] ^= mask[b];
+	}
+#endif
+}
+
+// ReadLegacy function: Entries are "id,points,name;", ids are ignored as they were only ever the rank.
+bool ScoreFile::ReadLegacy(const char* data, size_t size, const string& key, vector<ScoreRecord>& out)
+{
+	string text(data, size);
+	Crypt(&text[0], text.size(), key);
+
+	size_t pos = 0;
+	while (pos < text.size())
+	{
+		size_t end = text.find(';', pos);
+		if (end == string::npos)
+			return false;
+
+		size_t comma1 = text.find(',', pos);
+		size_t comma2 = comma1 == string::npos ? string::npos : text.find(',', comma1 + 1);
+		if (comma2 == string::npos || comma2 > end)
+			return false;
+
+		char* parsedEnd = nullptr;
+		long points = strtol(text.c_str() + comma1 + 1, &parsedEnd, 10);
+		if (parsedEnd != text.c_str() + comma2)
+			return false;
+
+		out.push_back(MakeRecord((uint32_t)out.size(), (int)points, text.substr(comma2 + 1, end - comma2 - 1)));
+		pos = end + 1;
+	}
+	return true;
+}
+
+// Decode function: The records are decoded straight out of the data, nothing is parsed.
+ScoreFile::Format ScoreFile::Decode(const char* data, size_t size, const string& key, vector<ScoreRecord>& out, bool& damaged,
+	uint32_t* pNonce)
+{
+	damaged = false;
+	if (pNonce)
+		*pNonce = 0;
+	size_t first = out.size();
+
+	uint32_t header[4] = {};
+	if (size >= HEADER_SIZE)
+		memcpy(header, data, sizeof(header));
+
+	if (header[0] == MAGIC)
+	{
+		if (header[1] != VERSION || header[2] != sizeof(ScoreRecord))
+			return FORMAT_UNKNOWN;
+		if (pNonce)
+			*pNonce = header[3];
+
+		size_t count = (size - HEADER_SIZE) / sizeof(ScoreRecord);
+		damaged = HEADER_SIZE + count * sizeof(ScoreRecord) != size;  // Torn append
+
+		out.resize(first + count);
+		memcpy(out.data() + first, data + HEADER_SIZE, count * sizeof(ScoreRecord));
+		CryptRecords(out.data() + first, count, key);
+
+		// Drop anything damaged or edited by hand
+		auto bad = remove_if(out.begin() + first, out.end(), [](const ScoreRecord& r) {
+			return r.mCheck != CheckRecord(r) || r.mNameLength > ScoreRecord::NAME_SIZE;
+			});
+		damaged |= bad != out.end();
+		out.erase(bad, out.end());
+		return FORMAT_RECORDS;
+	}
+
+	if (size == 0 || ReadLegacy(data, size, key, out))
+		return FORMAT_LEGACY;
+
+	out.resize(first);  // Drop whatever was parsed before it went wrong
+	return FORMAT_UNKNOWN;
+}
+
+// Load function: Damaged records are dropped quietly, there's no file of the game's to repair.
+bool ScoreFile::Load(const string& path, const string& key, vector<ScoreRecord>& out, Format* pFormat)
+{
+	MappedFile file(path);
+	if (!file.IsOk())
+		return false;
+
+	bool damaged;
+	Format format = Decode(file.GetData(), file.GetSize(), key, out, damaged);
+	if (pFormat)
+		*pFormat = format;
+	return format != FORMAT_UNKNOWN;
+}
+
+// Save function: Legacy files are written the way ScoreSystem used to, best first with the rank as the id.
+bool ScoreFile::Save(const string& path, const vector<ScoreRecord>& records, const string& key, Format format)
+{
+	FILE* pFile = fopen(path.c_str(), "wb");
+	if (!pFile)
+		return false;
+
+	bool ok = false;
+	if (format == FORMAT_RECORDS)
+	{
+		vector<ScoreRecord> sealed = records;
+		for (ScoreRecord& record : sealed)
+			record.mCheck = CheckRecord(record);
+		ok = WriteHeader(pFile, 0) && WriteRecords(pFile, sealed.data(), sealed.size(), key);
+	}
+	else if (format == FORMAT_LEGACY)
+	{
+		vector<const ScoreRecord*> ranked(records.size());
+		for (size_t i = 0; i < records.size(); i++)
+			ranked[i] = &records[i];
+		stable_sort(ranked.begin(), ranked.end(), [](const ScoreRecord* a, const ScoreRecord* b) { return a->mPoints > b->mPoints; });
+
+		string text;
+		text.reserve(records.size() * 24);
+		for (size_t i = 0; i < ranked.size(); i++)
+		{
+			text += to_string(i);
+			text += ',';
+			text += to_string(ranked[i]->mPoints);
+			text += ',';
+			text += ranked[i]->GetName();
+			text += ';';
+		}
+		Crypt(&text[0], text.size(), key);
+		ok = fwrite(text.data(), 1, text.size(), pFile) == text.size();
+	}
+
+	ok = fclose(pFile) == 0 && ok;
+	return ok;
+}
+
+// NewNonce function: Random, and different for files created in the same second on the same machine.
+uint32_t ScoreStore::NewNonce()
+{
+	static uint64_t count = 0;
+	random_device device;
+	uint64_t seed = ((uint64_t)device() << 32) ^ device() ^ (uint64_t)chrono::steady_clock::now().time_since_epoch().count();
+	uint32_t nonce = RandomStream::Hash(seed, count++);
+	return nonce != 0 ? nonce : 1;
+}
+
+// Open function: A legacy or damaged file, or one without a nonce, is rewritten as soon as it's read.
+bool ScoreStore::Open(const string& path, const string& key)
+{
+	mPath = path;
+	mKey = key;
+	mRecords.clear();
+	mNextId = 0;
+
+	bool needsRewrite = false;
+	{
+		MappedFile file(path);
+		if (!file.Exists())
+		{
+			mNonce = NewNonce();
+			return true;  // Nothing saved yet, the first Append creates it
+		}
+		if (!file.IsOk())
+			return false;
+
+		bool damaged;
+		ScoreFile::Format format = ScoreFile::Decode(file.GetData(), file.GetSize(), key, mRecords, damaged, &mNonce);
+		if (format == ScoreFile::FORMAT_UNKNOWN)
+			return false;
+		needsRewrite = damaged || format == ScoreFile::FORMAT_LEGACY || mNonce == 0;
+		if (mNonce == 0)
+			mNonce = NewNonce();
+	}
+
+	for (const ScoreRecord& record : mRecords)
+		mNextId = max(mNextId, record.mId + 1);
+
+	return !needsRewrite || Rewrite();
+}
+
+// Append function: Writes the header too if this is the first score in the file.
+bool ScoreStore::Append(const vector<NewScore>& scores)
+{
+	if (scores.empty())
+		return true;
+
+	FILE* pFile = fopen(mPath.c_str(), "ab");
+	if (!pFile)
+		return false;
+
+	vector<ScoreRecord> records;
+	records.reserve(scores.size());
+	for (const NewScore& score : scores)
+		records.push_back(MakeRecord(mNextId + (uint32_t)records.size(), score.mPoints, score.mName));
+
+	long start = fseek(pFile, 0, SEEK_END) == 0 ? ftell(pFile) : -1;
+	bool ok = start >= 0 && (start > 0 || WriteHeader(pFile, mNonce)) &&
+		WriteRecords(pFile, records.data(), records.size(), mKey) && ScoreFile::SyncFile(pFile);
+	ok = fclose(pFile) == 0 && ok;
+	if (start == 0)
+		ScoreFile::SyncDirectory(mPath);
+
+	if (ok)
+	{
+		mRecords.insert(mRecords.end(), records.begin(), records.end());
+		mNextId += (uint32_t)records.size();
+	}
+	else if (start >= 0)
+	{
+		// Cut off whatever part did get written so the next append lines up with the records
+		error_code ec;
+		filesystem::resize_file(mPath, (uintmax_t)start, ec);
+	}
+	return ok;
+}
+
+// Compact function: Ties keep the score that was saved first.
+bool ScoreStore::Compact(size_t keep)
+{
+	if (keep > 0 && mRecords.size() > keep)
+	{
+		nth_element(mRecords.begin(), mRecords.begin() + keep, mRecords.end(), [](const ScoreRecord& a, const ScoreRecord& b) {
+			return a.mPoints != b.mPoints ? a.mPoints > b.mPoints : a.mId < b.mId;
+			});
+		mRecords.resize(keep);
+
+		// Back in the order they were saved
+		sort(mRecords.begin(), mRecords.end(), [](const ScoreRecord& a, const ScoreRecord& b) { return a.mId < b.mId; });
+	}
+	return Rewrite();
+}
+
+// Rewrite function: Written and synced to a temporary file first so a crash can't leave half a table behind.
+bool ScoreStore::Rewrite()
+{
+	string tempPath = mPath + ".tmp";
+	FILE* pFile = fopen(tempPath.c_str(), "wb");
+	if (!pFile)
+		return false;
+
+	bool ok = WriteHeader(pFile, mNonce) && WriteRecords(pFile, mRecords.data(), mRecords.size(), mKey) && ScoreFile::SyncFile(pFile);
+	ok = fclose(pFile) == 0 && ok;
+
+	error_code ec;
+	if (ok)
+	{
+		filesystem::rename(tempPath, mPath, ec);
+		ok = !ec;
+	}
+	if (ok)
+		ScoreFile::SyncDirectory(mPath);
+	if (!ok)
+		filesystem::remove(tempPath, ec);
+	return ok;
+}
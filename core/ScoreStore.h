@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+
+// ScoreRecord struct: One saved score exactly as it's laid out in the file.
+// Records are a fixed size so the file can be read straight out of a mapping and a new
+// score is always a single write at the end.
+struct ScoreRecord
+{
+    static constexpr size_t NAME_SIZE = 19;  // Longest name a record holds, the game allows 8.
+
+    int32_t mPoints = 0;
+    uint32_t mId = 0;        // Order the scores were saved in, never reused.
+    uint32_t mCheck = 0;     // Hash of the rest of the record, catches torn or edited records.
+    uint8_t mNameLength = 0;
+    char mName[NAME_SIZE] = {};
+
+    std::string GetName() const { return std::string(mName, mNameLength); }
+    void SetName(const std::string& name);
+};
+static_assert(sizeof(ScoreRecord) == 32, "score records are 32 bytes on disk");
+
+// Score file format:
+//
+//   header   magic "IASC", version, record size, nonce
+//   records  ScoreRecords in the order they were saved, XORed with the score key
+//
+// The nonce is a random number picked when the file is created, so a file that's deleted or
+// replaced (its ids starting again from 0) can be told apart from the one it replaced. Files
+// written before it was (where it's 0) are given one the next time a ScoreStore opens them.
+// New scores are appended, only compaction (or repairing a damaged file) rewrites it.
+// Files from before the format existed (the XORed "id,points,name;" text) are read and
+// rewritten in this format the first time they're opened.
+namespace ScoreFile
+{
+    static const uint32_t MAGIC = 0x43534149;  // "IASC" little endian.
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 16;
+
+    // Format enum: What a score file turned out to hold.
+    enum Format
+    {
+        FORMAT_UNKNOWN,  // Neither, or a newer version of the record format.
+        FORMAT_LEGACY,   // XORed "id,points,name;" text, an empty file counts as this.
+        FORMAT_RECORDS   // Header and ScoreRecords.
+    };
+
+    // Crypt function: XORs data with the key, starting keyOffset characters into it. Its own inverse.
+    // Uses the widest SIMD SimdConfig.h finds, a vector of the repeated key at a time.
+    void Crypt(void* data, size_t size, const std::string& key, size_t keyOffset = 0);
+
+    // CryptScalar function: Plain loop version of Crypt, used for short runs and for benchmarking.
+    void CryptScalar(void* data, size_t size, const std::string& key, size_t keyOffset = 0);
+
+    // CryptRecords function: Crypts each record on its own from the start of the key, as they're stored.
+    void CryptRecords(ScoreRecord* records, size_t count, const std::string& key);
+
+    // ReadLegacy function: Parses the old XORed text format, false if it isn't in that format.
+    bool ReadLegacy(const char* data, size_t size, const std::string& key, std::vector<ScoreRecord>& out);
+
+    // Decode function: Appends the scores in a file's contents, whichever format it's in, to out.
+    // Damaged records are dropped and damaged set, out is left as it was if the format isn't known.
+    // pNonce gets the file's nonce, 0 if it has none.
+    Format Decode(const char* data, size_t size, const std::string& key, std::vector<ScoreRecord>& out, bool& damaged,
+        uint32_t* pNonce = nullptr);
+
+    // Load function: Maps a file and decodes it, false if it's missing, unreadable or in no known format.
+    // The file itself is never changed, unlike ScoreStore::Open.
+    bool Load(const std::string& path, const std::string& key, std::vector<ScoreRecord>& out, Format* pFormat = nullptr);
+
+    // Save function: Writes records to a new file in either format, working out their checks again
+    // so they can have been edited. Legacy files are ranked, as the game used to save them, and lose
+    // the ids. The nonce is left 0 for the game to pick. Not synced, it's for files the game doesn't own.
+    bool Save(const std::string& path, const std::vector<ScoreRecord>& records, const std::string& key, Format format);
+
+    // SyncFile function: Flushes a file and syncs it to the disk, false if either fails.
+    bool SyncFile(FILE* pFile);
+
+    // SyncDirectory function: Makes a file just created in (or renamed into) a directory survive a crash.
+    void SyncDirectory(const std::string& path);
+}
+
+// ScoreStore class: The score file, with every score it holds kept in memory.
+// Open maps the file and decodes the records in place, Append writes new records to the
+// end, so saving costs the same however long the history gets. The file only grows
+// though, Compact rewrites it keeping the best scores. Writes are synced to the disk
+// before they return: a crash part way through an append leaves a torn record that the
+// next Open drops, and a rewrite goes through a temporary file that's renamed over the
+// old one, so it leaves either the old file or the new one.
+class ScoreStore
+{
+public:
+    // NewScore struct: A score to append, its id is given out by the store.
+    struct NewScore
+    {
+        int mPoints = 0;
+        std::string mName;
+    };
+
+    // Open function: Loads every score in the file, a missing file is an empty store.
+    // Old format files are converted and damaged ones (a torn last record) repaired.
+    // Returns false if the file exists but can't be read or rewritten.
+    bool Open(const std::string& path, const std::string& key);
+
+    // Append function: Saves new scores to the end of the file in one write, returns false
+    // if they can't be written, in which case none of them were given ids.
+    bool Append(const std::vector<NewScore>& scores);
+    bool Append(int points, const std::string& name) { return Append({ { points, name } }); }
+
+    // Compact function: Rewrites the file with only the keep best scores, 0 keeps them all.
+    bool Compact(size_t keep);
+
+    // Records in the order they were saved, not sorted.
+    const std::vector<ScoreRecord>& GetRecords() const { return mRecords; }
+    uint32_t GetNextId() const { return mNextId; }
+
+    // GetNonce function: The file's nonce, never 0. Ids only go up within one nonce, see the format above.
+    uint32_t GetNonce() const { return mNonce; }
+
+private:
+    static uint32_t NewNonce();
+    bool Rewrite();  // Writes mRecords out as a new file and swaps it in.
+
+    std::string mPath;
+    std::string mKey;
+    std::vector<ScoreRecord> mRecords;
+    uint32_t mNextId = 0;
+    uint32_t mNonce = 0;
+};
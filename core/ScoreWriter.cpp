@@ -0,0 +1,105 @@
+#include "ScoreWriter.h"
+
+#include <cassert>
+#include <chrono>
+
+using namespace std;
+
+
+// Start function: The store has to have been opened already.
+void ScoreWriter::Start(ScoreStore& store, BeforeAppend beforeAppend)
+{
+	assert(!mThread.joinable());
+	mpStore = &store;
+	mBeforeAppend = beforeAppend;
+	mStopping = false;
+	mFailing = false;
+	mThread = thread(&ScoreWriter::WriterLoop, this);
+}
+
+// Queue function: Only ever holds the lock long enough to add to the list.
+void ScoreWriter::Queue(int points, const string& name)
+{
+	{
+		lock_guard<mutex> lock(mMutex);
+		ScoreStore::NewScore score;
+		score.mPoints = points;
+		score.mName = name;
+		mQueue.push_back(score);
+		mQueued++;
+	}
+	mWake.notify_one();
+}
+
+// Flush function: Gives up while writes are failing rather than waiting out the retries.
+bool ScoreWriter::Flush()
+{
+	unique_lock<mutex> lock(mMutex);
+	if (!mThread.joinable())
+		return mWritten == mQueued;
+
+	size_t target = mQueued;
+	mDone.wait(lock, [&] { return mWritten >= target || mFailing; });
+	return mWritten >= target;
+}
+
+// Stop function: The thread only exits once the queue is empty, or a write made after stopping fails.
+void ScoreWriter::Stop()
+{
+	if (!mThread.joinable())
+		return;
+
+	{
+		lock_guard<mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mWake.notify_all();
+	mThread.join();
+
+	mStopping = false;
+	mpStore = nullptr;
+	mBeforeAppend = nullptr;
+}
+
+// WriterLoop function: Takes the whole queue at once so everything waiting goes out in one write.
+void ScoreWriter::WriterLoop()
+{
+	vector<ScoreStore::NewScore> batch;
+	unique_lock<mutex> lock(mMutex);
+	while (true)
+	{
+		mWake.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+		if (mQueue.empty())
+			break;  // Stopping with nothing left to write
+
+		batch.clear();
+		batch.swap(mQueue);
+		size_t writtenAfter = mWritten + batch.size();
+		lock.unlock();
+		bool ok = (!mBeforeAppend || mBeforeAppend(writtenAfter, mpStore->GetNextId() + (uint32_t)batch.size())) &&
+			mpStore->Append(batch);
+		lock.lock();
+
+		if (ok)
+		{
+			mWritten += batch.size();
+			mWrites++;
+			mFailing = false;
+		}
+		else
+		{
+			// Back on the front so the scores keep their order and ids
+			mQueue.insert(mQueue.begin(), batch.begin(), batch.end());
+			mFailures++;
+			mFailing = true;
+		}
+		mDone.notify_all();
+
+		if (!ok)
+		{
+			if (mStopping)
+				break;  // That was the last chance, the scores are lost
+			mWake.wait_for(lock, chrono::milliseconds(RETRY_MS), [this] { return mStopping; });
+		}
+	}
+}
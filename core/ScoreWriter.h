@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+#include "ScoreStore.h"
+
+
+// ScoreWriter class: Saves scores to a ScoreStore on a thread of its own.
+// Queue only adds the score to a list, so saving never waits on the disk. The thread
+// takes everything queued since its last write and appends it all in one synced write,
+// so a burst of scores costs one write. A write that fails is kept and tried again.
+// Stop (and the destructor) writes whatever is still queued before returning.
+class ScoreWriter
+{
+public:
+    ~ScoreWriter() { Stop(); }
+
+    // BeforeAppend: Called on the writer's thread before each append, with how many scores will
+    // have been written once it's done and the id the store will give the score after them.
+    // Returning false fails the append, which is tried again later like any other failure.
+    typedef std::function<bool(size_t writtenAfter, uint32_t nextIdAfter)> BeforeAppend;
+
+    // Start function: Starts the thread, nothing else may use the store until Stop.
+    void Start(ScoreStore& store, BeforeAppend beforeAppend = nullptr);
+
+    // Queue function: Adds a score to be written, returns straight away.
+    void Queue(int points, const std::string& name);
+
+    // Flush function: Blocks until every score queued so far is written, or writing is failing.
+    // Returns false if any queued scores are still unwritten.
+    bool Flush();
+
+    // Stop function: Flushes then stops the thread, the store is free to use again.
+    void Stop();
+
+    bool IsRunning() const { return mThread.joinable(); }
+
+    // Stats, read them while the writer is stopped.
+    unsigned int GetWrites() const { return mWrites; }        // Appends made, each of one or more scores.
+    unsigned int GetFailures() const { return mFailures; }    // Appends that failed and were retried.
+    size_t GetQueued() const { return mQueued; }              // Scores ever queued.
+
+private:
+    void WriterLoop();
+
+    static constexpr int RETRY_MS = 1000;  // Wait after a failed write before trying again.
+
+    ScoreStore* mpStore = nullptr;
+    BeforeAppend mBeforeAppend;
+    std::thread mThread;
+
+    std::mutex mMutex;
+    std::condition_variable mWake;  // Signalled when scores are queued or the writer stops.
+    std::condition_variable mDone;  // Signalled after every write attempt.
+    std::vector<ScoreStore::NewScore> mQueue;
+    size_t mQueued = 0;    // Scores ever queued.
+    size_t mWritten = 0;   // Scores ever written.
+    bool mStopping = false;
+    bool mFailing = false;  // Whether the last write failed.
+    unsigned int mWrites = 0;
+    unsigned int mFailures = 0;
+};
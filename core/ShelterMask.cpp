@@ -0,0 +1,211 @@
+#include "ShelterMask.h"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+// Bit helpers, the compilers spell these differently.
+static int PopCount(uint64_t w)
+{
+#if defined(_MSC_VER)
+	return (int)__popcnt64(w);
+#else
+	return __builtin_popcountll(w);
+#endif
+}
+
+static int LowestBit(uint64_t w)
+{
+#if defined(_MSC_VER)
+	unsigned long i;
+	_BitScanForward64(&i, w);
+	return (int)i;
+#else
+	return __builtin_ctzll(w);
+#endif
+}
+
+static int HighestBit(uint64_t w)
+{
+#if defined(_MSC_VER)
+	unsigned long i;
+	_BitScanReverse64(&i, w);
+	return (int)i;
+#else
+	return 63 - __builtin_clzll(w);
+#endif
+}
+
+// SpanBits function: The bits of word w covered by columns [x0, x1).
+static ShelterMask::Word SpanBits(int w, int x0, int x1)
+{
+	int lo = std::max(x0 - w * ShelterMask::WORD_BITS, 0);
+	int hi = std::min(x1 - w * ShelterMask::WORD_BITS, ShelterMask::WORD_BITS);
+	if (lo >= hi)
+		return 0;
+
+	ShelterMask::Word bits = ~(ShelterMask::Word)0 << lo;
+	if (hi < ShelterMask::WORD_BITS)
+		bits &= ~(~(ShelterMask::Word)0 << hi);
+	return bits;
+}
+
+// Reset function: Fills the grid then carves the bevels off the top corners and the arch out of the bottom.
+void ShelterMask::Reset(int width, int height)
+{
+	assert(width > 0 && height > 0);
+
+	mWidth = width;
+	mHeight = height;
+	mWordsPerRow = (width + WORD_BITS - 1) / WORD_BITS;
+	mBits.assign((size_t)mWordsPerRow * height, 0);
+	mRowVersions.assign(height, 0);
+	mVersion++;
+
+	int bevel = height / 4;
+	int archRadius = width / 6;
+	int archTop = height - height / 3;
+	int archCentreY = archTop + archRadius;  // Centre of the half disc at the top of the arch
+
+	mSolidCount = 0;
+	for (int y = 0; y < height; y++)
+	{
+		Word* row = &mBits[(size_t)y * mWordsPerRow];
+		int cut = std::max(bevel - y, 0);
+
+		for (int x = cut; x < width - cut; x++)
+		{
+			// Arch is a half disc sitting on a rectangle
+			int dx = x - width / 2;
+			int dy = std::min(y - archCentreY, 0);
+			if (y >= archTop && dx * dx + dy * dy < archRadius * archRadius)
+				continue;
+
+			row[x / WORD_BITS] |= (Word)1 << (x % WORD_BITS);
+			mSolidCount++;
+		}
+
+		mRowVersions[y] = mVersion;
+	}
+
+	mStartCount = mSolidCount;
+}
+
+// FindImpact function: ANDs the span's bits against each row in turn and stops at the first overlap.
+bool ShelterMask::FindImpact(int x0, int y0, int x1, int y1, bool downwards, int& outX, int& outY) const
+{
+	x0 = std::max(x0, 0);
+	y0 = std::max(y0, 0);
+	x1 = std::min(x1, mWidth);
+	y1 = std::min(y1, mHeight);
+	if (x0 >= x1 || y0 >= y1)
+		return false;
+
+	int w0 = x0 / WORD_BITS;
+	int w1 = (x1 - 1) / WORD_BITS;
+
+	for (int n = 0; n < y1 - y0; n++)
+	{
+		int y = downwards ? y0 + n : y1 - 1 - n;
+		const Word* row = GetRow(y);
+
+		int first = -1, last = -1;
+		for (int w = w0; w <= w1; w++)
+		{
+			Word hit = row[w] & SpanBits(w, x0, x1);
+			if (!hit)
+				continue;
+
+			if (first < 0)
+				first = w * WORD_BITS + LowestBit(hit);
+			last = w * WORD_BITS + HighestBit(hit);
+		}
+
+		if (first >= 0)
+		{
+			outX = (first + last) / 2;
+			outY = y;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Erode function: Clears a span per row, each as wide as the disc is at that row.
+int ShelterMask::Erode(int cx, int cy, int radius)
+{
+	int cleared = 0;
+	mVersion++;
+
+	for (int dy = -radius; dy <= radius; dy++)
+	{
+		int y = cy + dy;
+		if (y < 0 || y >= mHeight)
+			continue;
+
+		int half = (int)std::sqrt((float)(radius * radius - dy * dy));
+		cleared += ClearSpan(y, cx - half, cx + half + 1);
+	}
+
+	return cleared;
+}
+
+// GetSolidRows function: Scans in from both ends for a row with any bits set.
+bool ShelterMask::GetSolidRows(int& top, int& bottom) const
+{
+	auto rowSolid = [this](int y)
+		{
+			const Word* row = GetRow(y);
+			for (int w = 0; w < mWordsPerRow; w++)
+				if (row[w])
+					return true;
+			return false;
+		};
+
+	if (mSolidCount == 0)
+		return false;
+
+	top = 0;
+	while (!rowSolid(top))
+		top++;
+
+	bottom = mHeight - 1;
+	while (!rowSolid(bottom))
+		bottom--;
+
+	return true;
+}
+
+// ClearSpan function: Masks the span out of each word it touches and counts the bits that went.
+int ShelterMask::ClearSpan(int y, int x0, int x1)
+{
+	x0 = std::max(x0, 0);
+	x1 = std::min(x1, mWidth);
+	if (x0 >= x1)
+		return 0;
+
+	Word* row = &mBits[(size_t)y * mWordsPerRow];
+	int cleared = 0;
+	for (int w = x0 / WORD_BITS; w <= (x1 - 1) / WORD_BITS; w++)
+	{
+		Word bits = row[w] & SpanBits(w, x0, x1);
+		if (!bits)
+			continue;
+
+		cleared += PopCount(bits);
+		row[w] &= ~bits;
+	}
+
+	if (cleared)
+	{
+		mSolidCount -= cleared;
+		mRowVersions[y] = mVersion;
+	}
+	return cleared;
+}
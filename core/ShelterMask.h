@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+// ShelterMask class: A shelter as a grid of solid/empty pixels packed 64 to a word.
+// Hits test a projectile's span of columns against the rows it covers with one AND per
+// word, and erode a crater by clearing bits, so damage is per pixel instead of per hit.
+// Every row remembers the version it last changed in so the renderer only has to
+// regenerate the rows that changed since it last looked.
+class ShelterMask
+{
+public:
+    typedef uint64_t Word;
+    static constexpr int WORD_BITS = 64;
+
+    // Reset function: Builds a full width x height shelter with the classic bevelled top and arch.
+    void Reset(int width, int height);
+
+    // FindImpact function: Finds the first solid pixel inside the rectangle [x0, x1) x [y0, y1),
+    // scanning rows top to bottom when downwards or bottom to top otherwise.
+    // outX is the middle of the solid pixels on that row. Returns false if they are all empty.
+    bool FindImpact(int x0, int y0, int x1, int y1, bool downwards, int& outX, int& outY) const;
+
+    // Erode function: Clears a disc of pixels, returns how many were solid.
+    int Erode(int cx, int cy, int radius);
+
+    // GetSolidRows function: First and last rows with any solid pixels, false if there are none.
+    bool GetSolidRows(int& top, int& bottom) const;
+
+    bool IsSolid(int x, int y) const { return (mBits[(size_t)y * mWordsPerRow + x / WORD_BITS] >> (x % WORD_BITS)) & 1; }
+    const Word* GetRow(int y) const { return &mBits[(size_t)y * mWordsPerRow]; }
+
+    int GetWidth() const { return mWidth; }
+    int GetHeight() const { return mHeight; }
+    int GetSolidCount() const { return mSolidCount; }
+    int GetStartCount() const { return mStartCount; }  // Solid pixels after Reset.
+
+    // Versions: Bumped on every change, compare a row's version with the last one seen to find what changed.
+    uint32_t GetVersion() const { return mVersion; }
+    uint32_t GetRowVersion(int y) const { return mRowVersions[y]; }
+
+private:
+    // ClearSpan function: Clears columns [x0, x1) of a row, returns how many were solid.
+    int ClearSpan(int y, int x0, int x1);
+
+    std::vector<Word> mBits;             // Row major, mWordsPerRow words per row, bit x % 64 of word x / 64.
+    std::vector<uint32_t> mRowVersions;  // Version each row last changed in.
+    int mWidth = 0, mHeight = 0;
+    int mWordsPerRow = 0;
+    int mSolidCount = 0;
+    int mStartCount = 0;
+    uint32_t mVersion = 0;
+};
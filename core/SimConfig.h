@@ -0,0 +1,46 @@
+#pragma once
+
+#include "GameConstants.h"
+#include "SimTypes.h"
+
+
+// SimConfig struct: Everything the simulation needs to know about the game it is running.
+// Defaults match the shipped game, the renderer overwrites the screen and sprite sizes
+// with the real values from the window and textures, the scripts can override the rest.
+// Replays store every field, so new fields also need adding to VisitConfig in Replay.cpp.
+struct SimConfig
+{
+    // Play area
+    int mScreenWidth = 1024;   // Width of the play area in pixels.
+    int mScreenHeight = 768;   // Height of the play area in pixels.
+
+    // Player
+    int mPlayerLifes = GC::PLAYER_LIFES;  // Lifes the player starts with.
+
+    // Enemy formation
+    int mEnemiesPerRow = GC::ENEMIES_PER_ROW;        // Number of enemies in each row.
+    int mNumOfRows = GC::NUM_ROWS;                   // Number of rows of enemies.
+    int mRowXSpacing = GC::ROWX_SPACING;             // Horizontal spacing between enemies.
+    int mRowYSpacing = GC::ROWY_SPACING;             // Vertical spacing between rows.
+    int mEnemyInitialY = GC::ENEMY_INITIAL_Y;        // Y position of the top row.
+    int mUfoInitialY = GC::UFO_INITIAL_Y;            // Y position of the ufo.
+    int mEnemyDownstep = GC::ENEMY_DOWNSTEP;         // Vertical step when the formation hits an edge.
+    int mEnemyLimitOffset = GC::ENEMY_LIMIT_OFFSET;  // Offset from the screen edges the formation turns at.
+
+    // Collision
+    float mGridCellSize = 64.0f;  // Cell size of the collision broadphase, roughly one enemy plus spacing.
+    int mProjectileCapacity = 256;  // Most missiles and lasers that can be in flight at once (on top of the bullet hell ones).
+
+    // Bullet hell
+    int mBulletHellProjectiles = 0;  // Lasers kept in flight by the bullet hell variant, 0 plays the normal game.
+
+    // Screen space sizes of each sprite (texture dimensions * sprite scale).
+    SimVec2 mPlayerSize = SimVec2(51.2f, 51.2f);    // ship.dds at 0.1 scale.
+    SimVec2 mMissileSize = SimVec2(15.5f, 26.0f);   // A single frame of missile.dds at 0.5 scale.
+    SimVec2 mLaserSize = SimVec2(35.0f, 52.0f);     // laser.dds at 1.0 scale.
+    SimVec2 mOctopusSize = SimVec2(51.2f, 51.2f);   // octopus.dds at 0.1 scale.
+    SimVec2 mCrabSize = SimVec2(46.08f, 46.08f);    // crab.dds at 0.09 scale.
+    SimVec2 mSquidSize = SimVec2(40.96f, 40.96f);   // squid.dds at 0.08 scale.
+    SimVec2 mUfoSize = SimVec2(76.8f, 51.2f);       // ufo.dds at 0.15/0.1 scale.
+    SimVec2 mShelterSize = SimVec2(53.25f, 39.0f);  // A single state of sheltersheet.dds at 0.15 scale.
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+// Plain data types shared by the simulation core. These deliberately avoid
+// DirectX/Windows types so the core can be built and run headless.
+
+
+// SimVec2 struct: Minimal 2D vector used by the simulation in place of SimpleMath::Vector2.
+struct SimVec2
+{
+    SimVec2() {}
+    SimVec2(float _x, float _y) : x(_x), y(_y) {}
+
+    SimVec2 operator+(const SimVec2& rhs) const { return SimVec2(x + rhs.x, y + rhs.y); }
+    SimVec2 operator-(const SimVec2& rhs) const { return SimVec2(x - rhs.x, y - rhs.y); }
+    SimVec2 operator*(float s) const { return SimVec2(x * s, y * s); }
+    SimVec2 operator/(float s) const { return SimVec2(x / s, y / s); }
+
+    float x = 0, y = 0;
+};
+
+// SimLerp function: Blends between two positions, used to draw between the last two ticks.
+inline SimVec2 SimLerp(const SimVec2& a, const SimVec2& b, float t)
+{
+    return SimVec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+}
+
+// SimBox struct: Axis aligned bounding box used for all gameplay collisions.
+// Has the same edge layout as the game's BoundBox, which derives from it.
+struct SimBox
+{
+    // Updates the bounding box edges to specified coordinates.
+    void UpdateBox(float _left, float _top, float _right, float _bottom)
+    {
+        mLeft = _left;
+        mTop = _top;
+        mRight = _right;
+        mBottom = _bottom;
+    }
+
+    // Updates the bounding box based on a position and size.
+    // The _uniformScale parameter allows for scaling the bounding box size.
+    // The _isOriginCentred parameter indicates if the position is the centre of the box.
+    void UpdateBox(const SimVec2& _pos, SimVec2 _screenSize, float _uniformScale = 1.0f, bool _isOriginCentred = true)
+    {
+        _screenSize = (_isOriginCentred ? _screenSize / 2.0f : _screenSize) * _uniformScale;
+
+        mLeft = _pos.x - _screenSize.x;
+        mTop = _pos.y - _screenSize.y;
+        mRight = _pos.x + _screenSize.x;
+        mBottom = _pos.y + _screenSize.y;
+    }
+
+    // Overlaps function: The standard separating axis test between two boxes.
+    bool Overlaps(const SimBox& rhs) const
+    {
+        // Check if one object is to the left of the other
+        if (mRight < rhs.mLeft || rhs.mRight < mLeft)
+            return false; // No collision on the X axis
+
+        // Check if one object is above the other
+        if (mTop > rhs.mBottom || rhs.mTop > mBottom)
+            return false; // No collision on the Y axis
+
+        return true;
+    }
+
+    float mLeft = 0, mTop = 0, mRight = 0, mBottom = 0;  // Edges of the bounding box.
+};
+
+// SimInput struct: Everything the player can do in a single simulation tick.
+// Filled from the keyboard/gamepad by PlayMode, or generated by headless drivers.
+struct SimInput
+{
+    float mMoveX = 0.0f;  // Horizontal movement in the range -1 (left) to 1 (right).
+    bool mFire = false;   // Whether the fire button is held.
+};
+
+// SimEvent struct: Something that happened during a tick which the
+// presentation layer may want to react to (sounds, rumble, score).
+struct SimEvent
+{
+    enum Type
+    {
+        MISSILE_SHOOT,    // The player fired a missile.
+        LASER_SHOOT,      // An enemy fired a laser.
+        MISSILE_EXPLODE,  // A missile was destroyed by hitting something.
+        ENEMY_HIT,        // An enemy was destroyed, mValue holds the points awarded.
+        PLAYER_HIT,       // The player was struck by a laser.
+        SHELTER_HIT,      // A shelter took damage.
+        WAVE_CLEARED,     // All enemies were destroyed, mValue holds the points awarded.
+        GAME_OVER         // The game has ended.
+    };
+
+    SimEvent(Type _type, int _value = 0)
+        : mType(_type), mValue(_value)
+    {}
+
+    Type mType;
+    int mValue = 0;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+// Picks the widest vector instructions the compiler is allowed to use for the
+// simulation's batched kernels. Only one of these is ever defined, anything
+// that finds neither falls back to plain scalar loops.
+//   IA_SIMD_AVX - 8 floats per register (/arch:AVX or -mavx and above).
+//   IA_SIMD_SSE - 4 floats per register (SSE2 is always there on x64).
+#if defined(__AVX__)
+#define IA_SIMD_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IA_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
@@ -0,0 +1,692 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+
+// StageTimer class: Adds the time between its construction and destruction to a stage's total.
+class StageTimer
+{
+public:
+	StageTimer(bool _enabled, double& _total)
+		: mEnabled(_enabled), mTotal(_total)
+	{
+		if (mEnabled)
+			mStart = std::chrono::steady_clock::now();
+	}
+
+	~StageTimer()
+	{
+		if (mEnabled)
+			mTotal += std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+	}
+
+private:
+	bool mEnabled;
+	double& mTotal;
+	std::chrono::steady_clock::time_point mStart;
+};
+
+
+// Constructor: Sets up the player, shelters and enemy formation for a new game.
+Simulation::Simulation(const SimConfig& config, unsigned int seed)
+	: mConfig(config), mRandom(seed)
+{
+	mEvents.reserve(64);
+	mGrid.Init((float)mConfig.mScreenWidth, (float)mConfig.mScreenHeight, mConfig.mGridCellSize);
+	mProjectiles.Init(mConfig.mProjectileCapacity + mConfig.mBulletHellProjectiles);
+	mSweepMasks.resize(BoxKernel::MaskWords(mProjectiles.GetCapacity()));
+
+	InitPlayer();
+	InitShelters();
+	InitFormation();
+	SavePositions();
+}
+
+// InitPlayer function: Places the player at the bottom centre of its play area.
+void Simulation::InitPlayer()
+{
+	const SimVec2& size = mConfig.mPlayerSize;
+
+	// Set up the play area boundaries
+	mPlayer.mPlayArea.mLeft = size.x * 0.6f;
+	mPlayer.mPlayArea.mTop = size.y * 0.6f;
+	mPlayer.mPlayArea.mRight = mConfig.mScreenWidth - mPlayer.mPlayArea.mLeft;
+	mPlayer.mPlayArea.mBottom = mConfig.mScreenHeight * 0.9f;
+	mPlayer.mPos = SimVec2((mPlayer.mPlayArea.mLeft + mPlayer.mPlayArea.mRight) / 2.0f, mPlayer.mPlayArea.mBottom);
+	mPlayer.mBoundingBox.UpdateBox(mPlayer.mPos, size, 1.0f, true);
+
+	// Stops us from shooting immediately when the game starts
+	mPlayer.mFireTimer = GC::FIRE_DELAY;
+	mPlayer.mLifes = mConfig.mPlayerLifes;
+}
+
+// InitShelters function: Spaces the shelters out evenly above the player.
+void Simulation::InitShelters()
+{
+	float perShelterPos = (float)mConfig.mScreenWidth / GC::NUM_SHELTERS;
+
+	mShelters.resize(GC::NUM_SHELTERS);
+	for (int i = 0; i < GC::NUM_SHELTERS; i++)
+	{
+		ShelterState& s = mShelters[i];
+		s.mPos = SimVec2((perShelterPos - mConfig.mShelterSize.x / 2.0f) * (float)(i + 1),
+			mPlayer.mPos.y - GC::SHELTER_OFFSET_Y);
+		s.mMask.Reset(GC::SHELTER_MASK_WIDTH, GC::SHELTER_MASK_HEIGHT);
+	}
+
+	UpdateShelters();
+}
+
+// InitFormation function: Creates the rows of enemies, their lasers and the ufo.
+void Simulation::InitFormation()
+{
+	int numEnemies = mConfig.mNumOfRows * mConfig.mEnemiesPerRow;
+	mFormation.Resize(numEnemies);
+	mGrid.Resize(CollisionGrid::ENEMY, numEnemies);
+	mShooters.clear();
+
+	// Only squids (the top row) get to shoot
+	if (mConfig.mNumOfRows > 0)
+		for (int col = 0; col < mConfig.mEnemiesPerRow; col++)
+		{
+			Shooter shooter;
+			shooter.mEnemy = col;
+			mShooters.push_back(shooter);
+		}
+	mDueShooters.reserve(mShooters.size());
+	mShootRolls.reserve(mShooters.size());
+
+	// Finally set up the ufo enemy
+	mUfo.mType = UFO;
+	mUfo.mPos = SimVec2(0, (float)mConfig.mUfoInitialY);
+	mUfo.mActive = false;
+	mUfoDirection = -1;
+	mGrid.Resize(CollisionGrid::UFO, 1);
+
+	mLeftLimit = (float)mConfig.mEnemyLimitOffset;
+	mRightLimit = mConfig.mScreenWidth - (float)mConfig.mEnemyLimitOffset;
+
+	ResetWave();
+}
+
+// ResetWave function: Moves every enemy back to its starting position and brings it back to life.
+void Simulation::ResetWave()
+{
+	mSpeed = GC::ENEMY_START_SPEED;
+
+	// The octopus is the biggest enemy so use it to space all of them equally
+	float enemyWidth = mConfig.mOctopusSize.x + (float)mConfig.mRowXSpacing;
+	float totalRowWidth = (float)mConfig.mEnemiesPerRow * enemyWidth;
+	float initialX = (mConfig.mScreenWidth - totalRowWidth) / 2;  // Center the row of enemies
+
+	for (int row = 0; row < mConfig.mNumOfRows; row++)
+		for (int col = 0; col < mConfig.mEnemiesPerRow; col++)
+		{
+			// Determine the type of enemy based on row
+			EnemyType eType = OCTOPUS;
+			if (row == 0)
+				eType = SQUID;
+			else if (row <= 2)
+				eType = CRAB;
+
+			SimVec2 pos(initialX + ((float)(col + 0.5) * enemyWidth), (float)mConfig.mEnemyInitialY + (row * mConfig.mRowYSpacing));
+			mFormation.Set(row * mConfig.mEnemiesPerRow + col, (uint8_t)eType, pos, GetEnemySize(eType) / 2.0f * 0.9f);
+		}
+
+	mDirection = 1;
+	SyncFormationGrid();
+}
+
+// SavePositions function: Projectiles keep their own previous position when they move.
+void Simulation::SavePositions()
+{
+	mPlayer.mPrevPos = mPlayer.mPos;
+	mUfo.mPrevPos = mUfo.mPos;
+	mFormation.SavePositions();
+}
+
+// Step function: Advances the whole game by one tick.
+void Simulation::Step(const SimInput& input, float dTime)
+{
+	mEvents.clear();
+	mTicks++;
+	SavePositions();
+	std::fill(mStageTimes, mStageTimes + STAGE_COUNT, 0.0);
+
+	// Same order the game objects were originally updated in
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_PLAYER]);
+		UpdatePlayer(input, dTime);
+	}
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_MOVE]);
+		UpdateProjectiles(dTime);
+	}
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_COLLISION]);
+		CollideWithShelters(ProjectilePool::MISSILE);
+		UpdateShelters();
+	}
+
+	UpdateEnemies(dTime);
+}
+
+// UpdatePlayer function: Handles the player's recovery, shooting and movement.
+void Simulation::UpdatePlayer(const SimInput& input, float dTime)
+{
+	// If we're recovering/just been hit by a laser
+	if (mPlayer.mRecovering || mIsGameOver)
+	{
+		mPlayer.mRecoveryTimer += dTime;
+		if (mPlayer.mRecoveryTimer >= GC::PLAYER_RECOVER_TIME && !mIsGameOver)
+			mPlayer.mRecovering = false;
+
+		return;
+	}
+
+	// Fire a missile if the fire button is held and the fire delay has passed
+	mPlayer.mFireTimer -= dTime;
+	if (input.mFire && mPlayer.mFireTimer <= 0 && !mProjectiles.IsValid(mMissile))
+	{
+		// Set the missile's position slightly ahead of the player's ship
+		mMissile = SpawnProjectile(ProjectilePool::MISSILE, SimVec2(mPlayer.mPos.x, mPlayer.mPos.y - mConfig.mPlayerSize.y / 2),
+			SimVec2(0.0f, -GC::MISSILE_SPEED));
+		if (!mMissile.IsNull())
+		{
+			mPlayer.mFireTimer = GC::FIRE_DELAY;
+			RaiseEvent(SimEvent::MISSILE_SHOOT);
+		}
+	}
+
+	// Move and constrain the player to the play area
+	float moveX = std::clamp(input.mMoveX, -1.0f, 1.0f);
+	SimVec2 pos = mPlayer.mPos;
+	pos.x += moveX * GC::SHIP_SPEED * dTime;
+	pos.x = std::clamp(pos.x, mPlayer.mPlayArea.mLeft, mPlayer.mPlayArea.mRight);
+	pos.y = std::clamp(pos.y, mPlayer.mPlayArea.mTop, mPlayer.mPlayArea.mBottom);
+	mPlayer.mPos = pos;
+
+	mPlayer.mBoundingBox.UpdateBox(mPlayer.mPos, mConfig.mPlayerSize, 1.0f, true);
+}
+
+// UpdateProjectiles function: Moves every projectile and frees the ones that have left the screen.
+void Simulation::UpdateProjectiles(float dTime)
+{
+	mProjectiles.Move(dTime);
+
+	// Missiles leave through the top of the screen, lasers once they are fully past the bottom or sides
+	SimBox area;
+	area.UpdateBox(-mConfig.mLaserSize.x, 0.0f, mConfig.mScreenWidth + mConfig.mLaserSize.x, mConfig.mScreenHeight + mConfig.mLaserSize.y);
+	mProjectiles.Cull(area);
+}
+
+// SpawnProjectile function: Fires a projectile of the given type with a collider sized for it.
+ProjectileHandle Simulation::SpawnProjectile(ProjectilePool::Type _type, const SimVec2& _pos, const SimVec2& _velocity)
+{
+	return mProjectiles.Spawn(_type, _pos, _velocity, GetProjectileSize(_type) / 2.0f * 0.75f);
+}
+
+// UpdateShelters function: Shrinks each shelter's collider down to the rows it has left,
+// so projectiles passing over a worn down shelter don't need testing against its mask.
+void Simulation::UpdateShelters()
+{
+	for (ShelterState& s : mShelters)
+	{
+		if (!s.mActive)
+			continue;
+
+		int top, bottom;
+		if (!s.mMask.GetSolidRows(top, bottom))
+		{
+			s.mActive = false;
+			continue;
+		}
+
+		float rowHeight = mConfig.mShelterSize.y / (float)s.mMask.GetHeight();
+		float shelterTop = s.mPos.y - mConfig.mShelterSize.y / 2.0f;
+		s.mBoundingBox.UpdateBox(s.mPos.x - mConfig.mShelterSize.x / 2.0f, shelterTop + top * rowHeight,
+			s.mPos.x + mConfig.mShelterSize.x / 2.0f, shelterTop + (bottom + 1) * rowHeight);
+	}
+}
+
+// UpdateEnemies function: Moves the formation and the ufo, tops up the bullet hell then checks for collisions.
+void Simulation::UpdateEnemies(float dTime)
+{
+	if (mIsGameOver)
+		return;
+
+	if (mFormation.GetActiveCount() == 0)
+	{
+		// Reward the player for completing the wave
+		mScore += GC::WAVE_FINISH_POINTS;
+		mPlayer.mLifes++;
+		mWave++;
+		RaiseEvent(SimEvent::WAVE_CLEARED, GC::WAVE_FINISH_POINTS);
+
+		ResetWave();
+		return;
+	}
+
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_SPAWN]);
+		UpdateBulletHell(dTime);
+	}
+
+	bool checkCollisions = false;
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_ENEMIES]);
+		checkCollisions = UpdateFormation(dTime);
+	}
+
+	if (checkCollisions)
+	{
+		StageTimer timer(mProfiling, mStageTimes[STAGE_COLLISION]);
+		CheckCollisions();
+	}
+}
+
+// UpdateFormation function: Moves the formation and the ufo and gives the squids a chance to shoot.
+// Returns false when the ufo has just left the screen or the enemies have reached the player.
+bool Simulation::UpdateFormation(float dTime)
+{
+	// Move the whole formation horizontally based on direction and speed
+	EnemyFormation::Bounds bounds = mFormation.Move(mDirection * (mSpeed * dTime), 0.0f);
+
+	// Check for collision with screen edges and adjust accordingly
+	if ((mDirection == 1 && bounds.mMaxX > mRightLimit) ||
+		(mDirection == -1 && bounds.mMinX < mLeftLimit))
+	{
+		// Move all active enemies down and reverse direction
+		bounds = mFormation.Move(0.0f, (float)mConfig.mEnemyDownstep);
+
+		// Because we're moving down, see if it's our chance of getting the ufo
+		int random = mRandom.Get(SimRandom::STREAM_UFO).Int(0, 100);
+		if ((!mUfo.mActive && random <= GC::ENEMY_UFO_CHANCE) || mUfoActive)
+		{
+			mUfo.mActive = true;
+			mUfoActive = true;
+		}
+
+		mDirection *= -1;
+	}
+
+	SyncFormationGrid();
+
+	UpdateShooters(dTime);
+
+	if (mUfo.mActive)
+	{
+		SimVec2 pos = mUfo.mPos;
+		pos.x += mUfoDirection * (GC::ENEMY_UFO_SPEED * dTime);
+
+		if (pos.x < 0 || pos.x > mConfig.mScreenWidth + (mConfig.mUfoSize.y / 2))
+		{
+			mUfo.mActive = false;
+			mUfoDirection *= -1;
+			mGrid.Remove(CollisionGrid::UFO, 0);
+			return false;
+		}
+
+		mUfo.mPos = pos;
+		mUfo.mBoundingBox.UpdateBox(mUfo.mPos, mConfig.mUfoSize, 0.9f, true);
+		mGrid.Update(CollisionGrid::UFO, 0, mUfo.mBoundingBox);
+	}
+
+	// Check if the lowest enemy has reached a critical position indicating game over
+	if (bounds.mMaxY >= GC::ENEMY_GAME_OVER_Y)
+	{
+		GameIsOver();
+		return false;
+	}
+
+	return true;
+}
+
+// UpdateBulletHell function: Spawns lasers from the alive enemies in turn until the target amount are in flight.
+// Each laser is fired a golden angle round from the last so together they fan out in a spiral.
+void Simulation::UpdateBulletHell(float dTime)
+{
+	if (mConfig.mBulletHellProjectiles <= 0)
+		return;
+
+	const float goldenAngle = 2.39996323f;
+	const size_t target = (size_t)mConfig.mBulletHellProjectiles;
+	const size_t formationSize = mFormation.Size();
+
+	// Fill up gradually rather than all from the same spot in one tick
+	size_t maxSpawns = std::max<size_t>(1, (size_t)(target * dTime / GC::BULLET_HELL_FILL_TIME));
+	size_t live = mProjectiles.GetLiveCount(ProjectilePool::LASER);
+
+	for (size_t n = 0; n < maxSpawns && live < target; n++, live++)
+	{
+		// Walk round the formation so every alive enemy takes a turn
+		size_t enemy = mBulletHellEnemy % formationSize;
+		while (!mFormation.IsActive(enemy))
+			enemy = (enemy + 1) % formationSize;
+
+		float spin = std::fmod((float)mBulletHellSpawns * goldenAngle, 2.0f * GC::BULLET_HELL_SPREAD);
+		float angle = spin - GC::BULLET_HELL_SPREAD;
+		float speed = GC::LASER_SPEED * (0.75f + 0.5f * (spin / (2.0f * GC::BULLET_HELL_SPREAD)));
+
+		SimVec2 velocity(std::sin(angle) * speed, std::cos(angle) * speed);
+		if (SpawnProjectile(ProjectilePool::LASER, mFormation.GetPos(enemy), velocity).IsNull())
+			break;  // Pool is full
+
+		mBulletHellEnemy = enemy + 1;
+		mBulletHellSpawns++;
+	}
+}
+
+// UpdateShooters function: Gives the squids a chance to fire their lasers every so often.
+// The alive squids' timers run together, so everyone due rolls in a single batch.
+void Simulation::UpdateShooters(float dTime)
+{
+	mDueShooters.clear();
+	for (size_t i = 0; i < mShooters.size(); i++)
+	{
+		Shooter& shooter = mShooters[i];
+		if (!mFormation.IsActive(shooter.mEnemy))
+			continue;
+
+		shooter.mShootTimer += dTime;
+		if (shooter.mShootTimer <= (float)GC::ENEMY_TIME_BTWN_SHOTS)
+			continue;
+
+		shooter.mShootTimer = 0;
+		mDueShooters.push_back(i);
+	}
+
+	if (mDueShooters.empty())
+		return;
+
+	mShootRolls.resize(mDueShooters.size());
+	mRandom.Get(SimRandom::STREAM_SHOOT).FillInts(0, 100, mShootRolls.data(), mShootRolls.size());
+
+	for (size_t n = 0; n < mDueShooters.size(); n++)
+	{
+		Shooter& shooter = mShooters[mDueShooters[n]];
+		if (mShootRolls[n] >= GC::ENEMY_SHOOT_CHANCE || mProjectiles.IsValid(shooter.mLaser))
+			continue;
+
+		// Set the laser's position slighty below the centre of the enemy
+		SimVec2 pos = mFormation.GetPos(shooter.mEnemy);
+		shooter.mLaser = SpawnProjectile(ProjectilePool::LASER, SimVec2(pos.x, pos.y + mConfig.mSquidSize.y / 2),
+			SimVec2(0.0f, GC::LASER_SPEED));
+		if (!shooter.mLaser.IsNull())
+			RaiseEvent(SimEvent::LASER_SHOOT);
+	}
+}
+
+// SyncFormationGrid function: Updates the broadphase with the alive enemies' colliders and removes the dead.
+void Simulation::SyncFormationGrid()
+{
+	for (size_t i = 0; i < mFormation.Size(); i++)
+	{
+		if (mFormation.IsActive(i))
+			mGrid.Update(CollisionGrid::ENEMY, i, mFormation.GetBox(i));
+		else
+			mGrid.Remove(CollisionGrid::ENEMY, i);
+	}
+}
+
+// CheckCollisions function: Lasers against shelters and the player, missiles against the enemies.
+void Simulation::CheckCollisions()
+{
+	CollideWithShelters(ProjectilePool::LASER);
+
+	// Laser hit player check, there's only the one player so sweep it over every projectile at once
+	size_t count = mProjectiles.GetLiveCount();
+	if (mPlayer.IsAlive() && mProjectiles.GetLiveCount(ProjectilePool::LASER) > 0)
+	{
+		BoxKernel::Overlap(mPlayer.mBoundingBox, mProjectiles.GetLefts(), mProjectiles.GetTops(),
+			mProjectiles.GetRights(), mProjectiles.GetBottoms(), count, mSweepMasks.data());
+
+		// Walk the hits backwards, freeing moves the last projectile into the gap which has already been looked at
+		for (size_t i = count; i > 0; i--)
+		{
+			size_t p = i - 1;
+			if (!(mSweepMasks[p / 32] & (1u << (p % 32))) || mProjectiles.GetType(p) != ProjectilePool::LASER)
+				continue;
+
+			LaserHit(p);
+			if (mIsGameOver)
+				return;  // Game over frees projectiles, nothing left to check
+		}
+	}
+
+	// Missile hit enemy check, there are only ever a few missiles so each one queries the broadphase
+	size_t missilesLeft = mProjectiles.GetLiveCount(ProjectilePool::MISSILE);
+	for (size_t i = mProjectiles.GetLiveCount(); i > 0 && missilesLeft > 0; i--)
+	{
+		size_t p = i - 1;
+		if (mProjectiles.GetType(p) != ProjectilePool::MISSILE)
+			continue;
+
+		missilesLeft--;
+		SimBox missileBox = mProjectiles.GetBox(p);
+
+		// A missile can only take out one enemy
+		int enemy = FindFirstHit(CollisionGrid::ENEMY, missileBox);
+		if (enemy >= 0)
+		{
+			mFormation.Kill(enemy);
+			mGrid.Remove(CollisionGrid::ENEMY, enemy);
+			MissileHit(p, (EnemyType)mFormation.GetType(enemy));
+			continue;
+		}
+
+		if (FindFirstHit(CollisionGrid::UFO, missileBox) >= 0)
+		{
+			mUfo.mActive = false;
+			mGrid.Remove(CollisionGrid::UFO, 0);
+			MissileHit(p, UFO);
+			mUfo.mPos = SimVec2(0, mUfo.mPos.y);
+			mUfoDirection = -1;
+			mUfoActive = false;
+		}
+	}
+}
+
+// CollideWithShelters function: Sweeps each shelter over every projectile and damages it with those of the given type.
+// A projectile is freed on its first hit so it can never damage a second shelter.
+void Simulation::CollideWithShelters(ProjectilePool::Type _type)
+{
+	for (ShelterState& s : mShelters)
+	{
+		size_t count = mProjectiles.GetLiveCount();
+		if (mProjectiles.GetLiveCount(_type) == 0)
+			return;
+		if (!s.mActive)
+			continue;
+
+		BoxKernel::Overlap(s.mBoundingBox, mProjectiles.GetLefts(), mProjectiles.GetTops(),
+			mProjectiles.GetRights(), mProjectiles.GetBottoms(), count, mSweepMasks.data());
+
+		// Walk the hits backwards, freeing moves the last projectile into the gap which has already been looked at.
+		// The box only says the projectile is near the shelter, it's only hit if it overlaps a solid pixel.
+		// Once the shelter is destroyed the rest pass through to the next one.
+		for (size_t i = count; i > 0 && s.mActive; i--)
+		{
+			size_t p = i - 1;
+			if (!(mSweepMasks[p / 32] & (1u << (p % 32))) || mProjectiles.GetType(p) != _type)
+				continue;
+
+			if (!HitShelter(s, mProjectiles.GetBox(p), _type == ProjectilePool::LASER))
+				continue;
+
+			mProjectiles.FreeAt(p);
+
+			if (_type == ProjectilePool::MISSILE)
+				RaiseEvent(SimEvent::MISSILE_EXPLODE);
+		}
+	}
+}
+
+// FindFirstHit function: Gathers the broadphase candidates on a layer and runs the box kernel over them,
+// returns the lowest indexed collider the box overlaps or -1 if there were none.
+int Simulation::FindFirstHit(CollisionGrid::Layer _layer, const SimBox& _box)
+{
+	mGrid.Query(_layer, _box, mCandidates);
+	if (mCandidates.empty())
+		return -1;
+
+	// Candidates that have gone since the grid was last synced still take a slot so the bits line up
+	mCandidateBoxes.Clear();
+	for (uint32_t i : mCandidates)
+	{
+		SimBox box;
+		if (GetColliderBox(_layer, i, box))
+			mCandidateBoxes.Add(box);
+		else
+			mCandidateBoxes.AddNone();
+	}
+
+	mCandidateBoxes.Overlap(_box, mHitMasks);
+	int hit = BoxKernel::FirstHit(mHitMasks.data(), mCandidateBoxes.Size());
+	return hit < 0 ? -1 : (int)mCandidates[hit];
+}
+
+// GetColliderBox function: Looks up a collider on a layer, returns false if it is no longer in play.
+bool Simulation::GetColliderBox(CollisionGrid::Layer _layer, size_t _index, SimBox& outBox) const
+{
+	switch (_layer)
+	{
+	case CollisionGrid::ENEMY:
+		if (!mFormation.IsActive(_index))
+			return false;
+		outBox = mFormation.GetBox(_index);
+		return true;
+	case CollisionGrid::UFO:
+		if (!mUfo.mActive)
+			return false;
+		outBox = mUfo.mBoundingBox;
+		return true;
+	default:
+		return false;
+	}
+}
+
+// MissileHit function: Handles the logic behind an enemy being hit by a missile.
+void Simulation::MissileHit(size_t _missile, EnemyType _eType)
+{
+	mProjectiles.FreeAt(_missile);
+
+	// Gameplay logic, score/speed
+	int points = GetETypePoints(_eType);
+	mScore += points;
+	mSpeed += GC::ENEMY_SPEED_INC;
+
+	RaiseEvent(SimEvent::MISSILE_EXPLODE);
+	RaiseEvent(SimEvent::ENEMY_HIT, points);
+}
+
+// LaserHit function: Handles the logic behind a laser hitting the player.
+void Simulation::LaserHit(size_t _laser)
+{
+	mProjectiles.FreeAt(_laser);
+
+	HitPlayer();
+	RaiseEvent(SimEvent::PLAYER_HIT);
+}
+
+// HitPlayer function: Takes a life off the player and starts their recovery.
+void Simulation::HitPlayer()
+{
+	// If we've been hit whilst recovering then just skip the function
+	if (mPlayer.mRecovering)
+		return;
+
+	mPlayer.mLifes--;
+	mPlayer.mRecoveryTimer = 0.0f;
+	mPlayer.mRecovering = true;
+
+	if (!mPlayer.IsAlive())
+		GameIsOver();
+}
+
+// HitShelter function: Finds the first solid pixel the box covers, coming from the top for lasers and
+// the bottom for missiles, and blows a crater just past it. Returns false if the box only covers empty pixels.
+bool Simulation::HitShelter(ShelterState& _shelter, const SimBox& _box, bool _downwards)
+{
+	ShelterMask& mask = _shelter.mMask;
+
+	// Into mask pixels, rounding outwards so a projectile touching a pixel covers it
+	float left = _shelter.mPos.x - mConfig.mShelterSize.x / 2.0f;
+	float top = _shelter.mPos.y - mConfig.mShelterSize.y / 2.0f;
+	float scaleX = (float)mask.GetWidth() / mConfig.mShelterSize.x;
+	float scaleY = (float)mask.GetHeight() / mConfig.mShelterSize.y;
+
+	int x, y;
+	if (!mask.FindImpact((int)std::floor((_box.mLeft - left) * scaleX), (int)std::floor((_box.mTop - top) * scaleY),
+		(int)std::ceil((_box.mRight - left) * scaleX), (int)std::ceil((_box.mBottom - top) * scaleY), _downwards, x, y))
+		return false;
+
+	// Centre the crater a little further on so the hit digs into the shelter
+	int radius = GC::SHELTER_CRATER_RADIUS;
+	mask.Erode(x, _downwards ? y + radius / 2 : y - radius / 2, radius);
+	RaiseEvent(SimEvent::SHELTER_HIT);
+
+	// Check if it should be demolished
+	if (mask.GetSolidCount() * 100 < mask.GetStartCount() * GC::SHELTER_DESTROYED_PERCENT)
+		_shelter.mActive = false;
+
+	return true;
+}
+
+// GameIsOver function: Ends the game, any missile in flight is removed and the player loses their lifes.
+void Simulation::GameIsOver()
+{
+	if (mIsGameOver)
+		return;  // Prevent multiple triggers of game over logic.
+
+	mIsGameOver = true;
+	mProjectiles.Free(mMissile);
+
+	int playerLifes = mPlayer.mLifes;
+	for (int i = 0; i < playerLifes; i++)
+		HitPlayer();
+
+	RaiseEvent(SimEvent::GAME_OVER);
+}
+
+// GetETypePoints function: Determines the points value for an enemy based on its type.
+int Simulation::GetETypePoints(EnemyType _eType)
+{
+	switch (_eType)
+	{
+	case OCTOPUS:
+		return GC::OCTOPUS_POINTS;
+	case CRAB:
+		return GC::CRAB_POINTS;
+	case SQUID:
+		return GC::SQUID_POINTS;
+	case UFO:
+		return GC::UFO_POINTS[mRandom.Get(SimRandom::STREAM_POINTS).Int(0, 3)];  // Assign random points for a UFO type enemy
+	default:
+		return 0;
+	}
+}
+
+// GetProjectileSize function: Screen size of a projectile of the given type.
+SimVec2 Simulation::GetProjectileSize(ProjectilePool::Type _type) const
+{
+	return _type == ProjectilePool::MISSILE ? mConfig.mMissileSize : mConfig.mLaserSize;
+}
+
+// GetEnemySize function: Screen size of an enemy of the given type.
+SimVec2 Simulation::GetEnemySize(EnemyType _eType) const
+{
+	switch (_eType)
+	{
+	case CRAB:
+		return mConfig.mCrabSize;
+	case SQUID:
+		return mConfig.mSquidSize;
+	case UFO:
+		return mConfig.mUfoSize;
+	default:
+		return mConfig.mOctopusSize;
+	}
+}
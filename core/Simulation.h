@@ -0,0 +1,180 @@
+#pragma once
+
+#include <vector>
+
+#include "SimConfig.h"
+#include "SimTypes.h"
+#include "EnemyFormation.h"
+#include "CollisionGrid.h"
+#include "BoxKernel.h"
+#include "ProjectilePool.h"
+#include "ShelterMask.h"
+#include "Random.h"
+
+
+// Simulation class: Pure C++ simulation of a game of Interstellar Assault.
+// Has no knowledge of windows, devices, textures or audio, it is driven by a
+// SimInput and a delta time each tick and reports what happened through SimEvents.
+// PlayMode wraps one of these for rendering, headless tools can run as many as they like.
+class Simulation
+{
+public:
+    // Enum to represent different types of enemies
+    enum EnemyType { OCTOPUS, CRAB, SQUID, UFO };
+
+    // PlayerState struct: The player's ship.
+    struct PlayerState
+    {
+        SimVec2 mPos;            // Centre of the ship.
+        SimVec2 mPrevPos;        // Centre of the ship before the last Step, for interpolation.
+        SimBox mBoundingBox;     // Collider of the ship.
+        SimBox mPlayArea;        // Area within which the player can move.
+        float mFireTimer = 0;    // Time left until the player can fire again.
+        int mLifes = 0;          // Player's current lifes.
+        float mRecoveryTimer = 0.0f;  // Time spent recovering since the last hit.
+        bool mRecovering = false;     // Whether the player is recovering from a hit.
+
+        bool IsAlive() const { return mLifes > 0; }
+    };
+
+    // EnemyState struct: The ufo, the rest of the enemies live in the EnemyFormation.
+    struct EnemyState
+    {
+        EnemyType mType = OCTOPUS;  // Type of the enemy.
+        SimVec2 mPos;               // Centre of the enemy.
+        SimVec2 mPrevPos;           // Centre of the enemy before the last Step, for interpolation.
+        SimBox mBoundingBox;        // Collider of the enemy.
+        bool mActive = false;       // Whether the enemy is alive.
+    };
+
+    // Shooter struct: A formation enemy that is allowed to fire lasers (the squids).
+    struct Shooter
+    {
+        size_t mEnemy = 0;      // Index into the formation.
+        ProjectileHandle mLaser;  // The enemy's laser, only one can be in flight at a time.
+        float mShootTimer = 0;  // Time since the enemy last had a chance to shoot.
+    };
+
+    // ShelterState struct: A destructible shelter sitting above the player.
+    struct ShelterState
+    {
+        SimVec2 mPos;              // Centre of the shelter.
+        SimBox mBoundingBox;       // Box round the shelter's remaining pixels, shrinks with damage.
+        ShelterMask mMask;         // Which of the shelter's pixels are still standing.
+        bool mActive = true;       // Whether the shelter is still standing.
+    };
+
+    // Stage enum: The parts of a Step that are timed when profiling is on.
+    enum Stage
+    {
+        STAGE_PLAYER,     // Player movement and shooting.
+        STAGE_MOVE,       // Projectile movement and off screen culling.
+        STAGE_SPAWN,      // Bullet hell laser spawning.
+        STAGE_ENEMIES,    // Formation, ufo and squid shooting.
+        STAGE_COLLISION,  // Every projectile collision and shelter collider.
+        STAGE_COUNT
+    };
+
+public:
+    // Constructor: Sets up a fresh game using the given configuration and random seed.
+    Simulation(const SimConfig& config, unsigned int seed = 0);
+
+    // Step function: Advances the game by dTime seconds using the given input.
+    void Step(const SimInput& input, float dTime);
+
+    // SetProfiling function: Turns timing of each stage of Step on or off.
+    void SetProfiling(bool _profiling) { mProfiling = _profiling; }
+
+    // GetStageTime function: Seconds spent in a stage during the last Step, zero unless profiling.
+    double GetStageTime(Stage _stage) const { return mStageTimes[_stage]; }
+
+    // Accessors for the renderer and headless drivers.
+    const SimConfig& GetConfig() const { return mConfig; }
+    const PlayerState& GetPlayer() const { return mPlayer; }
+    const ProjectilePool& GetProjectiles() const { return mProjectiles; }
+    const EnemyFormation& GetFormation() const { return mFormation; }
+    const EnemyState& GetUfo() const { return mUfo; }
+    const std::vector<ShelterState>& GetShelters() const { return mShelters; }
+    SimVec2 GetEnemySize(EnemyType _eType) const;
+
+    // Events raised during the last Step.
+    const std::vector<SimEvent>& GetEvents() const { return mEvents; }
+
+    int GetScore() const { return mScore; }            // Points scored so far.
+    int GetWave() const { return mWave; }              // Number of waves cleared so far.
+    unsigned int GetTicks() const { return mTicks; }   // Number of steps taken.
+    bool IsGameOver() const { return mIsGameOver; }    // Whether the game has ended.
+
+private:
+    void InitPlayer();     // Place the player and set up its play area.
+    void InitShelters();   // Place the shelters above the player.
+    void InitFormation();  // Create the enemy formation and ufo.
+    void ResetWave();      // Reset the formation after a wave has been cleared.
+    void SavePositions();  // Remember where everything is before a tick moves it, for interpolation.
+
+    void UpdatePlayer(const SimInput& input, float dTime);  // Player movement, shooting and recovery.
+    void UpdateProjectiles(float dTime);  // Projectile movement and culling.
+    void UpdateShelters();             // Shelter colliders.
+    void UpdateEnemies(float dTime);   // Formation, ufo and bullet hell, then collisions.
+    bool UpdateFormation(float dTime); // Formation and ufo movement, false if collisions should be skipped this tick.
+    void UpdateShooters(float dTime);   // Gives every squid whose timer is up its chance to shoot.
+    void UpdateBulletHell(float dTime);  // Tops the lasers in flight back up to the bullet hell target.
+    void SyncFormationGrid();          // Moves the formation's colliders around the broadphase.
+    ProjectileHandle SpawnProjectile(ProjectilePool::Type _type, const SimVec2& _pos, const SimVec2& _velocity);  // Fire a projectile.
+    SimVec2 GetProjectileSize(ProjectilePool::Type _type) const;  // Screen size of a projectile of the given type.
+
+    void CheckCollisions();  // Missiles vs enemies and lasers vs player/shelters.
+    void CollideWithShelters(ProjectilePool::Type _type);  // Damage the shelters with every projectile of a type that hits one.
+    int FindFirstHit(CollisionGrid::Layer _layer, const SimBox& _box);  // Broadphase then narrowphase, -1 on a miss.
+    bool GetColliderBox(CollisionGrid::Layer _layer, size_t _index, SimBox& outBox) const;  // False if the collider is gone.
+
+    void MissileHit(size_t _missile, EnemyType _eType);  // An enemy of the given type was hit by the missile at a live index.
+    void LaserHit(size_t _laser);         // The player was hit by the laser at a live index.
+    void HitPlayer();                     // Take a life off the player.
+    bool HitShelter(ShelterState& _shelter, const SimBox& _box, bool _downwards);  // Craters a shelter where the box hits it.
+    void GameIsOver();                    // End the game.
+
+    int GetETypePoints(EnemyType _eType);  // Points value for an enemy.
+
+    void RaiseEvent(SimEvent::Type _type, int _value = 0) { mEvents.push_back(SimEvent(_type, _value)); }
+
+    SimConfig mConfig;
+    SimRandom mRandom;       // Every random roll, seeded from the game's seed.
+
+    PlayerState mPlayer;
+    ProjectilePool mProjectiles;  // Every missile and laser in flight.
+    ProjectileHandle mMissile;    // The player's missile, only one can be in flight at a time.
+    EnemyFormation mFormation;       // Every enemy apart from the ufo.
+    std::vector<Shooter> mShooters;  // The enemies in the formation that can shoot.
+    std::vector<size_t> mDueShooters;  // Shooters whose timer is up this tick.
+    std::vector<int> mShootRolls;      // Their rolls, made in one batch.
+    EnemyState mUfo;
+    std::vector<ShelterState> mShelters;
+
+    CollisionGrid mGrid;                 // Broadphase for projectiles against the enemies.
+    std::vector<uint32_t> mCandidates;   // Results of the last broadphase query.
+    BoxBatch mCandidateBoxes;            // The candidates' colliders packed for the narrowphase.
+    std::vector<uint32_t> mHitMasks;     // Results of the last narrowphase.
+    std::vector<uint32_t> mSweepMasks;   // Results of the last sweep of a target over every projectile.
+
+    std::vector<SimEvent> mEvents;
+
+    int mDirection = 1;     // Direction of enemy movement (1 for right, -1 for left)
+    int mUfoDirection = -1; // Direction of ufo movement (1 for right, -1 for left)
+    float mSpeed = GC::ENEMY_START_SPEED;  // Speed of enemy movement
+    bool mUfoActive = true; // Whether the ufo should appear on the next downstep
+
+    float mLeftLimit = 0;   // Left boundary of the formation
+    float mRightLimit = 0;  // Right boundary of the formation
+
+    size_t mBulletHellSpawns = 0;  // Lasers spawned by the bullet hell so far, drives the spiral pattern.
+    size_t mBulletHellEnemy = 0;   // Formation index of the next enemy to fire a bullet hell laser.
+
+    int mScore = 0;
+    int mWave = 0;
+    unsigned int mTicks = 0;
+    bool mIsGameOver = false;
+
+    bool mProfiling = false;
+    double mStageTimes[STAGE_COUNT] = {};  // Seconds spent in each stage during the last Step.
+};
@@ -0,0 +1,137 @@
+#include "TaskPool.h"
+
+#include <cassert>
+
+
+thread_local const TaskPool* TaskPool::sWorkerPool = nullptr;
+thread_local size_t TaskPool::sWorkerIndex = 0;
+
+// Constructor: Creates a queue per worker before starting any of them so they can all steal straight away.
+TaskPool::TaskPool(size_t threads)
+{
+	if (threads == 0)
+		threads = std::thread::hardware_concurrency();
+	if (threads == 0)
+		threads = 1;
+
+	for (size_t i = 0; i < threads; i++)
+		mQueues.push_back(new Queue);
+
+	for (size_t i = 0; i < threads; i++)
+		mThreads.emplace_back(&TaskPool::WorkerLoop, this, i);
+}
+
+// Destructor: Lets the workers drain their queues before telling them to stop.
+TaskPool::~TaskPool()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mStopping = true;
+	}
+	mWake.notify_all();
+
+	for (std::thread& t : mThreads)
+		t.join();
+
+	for (Queue* q : mQueues)
+		delete q;
+	mQueues.clear();
+}
+
+// Push function: A worker keeps its own tasks, anyone else spreads them round the queues.
+void TaskPool::Push(const Task& task)
+{
+	size_t target = sWorkerPool == this ? sWorkerIndex : mNextQueue++ % mQueues.size();
+
+	mPending++;
+
+	// Count it under the wake lock first so a worker that has just found nothing can't go to sleep on it
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mQueued++;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mQueues[target]->mMutex);
+		mQueues[target]->mTasks.push_back(task);
+	}
+	mWake.notify_one();
+}
+
+// Wait function: Sleeps until the last task to finish signals it.
+void TaskPool::Wait()
+{
+	assert(sWorkerPool != this);  // A task waiting on the pool it runs in would never finish.
+
+	std::unique_lock<std::mutex> lock(mWakeMutex);
+	mDone.wait(lock, [this] { return mPending == 0; });
+}
+
+// PopOwn function: Takes from the back, the task most likely to still be in this core's cache.
+bool TaskPool::PopOwn(size_t self, Task& task)
+{
+	Queue& q = *mQueues[self];
+	std::lock_guard<std::mutex> lock(q.mMutex);
+	if (q.mTasks.empty())
+		return false;
+
+	task = std::move(q.mTasks.back());
+	q.mTasks.pop_back();
+	return true;
+}
+
+// Steal function: Takes from the front of the other queues, starting with the next one along so thieves spread out.
+bool TaskPool::Steal(size_t self, Task& task)
+{
+	size_t count = mQueues.size();
+	for (size_t n = 1; n < count; n++)
+	{
+		Queue& q = *mQueues[(self + n) % count];
+		std::unique_lock<std::mutex> lock(q.mMutex, std::try_to_lock);
+		if (!lock.owns_lock() || q.mTasks.empty())
+			continue;
+
+		task = std::move(q.mTasks.front());
+		q.mTasks.pop_front();
+		return true;
+	}
+
+	return false;
+}
+
+// Run function: Runs the task then wakes Wait if nothing else is outstanding.
+void TaskPool::Run(Task& task)
+{
+	mQueued--;
+	task();
+	task = nullptr;
+
+	if (--mPending == 0)
+	{
+		std::lock_guard<std::mutex> lock(mWakeMutex);
+		mDone.notify_all();
+	}
+}
+
+// WorkerLoop function: Works through its own queue, steals when empty and sleeps when there's nothing anywhere.
+void TaskPool::WorkerLoop(size_t self)
+{
+	sWorkerPool = this;
+	sWorkerIndex = self;
+
+	Task task;
+	while (true)
+	{
+		if (PopOwn(self, task) || Steal(self, task))
+		{
+			Run(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mWakeMutex);
+		mWake.wait(lock, [this] { return mStopping || mQueued > 0; });
+		if (mStopping && mQueued == 0)
+			return;
+	}
+}
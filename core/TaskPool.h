@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+
+// TaskPool class: Fixed set of worker threads that run tasks with work stealing.
+// Every worker has its own queue, tasks pushed from a worker go on the back of its
+// own queue and it pops from there too so it keeps working on what it has just touched.
+// A worker with nothing left steals from the front of the other queues, so uneven
+// tasks (games that end early, waves that take longer) balance themselves out
+// without everyone fighting over one shared queue.
+class TaskPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    // Constructor: Starts the workers, 0 uses one per hardware thread.
+    explicit TaskPool(size_t threads = 0);
+
+    // Destructor: Finishes every queued task then joins the workers.
+    ~TaskPool();
+
+    // Push function: Queues a task, safe to call from inside a running task.
+    void Push(const Task& task);
+
+    // Wait function: Blocks until every task pushed so far has finished, can't be called from a task.
+    void Wait();
+
+    size_t GetThreadCount() const { return mThreads.size(); }
+
+private:
+    // Queue struct: A worker's tasks, padded out to its own cache line.
+    struct alignas(64) Queue
+    {
+        std::mutex mMutex;
+        std::deque<Task> mTasks;
+    };
+
+    bool PopOwn(size_t self, Task& task);    // Newest task from the worker's own queue.
+    bool Steal(size_t self, Task& task);     // Oldest task from any other queue.
+    void Run(Task& task);                    // Runs a task and signals Wait if it was the last one.
+    void WorkerLoop(size_t self);
+
+    std::vector<Queue*> mQueues;        // One per worker.
+    std::vector<std::thread> mThreads;
+
+    std::atomic<size_t> mPending{ 0 };    // Tasks pushed but not finished.
+    std::atomic<size_t> mQueued{ 0 };     // Tasks sitting in a queue waiting for a worker.
+    std::atomic<size_t> mNextQueue{ 0 };  // Round robin for tasks pushed from outside the pool.
+    std::atomic<bool> mStopping{ false };
+
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;  // Signalled when tasks are pushed or the pool stops.
+    std::condition_variable mDone;  // Signalled when mPending reaches zero.
+
+    static thread_local const TaskPool* sWorkerPool;  // Pool the calling thread works for, nullptr elsewhere.
+    static thread_local size_t sWorkerIndex;          // Index of the calling thread in that pool.
+};
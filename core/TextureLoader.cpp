@@ -0,0 +1,19 @@
+#include "TextureLoader.h"
+
+using namespace std;
+
+
+// Load function: The promise is shared with the task, TaskPool tasks have to be copyable.
+TextureLoader::Future TextureLoader::Load(const string& path)
+{
+	shared_ptr<promise<ResultPtr>> done = make_shared<promise<ResultPtr>>();
+	Future future = done->get_future().share();
+
+	mPool.Push([done, path] {
+		shared_ptr<Result> result = make_shared<Result>();
+		result->mPath = path;
+		result->mOk = Dds::Load(path, result->mImage, result->mError);
+		done->set_value(result);
+		});
+	return future;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <future>
+#include <cstddef>
+
+#include "DdsImage.h"
+#include "TaskPool.h"
+
+
+// TextureLoader class: Reads and parses DDS files on a pool of worker threads.
+// Load returns straight away with a future for the parsed image, the disk reads and
+// parsing of every file asked for run side by side while the caller gets on with
+// something else. Only the CPU side happens here, creating the texture from the image
+// is left to whoever owns the device (see TexCache::Update).
+class TextureLoader
+{
+public:
+    // Result struct: A finished load, mOk false with the reason in mError if it failed.
+    struct Result
+    {
+        std::string mPath;
+        bool mOk = false;
+        std::string mError;
+        DdsImage mImage;
+    };
+    typedef std::shared_ptr<const Result> ResultPtr;
+    typedef std::shared_future<ResultPtr> Future;
+
+    // Constructor: Starts the workers, 0 uses one per hardware thread.
+    explicit TextureLoader(size_t threads = 0) : mPool(threads) {}
+
+    // Load function: Queues a file to be read and parsed. The future is ready once it's done,
+    // waiting on it only waits for this file. Safe to call from any thread.
+    Future Load(const std::string& path);
+
+    // Wait function: Blocks until every load queued so far has finished.
+    void Wait() { mPool.Wait(); }
+
+    size_t GetThreadCount() const { return mPool.GetThreadCount(); }
+
+private:
+    TaskPool mPool;
+};
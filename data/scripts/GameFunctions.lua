@@ -1,3 +1,7 @@
+-- Engine functions the scripts can call (bound in Game::BindScriptFunctions):
+--   updateMusicVolume(volume), adjustMasterVolume(volume), adjustMusicVolume(volume),
+--   adjustGameVolume(volume), getMusicVolume(), getGameVolume()
+
 timer = 0
 
 -- start function (called once)
@@ -7,6 +11,10 @@ end
 
 -- update function (called every frame)
 function update(deltaTime)
+    local lastSecond = math.floor(timer)
     timer = timer + deltaTime
-    print("Elapsed time: " .. timer)
+    -- Only print as each second passes, printing every frame costs more than the rest of the script
+    if math.floor(timer) ~= lastSecond then
+        print("Elapsed time: " .. math.floor(timer))
+    end
 end
\ No newline at end of file
@@ -1,3 +1,31 @@
+-- These are read into the game once at startup and again whenever this file is saved
+-- while hotReloadScripts is on (or F5 is pressed in debug builds), changes show from the
+-- next game started.
+
+-- Game loop variables:
+-- tickRate: Number of fixed length ticks the game is updated in each second, whatever the frame rate.
+--   1 to 1000, anything else keeps the previous value.
+tickRate = 60
+-- maxCatchUpTicks: Most ticks run in a single frame after a stall, any more are skipped. At least 1.
+maxCatchUpTicks = 5
+-- hotReloadScripts: Rerun any script in data/scripts when it's saved, without restarting the game.
+hotReloadScripts = true
+
+-- Script budget variables:
+-- scriptInstructionBudget: Most Lua instructions the scripts may run each frame before they're stopped, 0 for no limit.
+scriptInstructionBudget = 1000000
+-- scriptTimeBudgetMs: Most milliseconds the scripts may take each frame before they're stopped, 0 for no limit.
+scriptTimeBudgetMs = 4
+-- profileScripts: Sample where the scripts spend their time, written to scriptProfileFile as folded stacks on exit.
+profileScripts = false
+scriptProfileFile = "script_profile.folded"
+
+-- Leaderboard variables:
+-- leaderboardServer: Address of the venue's LeaderboardDaemon ("tcp:host:port", or "unix:/path" off Windows), empty to keep scores local.
+leaderboardServer = ""
+-- cabinetName: Name this cabinet goes by on the shared leaderboard, each cabinet at a venue needs its own. Empty uses the machine's name.
+cabinetName = ""
+
 -- Player configuration variables:
 -- playerSprite variable: Defines the path to the sprite image used for the player's ship.
 playerSprite = "sprites/ship2.dds"
@@ -27,4 +55,10 @@ ufoInitialY = 50
 -- enemyDownstep: Specifies the vertical step enemies take when moving downward.
 enemyDownstep = 15
 -- enemyLimitOffset: Sets the horizontal movement limit offset for enemies.
-enemyLimitOffset = 25
\ No newline at end of file
+enemyLimitOffset = 25
+
+-- Testing variables:
+-- bulletHellProjectiles: Number of extra lasers the enemies keep in flight, 0 plays the normal game.
+bulletHellProjectiles = 0
+-- replayFile: Path each game's input is recorded to for ReplayTool, empty to not record.
+replayFile = ""
\ No newline at end of file
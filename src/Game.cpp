@@ -31,12 +31,27 @@ void Setup(Model& m, Mesh& source, float scale, const Vector3& pos, const Vector
 }
 
 // Game Constructor: Sets up the game, loads resources, and initializes modes.
-Game::Game(lua_State* L, Dispatcher& D) : mpLuaState(L), dispatchRef(D),
+Game::Game(lua_State* L) : mpLuaState(L),
 mpSB(nullptr), mpFont(nullptr)
 #if defined(DEBUG) || defined(_DEBUG)
     , mDebugData(WinUtil::Get().GetD3D())
 #endif
 {
+	// Snapshot the script variables before any mode is made that needs them.
+	mMonitor.Init(L);
+	LoadVars();
+	RequestTextures();
+	if (mVars.mHotReloadScripts && !mScripts.Start(GC::SCRIPTS_PATH))
+		DBOUT("Cannot watch " << GC::SCRIPTS_PATH << " for script changes\n");
+
+	// Look up the script functions we call every frame once, rather than by name on every call.
+	mCallbacks.Init(L);
+	mCallbacks.SetMonitor(&mMonitor);
+	mStartFunc = mCallbacks.Register("start");
+	mUpdateFunc = mCallbacks.Register("update");
+	mLerpFunc = mCallbacks.Register("lerpNumber");
+	BindScriptFunctions();
+
 	// Initialization of input handling, sprite batch, and fonts.
 	mMKIn.Initialize(WinUtil::Get().GetMainWnd(), true, false);
 	mpSB = new SpriteBatch(&WinUtil::Get().GetD3D().GetDeviceCtx());
@@ -99,12 +114,97 @@ void Game::Load()
     Setup(mModels[Modelid::WAREHOUSE], warehouseMesh, 0.00025f, Vector3(0, 0, 0), Vector3(0, PI / 2, PI / 2));
     mLoadData.mLoadedSoFar++;
 
-    LuaHelper::CallVoidVoidCFunc(mpLuaState, "start");
+    mCallbacks.Call(mStartFunc);
+}
+
+// ReloadVars function: Re-runs the variables script so edits to it are picked up without restarting.
+bool Game::ReloadVars()
+{
+    if (!LuaHelper::LuaOK(mpLuaState, luaL_dofile(mpLuaState, GC::GAME_VARIABLES_SCRIPT)))
+    {
+        lua_pop(mpLuaState, 1);  // Clean up the error message, LuaOK has already printed it
+        return false;
+    }
+
+    LoadVars();
+    return true;
+}
+
+// BeginFrame function: Anything the reloaded scripts set may have changed, so the snapshot is taken again.
+void Game::BeginFrame()
+{
+    if (mScripts.Apply(mpLuaState) > 0)
+    {
+        LoadVars();
+        mCallbacks.Resolve();  // The rerun scripts will have replaced their functions
+    }
+
+    mMonitor.BeginFrame();
+    mScoreSys.UpdateLeaderboard();
+
+    // Create any requested textures that have finished loading.
+    MyD3D& d3d = WinUtil::Get().GetD3D();
+    d3d.GetTexCache().Update(&d3d.GetDevice());
+}
+
+// BindScriptFunctions function: Each binding is a closure straight onto the C++ function, see LuaBind.h.
+void Game::BindScriptFunctions()
+{
+    LuaBind::Register(mpLuaState, "updateMusicVolume", this, &Game::UpdateMusicVolume);
+    LuaBind::Register(mpLuaState, "adjustMasterVolume", &mAudMgr, &AudioManager::AdjustMasterVolume);
+    LuaBind::Register(mpLuaState, "adjustMusicVolume", &mAudMgr, &AudioManager::AdjustMusicVolume);
+    LuaBind::Register(mpLuaState, "adjustGameVolume", &mAudMgr, &AudioManager::AdjustGameVolume);
+    LuaBind::Register(mpLuaState, "getMusicVolume", &mAudMgr, &AudioManager::GetMusicVolume);
+    LuaBind::Register(mpLuaState, "getGameVolume", &mAudMgr, &AudioManager::GetGameVolume);
+}
+
+// RequestTextures function: The modes and their objects load their textures as they're made, which
+// used to read each file in turn. Asking for them all first reads them side by side on the texture
+// loader's threads while the rest of the game starts. None of the modes wait for them, their sprites
+// pick them up once Update has created them (Sprite::BindTex), and PlayMode only starts the game
+// once its objects have theirs as the simulation is sized from them.
+void Game::RequestTextures()
+{
+    TexCache& cache = WinUtil::Get().GetD3D().GetTexCache();
+    const char* files[] = {
+        "sprites/octopus.dds", "sprites/crab.dds", "sprites/squid.dds", "sprites/ufo.dds",  // Enemy
+        "sprites/laser.dds", "sprites/missile.dds", "sprites/sheltersheet.dds",             // Enemy, Missile, ShelterManager
+        "sprites/black_square.dds", "ui/arrows.dds"                                         // PlayMode, SettingsMenuMode
+    };
+    for (const char* file : files)
+        cache.Request(file);
+
+    cache.Request(mVars.mPlayerSprite);
+    cache.Request(mVars.mBgnd01, "bgnd0");
+    cache.Request(mVars.mBgnd02, "bgnd1");
+#if defined(DEBUG) || defined(_DEBUG)
+    cache.Request("debug/collision.dds", "DebugTexture");
+#endif
+}
+
+// LoadVars function: The budget comes from the scripts, so it's set again whenever they're read.
+void Game::LoadVars()
+{
+    mVars.Load(mpLuaState);
+    mTimestep.SetTickRate((float)mVars.mTickRate);
+    mTimestep.SetMaxSteps(mVars.mMaxCatchUpTicks);
+    mMonitor.SetBudget(mVars.mScriptInstructionBudget, mVars.mScriptTimeBudgetMs / 1000.0);
+    mMonitor.SetProfiling(mVars.mProfileScripts);
+    mScoreSys.ConnectLeaderboard(mVars.mLeaderboardServer, mVars.mCabinetName);
 }
 
 // Release function: Cleans up resources like sprite batch, font, and mode manager.
 void Game::Release()
 {
+    // Stop watching the scripts before anything they could touch goes.
+    mScripts.Stop();
+    mCallbacks.Release();
+
+    // Keep what the scripts were profiled doing, then take the hook out.
+    if (mMonitor.IsProfiling() && !mMonitor.WriteFolded(mVars.mScriptProfileFile))
+        DBOUT("Cannot write " << mVars.mScriptProfileFile << "\n");
+    mMonitor.Release();
+
     // Safely release the sprite batch and font resources.
     delete mpSB;
     mpSB = nullptr;
@@ -130,7 +230,7 @@ void Game::Update(float dTime)
     mGamepad.Update(dTime);
     mAudMgr.Update();
 
-    LuaHelper::CallVoidVoidCFunc(mpLuaState, "update", dTime);
+    mCallbacks.Call(mUpdateFunc, dTime);
 
     mMMgr.Update(dTime);
 
@@ -163,6 +263,10 @@ void Game::Update(float dTime)
 // Render function: Renders the game's 2D and 3D elements.
 void Game::Render(float dTime)
 {
+#if defined(DEBUG) || defined(_DEBUG)
+    mDebugData.UpdateFps(dTime);
+#endif
+
     // If the game is still loading, render the loading screen instead of the game.
     if (mLoadData.mRunning)
     {
@@ -282,7 +386,7 @@ void Game::LoadData::Render(float dTime, SpriteBatch& batch)
     // Calculate the current fill amount for the loading bar based on the number of loaded models.
     // This interpolates the fill amount smoothly for a more visually pleasing loading bar.
     // Uses a Lua UtilityFunctions.lua script
-    mCurrentFillAmt = LuaHelper::LuaFLerpNum(Game::Get().GetLuaState(), "lerpNumber", mCurrentFillAmt, mMaxFillAmt * ((float)mLoadedSoFar / (float)mTotalToLoad), dTime * 3);
+    mCurrentFillAmt = Game::Get().mCallbacks.CallNum(Game::Get().mLerpFunc, mCurrentFillAmt, mMaxFillAmt * ((float)mLoadedSoFar / (float)mTotalToLoad), dTime * 3);
 
     // Update the texture rectangle for the loading fill to reflect the current progress.
     mLoadFill.SetTexRect({ mLoadFillRect.left, mLoadFillRect.top, mCurrentFillAmt, mLoadFillRect.bottom });
@@ -346,6 +450,12 @@ Game::DebugData::DebugData(MyD3D& d3d)
     mFpsText->SetFont(*retrotechSF);
     mFpsText->mPos = Vector2((float)w / 2.0f, (float)h * 0.95f);
     mFpsText->mActive = true;
+
+    mScriptText = new Text(d3d);
+    mScriptText->SetFont(*retrotechSF);
+    mScriptText->mPos = Vector2((float)w * 0.01f, (float)h * 0.8f);
+    mScriptText->scale = 0.5f;
+    mScriptText->mActive = true;
 }
 
 // UpdateDebug function: Updates debug information on the screen in real-time.
@@ -357,6 +467,33 @@ void Game::DebugData::UpdateDebug(float dTime)
         gm.mGamepad.IsConnected() && gm.mGamepad.GetButtonDown(XBtns.Y) && gm.mGamepad.RightStickX() > 0.9f)
         mDebugDrawColliders = !mDebugDrawColliders;
 
+    // Pick up edits to the variables script, they show from the next game
+    if (gm.mMKIn.IsDown(VK_F5))
+        gm.ReloadVars();
+
+    // Average time per call of each script callback, and how many calls that's over
+    const ScriptCallbacks& callbacks = gm.GetCallbacks();
+    std::stringstream ss;
+    for (size_t i = 0; i < callbacks.Size(); i++)
+    {
+        const ScriptCallbacks::Callback& cb = callbacks.Get((ScriptCallbacks::Id)i);
+        double avgUs = cb.mCalls ? cb.mTotalTime * 1e6 / cb.mCalls : 0.0;
+        std::string name = cb.mName;
+        for (char& c : name)
+            c = (char)toupper(c);  // The font is upper case only
+        ss << name << ": " << cb.mCalls << " CALLS, " << (int)avgUs << " US AVG";
+        if (cb.mSkipped)
+            ss << ", " << cb.mSkipped << " OVER BUDGET";
+        ss << "\n";
+    }
+    const ScriptMonitor& monitor = gm.GetScriptMonitor();
+    ss << "FRAME: " << monitor.GetFrameInstructions() << " INSTRUCTIONS, " << (int)(monitor.GetFrameTime() * 1e6) << " US\n";
+    mScriptText->mString = ss.str();
+}
+
+// UpdateFps function: Once a frame with the frame's time, so it shows the real frame rate.
+void Game::DebugData::UpdateFps(float dTime)
+{
     mFpsText->mString = "FPS: ";
     mFpsText->mString += std::to_string((int)(1.0f / dTime));
     mFpsText->CentreOriginX();
@@ -366,5 +503,6 @@ void Game::DebugData::UpdateDebug(float dTime)
 void Game::DebugData::RenderDebug(float dTime, SpriteBatch& batch) const
 {
     mFpsText->Draw(batch);
+    mScriptText->Draw(batch);
 }
 #endif
\ No newline at end of file
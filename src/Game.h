@@ -16,6 +16,12 @@
 #include "constants.h"
 #include "Text.h"
 #include "LuaHelper.h"
+#include "LuaBind.h"
+#include "GameVariables.h"
+#include "ScriptReloader.h"
+#include "ScriptCallbacks.h"
+#include "ScriptMonitor.h"
+#include "FixedTimestep.h"
 
 
 // Game class: Represents the main game, handling inputs, modes, rendering, and updates.
@@ -25,7 +31,7 @@ public:
 	MouseAndKeys mMKIn;  // Handle mouse and keyboard inputs specific to the game.
 	Gamepad mGamepad;    // Handle controller/joystick inputs.
 
-	Game(lua_State* L, Dispatcher& D);    // Constructor: Initializes the game and starts resources loading.
+	Game(lua_State* L);    // Constructor: Initializes the game and starts resources loading.
 	~Game() {  // Destructor: Ensures that resources are released.
 		Release();  
 	}
@@ -33,12 +39,17 @@ public:
 	void Load();     // Load: Create meshes for our imported 3D models.
 	void Release();  // Release: Free up any dynamically created objects.
 
-	// Update: Game logic that needs to happen per frame.
+	// Update: Game logic that needs to happen per tick, dTime is always the fixed tick length.
 	void Update(float dTime);
 
 	// Render: Drawing sprites or triangles to the screen per frame.
 	void Render(float dTime);
 
+	// Interpolation: How far the frame being rendered is between the last two ticks (0 to 1),
+	// moving sprites are drawn this far from their previous position to their current one.
+	void SetInterpolation(float alpha) { mInterpolation = alpha; }
+	float GetInterpolation() const { return mInterpolation; }
+
 	// ProcessKey: Handle any key inputs, specifically text input and not mMKIn.
 	void ProcessKey(char key) {
 		mMMgr.ProcessKey(key);
@@ -48,9 +59,25 @@ public:
 	ModeMgr& GetModeMgr() { return mMMgr; }
 	AudioManager& GetAudMgr() { return mAudMgr; }
 	ScoreSystem& GetScoreSys() { return mScoreSys; }
-	Dispatcher& GetDispatcher() { return dispatchRef; }
 	DirectX::SpriteFont* GetFont() { return mpFont; }
 	lua_State* GetLuaState() { return mpLuaState; }
+	ScriptCallbacks& GetCallbacks() { return mCallbacks; }
+	ScriptMonitor& GetScriptMonitor() { return mMonitor; }
+
+	// GetVars: The script variables as they were when the game started or last reloaded.
+	const GameVariables& GetVars() const { return mVars; }
+
+	// GetTimestep: The main loop's ticks, set from the variables again whenever they're reloaded.
+	FixedTimestep& GetTimestep() { return mTimestep; }
+
+	// ReloadVars: Runs GameVariables.lua again and takes a new snapshot of it, returns false
+	// and keeps the old one if the script fails. Changes show from the next game started.
+	bool ReloadVars();
+
+	// BeginFrame: Runs any scripts saved since the last frame, taking a new snapshot of the variables
+	// if there were any, gives the scripts a fresh budget and talks to the shared leaderboard. Call between
+	// frames, never in the middle of one.
+	void BeginFrame();
 
 	// ChangeBackgroundColour: Update the background color of the game.
 	void ChangeBackgroundColour(DirectX::SimpleMath::Vector4 colour) {
@@ -75,10 +102,12 @@ public:
 	{
 		DebugData(MyD3D& d3d);
 		void UpdateDebug(float dTime);  // UpdateDebug: Update any debug logic, e.g. DrawCollisions toggle boolean with L Key
+		void UpdateFps(float dTime);    // UpdateFps: Takes the frame's time, not a tick's, Update runs at the tick rate.
 		void RenderDebug(float dTime, DirectX::SpriteBatch& batch) const;  // RenderDebug: Overlays debug information.
 
 		bool mDebugDrawColliders = false;
 		Text* mFpsText = nullptr;
+		Text* mScriptText = nullptr;  // What each script callback costs.
 		std::stringstream mFPSSS;
 	};
 
@@ -130,7 +159,20 @@ private:
 	ScoreSystem mScoreSys;  // Manages the scoring system.
 
 	lua_State* mpLuaState = nullptr;
-	Dispatcher& dispatchRef;
+	GameVariables mVars;  // Snapshot of GameVariables.lua, read once instead of every time it's needed.
+	ScriptReloader mScripts;  // Watches the scripts for changes when hot reloading is on.
+	ScriptCallbacks mCallbacks;  // Script functions called every frame, resolved once.
+	ScriptCallbacks::Id mStartFunc = 0;
+	ScriptCallbacks::Id mUpdateFunc = 0;
+	ScriptCallbacks::Id mLerpFunc = 0;
+	ScriptMonitor mMonitor;  // Keeps the callbacks to their budget and profiles them.
+	FixedTimestep mTimestep;
+
+	void LoadVars();  // LoadVars: Takes the variables snapshot and applies the tick rate, script budget and leaderboard server from it.
+	void BindScriptFunctions();  // BindScriptFunctions: Exposes the engine functions the scripts can call.
+	void RequestTextures();      // RequestTextures: Starts loading the textures the modes use before any mode is made.
+
+	float mInterpolation = 1.0f;  // Set by the main loop before every Render.
 
 	// Songs
 	DirectX::SoundEffectInstance* automationSong = nullptr;
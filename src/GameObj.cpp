@@ -5,42 +5,20 @@ using namespace DirectX::SimpleMath;
 
 
 #if defined(DEBUG) || (_DEBUG)
-// Constructor for BoundBox: Initializes the debug sprite for visualizing the bounding box.
+// Constructor for BoundBox: Requests the debug sprite's texture, DebugDraw sets it once it has loaded.
 BoundBox::BoundBox()
     : mDebugBoxSpr(WinUtil::Get().GetD3D())
 {
-    MyD3D& d3d = WinUtil::Get().GetD3D();
-    // Load the debug texture for drawing the bounding box.
-    ID3D11ShaderResourceView* p = d3d.GetTexCache().LoadTexture(&d3d.GetDevice(), "debug/collision.dds", "DebugTexture");
-    assert(p && "Failed to load debug texture");
+    mDebugBoxSpr.RequestTex("debug/collision.dds", "DebugTexture");
     mDebugBoxSpr.SetScale(Vector2(1.0f, 1.0f));
-    mDebugBoxSpr.SetTex(*p);
-    mDebugBoxSpr.origin = mDebugBoxSpr.GetTexData().dim / 2.0f;
     mDebugBoxSpr.rotation = PI * 10.0f;
 }
 #endif
 
-// UpdateBox function: Updates the bounding box with specific edges.
-void BoundBox::UpdateBox(float _left, float _top, float _right, float _bottom)
-{
-    // Set the bounding box edges directly.
-    mLeft = _left;
-    mTop = _top;
-    mRight = _right;
-    mBottom = _bottom;
-}
-
 // UpdateBox function (overloaded): Updates the bounding box based on a central position and size.
-void BoundBox::UpdateBox(Vector2& _pos, Vector2& _screenSize, float _uniformScale, bool _isOriginCentred)
+void BoundBox::UpdateBox(const Vector2& _pos, const Vector2& _screenSize, float _uniformScale, bool _isOriginCentred)
 {
-    // Adjust the box dimensions based on the center and scale.
-    _screenSize = (_isOriginCentred ? _screenSize / 2.0f : _screenSize) * _uniformScale;
-
-    // Calculate the new edges of the bounding box.
-    mLeft = _pos.x - _screenSize.x;
-    mTop = _pos.y - _screenSize.y;
-    mRight = _pos.x + _screenSize.x;
-    mBottom = _pos.y + _screenSize.y;
+    SimBox::UpdateBox(SimVec2(_pos.x, _pos.y), SimVec2(_screenSize.x, _screenSize.y), _uniformScale, _isOriginCentred);
 }
 
 #if defined(DEBUG) || (_DEBUG)
@@ -52,6 +30,14 @@ void BoundBox::DebugDraw(SpriteBatch& batch)
     if (!Game::Get().mDebugData.mDebugDrawColliders)
         return;
 
+    // Nothing to draw until the debug texture has loaded.
+    if (!mDebugBoxSpr.HasTex())
+    {
+        if (!mDebugBoxSpr.BindTex())
+            return;
+        mDebugBoxSpr.origin = mDebugBoxSpr.GetTexData().dim / 2.0f;
+    }
+
     // Calculate scales for width and height based on the bounding box dimensions.
     float adjustedWidth = mRight - mLeft;
     float adjustedHeight = mBottom - mTop;
@@ -2,12 +2,14 @@
 
 #include "Sprite.h"
 #include "D3D.h"
+#include "SimTypes.h"
 
 
 // BoundBox Struct: Represents a bounding box for collision detection. 
 // It is based on the sprite's position and size on the screen. 
+// The edges and overlap test live in the simulation's SimBox.
 // In debug mode, it includes visual debugging capabilities.
-struct BoundBox
+struct BoundBox : public SimBox
 {
 public:
 #if defined(DEBUG) || (_DEBUG)
@@ -15,15 +17,18 @@ public:
     BoundBox();
 #endif
 
-    // Updates the bounding box edges to specified coordinates.
-    void UpdateBox(float _left, float _top, float _right, float _bottom);
+    using SimBox::UpdateBox;
 
     // Updates the bounding box based on its position and size.
     // The _uniformScale parameter allows for scaling the bounding box size.
     // The _isOriginCentred parameter indicates if the sprite's origin is centred.
-    void UpdateBox(DirectX::SimpleMath::Vector2& _pos, DirectX::SimpleMath::Vector2& _screenSize, float _uniformScale = 1.0f, bool _isOriginCentred = true);
+    void UpdateBox(const DirectX::SimpleMath::Vector2& _pos, const DirectX::SimpleMath::Vector2& _screenSize, float _uniformScale = 1.0f, bool _isOriginCentred = true);
 
-    float mLeft = 0, mTop = 0, mRight = 0, mBottom = 0;  // Edges of the bounding box.
+    // Copies the edges of a box from the simulation.
+    BoundBox& operator=(const SimBox& rhs) {
+        SimBox::operator=(rhs);
+        return *this;
+    }
 
 #if defined(DEBUG) || (_DEBUG)
     // DebugDraw method: Renders a visual representation of the bounding box for debugging.
@@ -51,6 +56,10 @@ public:
 #endif
     }
 
+    // BindTextures function: Sets the textures the object requested once they've loaded, never waits for them.
+    // True once they're all set, the object's sizes can't be used until then.
+    virtual bool BindTextures() { return mSpr.BindTex(); }
+
     // SetPosition function: Sets the position of the game object.
     void SetPosition(DirectX::SimpleMath::Vector2 _pos) { mSpr.mPos = _pos; }
 
@@ -0,0 +1,75 @@
+#include "GameVariables.h"
+
+#include "LuaHelper.h"
+
+#include <cassert>
+#include <climits>
+#include <iostream>
+
+using namespace std;
+
+
+// GetInRange function: A value the game can't run with keeps the old one, a tick rate of 0 would never tick.
+static int GetInRange(lua_State* L, const char* name, int current, int min, int max)
+{
+	int value = LuaHelper::LuaGetInt(L, name, current);
+	if (value >= min && value <= max)
+		return value;
+
+	cout << name << " = " << value << " is out of range (" << min << " to " << max << "), keeping " << current << endl;
+	return current;
+}
+
+// Load function: Reads each global through LuaHelper, passing the current value as the default.
+void GameVariables::Load(lua_State* L)
+{
+	assert(L);
+	int top = lua_gettop(L);
+
+	mTickRate = GetInRange(L, "tickRate", mTickRate, 1, MAX_TICK_RATE);
+	mMaxCatchUpTicks = GetInRange(L, "maxCatchUpTicks", mMaxCatchUpTicks, 1, INT_MAX);
+	mHotReloadScripts = LuaHelper::LuaGetBool(L, "hotReloadScripts", mHotReloadScripts);
+
+	mScriptInstructionBudget = LuaHelper::LuaGetInt(L, "scriptInstructionBudget", mScriptInstructionBudget);
+	mScriptTimeBudgetMs = LuaHelper::LuaGetNum(L, "scriptTimeBudgetMs", mScriptTimeBudgetMs);
+	mProfileScripts = LuaHelper::LuaGetBool(L, "profileScripts", mProfileScripts);
+	mScriptProfileFile = LuaHelper::LuaGetStr(L, "scriptProfileFile", mScriptProfileFile);
+
+	mLeaderboardServer = LuaHelper::LuaGetStr(L, "leaderboardServer", mLeaderboardServer);
+	mCabinetName = LuaHelper::LuaGetStr(L, "cabinetName", mCabinetName);
+
+	mPlayerSprite = LuaHelper::LuaGetStr(L, "playerSprite", mPlayerSprite);
+	mPlayerLifes = LuaHelper::LuaGetInt(L, "playerLifes", mPlayerLifes);
+
+	mBgnd01 = LuaHelper::LuaGetStr(L, "bgnd_01", mBgnd01);
+	mBgnd02 = LuaHelper::LuaGetStr(L, "bgnd_02", mBgnd02);
+
+	mEnemiesPerRow = LuaHelper::LuaGetInt(L, "enemiesPerRow", mEnemiesPerRow);
+	mNumOfRows = LuaHelper::LuaGetInt(L, "numOfRows", mNumOfRows);
+	mRowXSpacing = LuaHelper::LuaGetInt(L, "rowXSpacing", mRowXSpacing);
+	mRowYSpacing = LuaHelper::LuaGetInt(L, "rowYSpacing", mRowYSpacing);
+	mEnemyInitialY = LuaHelper::LuaGetInt(L, "enemyInitialY", mEnemyInitialY);
+	mUfoInitialY = LuaHelper::LuaGetInt(L, "ufoInitialY", mUfoInitialY);
+	mEnemyDownstep = LuaHelper::LuaGetInt(L, "enemyDownstep", mEnemyDownstep);
+	mEnemyLimitOffset = LuaHelper::LuaGetInt(L, "enemyLimitOffset", mEnemyLimitOffset);
+
+	mBulletHellProjectiles = LuaHelper::LuaGetInt(L, "bulletHellProjectiles", mBulletHellProjectiles);
+	mReplayFile = LuaHelper::LuaGetStr(L, "replayFile", mReplayFile);
+
+	assert(lua_gettop(L) == top);  // Every getter must pop what it pushed
+}
+
+// ApplyTo function: Only the script side of the config, the window and sprite sizes come from the renderer.
+void GameVariables::ApplyTo(SimConfig& config) const
+{
+	config.mPlayerLifes = mPlayerLifes;
+	config.mEnemiesPerRow = mEnemiesPerRow;
+	config.mNumOfRows = mNumOfRows;
+	config.mRowXSpacing = mRowXSpacing;
+	config.mRowYSpacing = mRowYSpacing;
+	config.mEnemyInitialY = mEnemyInitialY;
+	config.mUfoInitialY = mUfoInitialY;
+	config.mEnemyDownstep = mEnemyDownstep;
+	config.mEnemyLimitOffset = mEnemyLimitOffset;
+	config.mBulletHellProjectiles = mBulletHellProjectiles;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+
+#include "SimConfig.h"
+
+struct lua_State;
+
+
+// GameVariables struct: A typed snapshot of the tunables in GameVariables.lua.
+// It is read from the Lua globals once when the game starts and again only when
+// asked to reload, so gameplay code reads plain members instead of looking names
+// up in the Lua state every frame. Defaults are used for anything the scripts don't set.
+struct GameVariables
+{
+    static const int MAX_TICK_RATE = 1000;
+
+    // Game loop
+    int mTickRate = 60;        // Fixed ticks per second, 1 to MAX_TICK_RATE.
+    int mMaxCatchUpTicks = 5;  // Most ticks run in one frame after a stall, at least 1.
+    bool mHotReloadScripts = true;  // Rerun scripts when they're saved while the game is running.
+
+    // Script budget
+    int mScriptInstructionBudget = 1000000;  // Most Lua instructions the scripts may run each frame, 0 for no limit.
+    float mScriptTimeBudgetMs = 4.0f;        // Most milliseconds the scripts may take each frame, 0 for no limit.
+    bool mProfileScripts = false;            // Sample where the scripts spend their time.
+    std::string mScriptProfileFile = "script_profile.folded";  // Where the samples are written when the game closes.
+
+    // Leaderboard
+    std::string mLeaderboardServer;         // Address of the venue's LeaderboardDaemon, empty to keep scores local.
+    std::string mCabinetName;               // Name this cabinet goes by, has to differ from every other cabinet's. Empty uses the host name.
+
+    // Player
+    std::string mPlayerSprite = "sprites/ship.dds";    // Sprite of the player's ship.
+    int mPlayerLifes = GC::PLAYER_LIFES;               // Lifes the player starts with.
+
+    // Background layers
+    std::string mBgnd01 = "background_layers/background01_001.dds";  // Back layer of the parallax.
+    std::string mBgnd02 = "background_layers/background01_002.dds";  // Front layer of the parallax.
+
+    // Enemies
+    int mEnemiesPerRow = GC::ENEMIES_PER_ROW;
+    int mNumOfRows = GC::NUM_ROWS;
+    int mRowXSpacing = GC::ROWX_SPACING;
+    int mRowYSpacing = GC::ROWY_SPACING;
+    int mEnemyInitialY = GC::ENEMY_INITIAL_Y;
+    int mUfoInitialY = GC::UFO_INITIAL_Y;
+    int mEnemyDownstep = GC::ENEMY_DOWNSTEP;
+    int mEnemyLimitOffset = GC::ENEMY_LIMIT_OFFSET;
+
+    // Testing
+    int mBulletHellProjectiles = 0;  // Extra lasers kept in flight, 0 plays the normal game.
+    std::string mReplayFile;         // Where each game is recorded to, empty to not record.
+
+    // Load function: Reads every variable from the Lua globals, leaving the Lua stack as it found it.
+    // Variables that are missing or the wrong type keep the value they had.
+    void Load(lua_State* L);
+
+    // ApplyTo function: Copies the gameplay variables into a simulation config.
+    void ApplyTo(SimConfig& config) const;
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <type_traits>
+
+// Required Lua libraries
+extern "C"
+{
+#include <lua.h>
+#include <lauxlib.h>
+}
+
+
+// LuaBind namespace: Exposes C++ functions and member functions to the scripts.
+//
+//   LuaBind::Register(L, "adjustGameVolume", &audioManager, &AudioManager::AdjustGameVolume);
+//   -- then in Lua: adjustGameVolume(0.5)
+//
+// Each registration makes a Lua C closure whose single upvalue is a userdata holding the
+// function (and object) to call, and whose C function is a thunk stamped out for that
+// exact signature. A call reads the upvalue, converts each argument straight off the
+// stack with the Marshal for its type and calls the function, so there's no name lookup,
+// no std::function and nothing allocated. Wrong argument types raise a Lua error
+// naming the argument, the same as Lua's own library functions.
+//
+// Lua raises errors with longjmp (it's built as C), which skips C++ destructors. So every
+// argument is checked before any is converted, and Get never raises: nothing with a
+// destructor (a std::string argument) exists yet when an error can be raised.
+namespace LuaBind
+{
+    // Marshal struct: Converts a C++ type to and from the Lua stack, specialised for each supported type.
+    // Check raises the Lua error for a wrong argument, Get converts one that has passed Check.
+    template<class T, class Enable = void>
+    struct Marshal;
+
+    template<class T>
+    struct Marshal<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    {
+        static void Check(lua_State* L, int idx) { luaL_checkinteger(L, idx); }
+        static T Get(lua_State* L, int idx) { return (T)lua_tointeger(L, idx); }
+        static void Push(lua_State* L, T v) { lua_pushinteger(L, (lua_Integer)v); }
+    };
+
+    template<class T>
+    struct Marshal<T, std::enable_if_t<std::is_floating_point_v<T>>>
+    {
+        static void Check(lua_State* L, int idx) { luaL_checknumber(L, idx); }
+        static T Get(lua_State* L, int idx) { return (T)lua_tonumber(L, idx); }
+        static void Push(lua_State* L, T v) { lua_pushnumber(L, (lua_Number)v); }
+    };
+
+    template<>
+    struct Marshal<bool>
+    {
+        static void Check(lua_State*, int) {}  // Anything is true or false
+        static bool Get(lua_State* L, int idx) { return lua_toboolean(L, idx) != 0; }
+        static void Push(lua_State* L, bool v) { lua_pushboolean(L, v); }
+    };
+
+    template<>
+    struct Marshal<const char*>
+    {
+        static void Check(lua_State* L, int idx) { luaL_checkstring(L, idx); }
+        static const char* Get(lua_State* L, int idx) { return lua_tostring(L, idx); }
+        static void Push(lua_State* L, const char* v) { lua_pushstring(L, v); }
+    };
+
+    // Strings are only valid during the call, as Lua owns them, copy one to keep it.
+    template<>
+    struct Marshal<std::string_view>
+    {
+        static void Check(lua_State* L, int idx) { luaL_checkstring(L, idx); }
+        static std::string_view Get(lua_State* L, int idx) {
+            size_t len;
+            const char* s = lua_tolstring(L, idx, &len);
+            return std::string_view(s, len);
+        }
+        static void Push(lua_State* L, std::string_view v) { lua_pushlstring(L, v.data(), v.size()); }
+    };
+
+    // Copies the string, so the only marshal that allocates, prefer string_view for arguments.
+    template<>
+    struct Marshal<std::string>
+    {
+        static void Check(lua_State* L, int idx) { luaL_checkstring(L, idx); }
+        static std::string Get(lua_State* L, int idx) { return std::string(Marshal<std::string_view>::Get(L, idx)); }
+        static void Push(lua_State* L, const std::string& v) { lua_pushlstring(L, v.data(), v.size()); }
+    };
+
+    template<class T>
+    using Bare = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    // Invoke function: Calls f with its arguments read from the stack (1..n), pushing any result.
+    // Every argument is checked first, see the top of the file for why.
+    template<class F, class R, class... A, size_t... I>
+    int Invoke(lua_State* L, const F& f, std::index_sequence<I...>)
+    {
+        (Marshal<Bare<A>>::Check(L, (int)I + 1), ...);
+
+        if constexpr (std::is_void_v<R>)
+        {
+            f(Marshal<Bare<A>>::Get(L, (int)I + 1)...);
+            return 0;
+        }
+        else
+        {
+            Marshal<Bare<R>>::Push(L, f(Marshal<Bare<A>>::Get(L, (int)I + 1)...));
+            return 1;
+        }
+    }
+
+    // Bound struct: What a closure's upvalue holds, the function and the object to call it on if it's a member.
+    template<class F>
+    struct BoundFunction
+    {
+        F mFunc;
+    };
+
+    template<class C, class F>
+    struct BoundMember
+    {
+        C* mObj;
+        F mFunc;
+    };
+
+    // Thunks: One per signature, they unpack the upvalue and hand over to Invoke.
+    template<class R, class... A>
+    int FunctionThunk(lua_State* L)
+    {
+        auto* pBound = static_cast<BoundFunction<R(*)(A...)>*>(lua_touserdata(L, lua_upvalueindex(1)));
+        return Invoke<R(*)(A...), R, A...>(L, pBound->mFunc, std::index_sequence_for<A...>{});
+    }
+
+    template<class C, class M, class R, class... A>
+    int MemberThunk(lua_State* L)
+    {
+        auto* pBound = static_cast<BoundMember<C, M>*>(lua_touserdata(L, lua_upvalueindex(1)));
+        auto call = [pBound](auto&&... args) -> R { return (pBound->mObj->*pBound->mFunc)(std::forward<decltype(args)>(args)...); };
+        return Invoke<decltype(call), R, A...>(L, call, std::index_sequence_for<A...>{});
+    }
+
+    // PushClosure function: Copies the bound function into a new userdata, the closure's upvalue.
+    // The userdata lives as long as the closure, so this is the only allocation a binding ever makes.
+    template<class Bound>
+    void PushClosure(lua_State* L, const Bound& bound, lua_CFunction thunk)
+    {
+        static_assert(std::is_trivially_destructible_v<Bound>, "Lua won't run destructors of upvalue data");
+        new (lua_newuserdatauv(L, sizeof(Bound), 0)) Bound(bound);
+        lua_pushcclosure(L, thunk, 1);
+    }
+
+    // Register function: Exposes a free (or static member) function as a Lua global.
+    template<class R, class... A>
+    void Register(lua_State* L, const char* name, R(*func)(A...))
+    {
+        PushClosure(L, BoundFunction<R(*)(A...)>{ func }, &FunctionThunk<R, A...>);
+        lua_setglobal(L, name);
+    }
+
+    // Register function: Exposes a member function, called on obj, which must outlive the Lua state's use of it.
+    template<class C, class R, class... A>
+    void Register(lua_State* L, const char* name, C* obj, R(C::*func)(A...))
+    {
+        typedef R(C::*M)(A...);
+        PushClosure(L, BoundMember<C, M>{ obj, func }, &MemberThunk<C, M, R, A...>);
+        lua_setglobal(L, name);
+    }
+
+    template<class C, class R, class... A>
+    void Register(lua_State* L, const char* name, const C* obj, R(C::*func)(A...) const)
+    {
+        typedef R(C::*M)(A...) const;
+        PushClosure(L, BoundMember<const C, M>{ obj, func }, &MemberThunk<const C, M, R, A...>);
+        lua_setglobal(L, name);
+    }
+}
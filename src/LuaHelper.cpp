@@ -1,7 +1,5 @@
 #include "LuaHelper.h"
 
-#include "Game.h"
-
 #include <assert.h>
 #include <iostream>
 
@@ -32,7 +30,10 @@ void LuaHelper::CallVoidVoidCFunc(lua_State* L, const string& fName)
         assert(false); // Assert if not a function
 
     if (!LuaOK(L, lua_pcall(L, 0, 0, 0)))
+    {
+        lua_pop(L, 1); // Clean up the error message
         assert(false); // Call the function and assert on failure
+    }
 }
 
 // CallVoidVoidCFunc function: Call a Lua function by name, passing a single float parameter.
@@ -46,7 +47,10 @@ void LuaHelper::CallVoidVoidCFunc(lua_State* L, const string& fName, float numbe
     lua_pushnumber(L, number); // Push the float parameter onto the Lua stack
 
     if (!LuaOK(L, lua_pcall(L, 1, 0, 0)))
+    {
+        lua_pop(L, 1); // Clean up the error message
         assert(false); // Call the function and assert on failure
+    }
 }
 
 // LuaFRandomNum function: Return a random number from a Lua function, specifying a range.
@@ -116,76 +120,39 @@ int LuaHelper::CustomPrint(lua_State* L)
     return 0;
 }
 
-// LuaUpdateMusicVol function: Update the game music volume based on a value provided by a Lua script.
-int LuaHelper::LuaUpdateMusicVol(lua_State* L)
-{
-    float newVolume = (float)lua_tonumber(L, 1); // Retrieve new volume level from Lua stack
-
-    Game::Get().UpdateMusicVolume(newVolume); // Update game music volume
-
-    lua_pop(L, 1); // Clean up the Lua stack
-    return 1; // Return success
-}
-
-// LuaAdjustMasterVol function: Adjust the master volume across the game based on a Lua function call.
-int LuaHelper::LuaAdjustMasterVol(lua_State* L)
-{
-    float newVolume = (float)lua_tonumber(L, 1); // Retrieve the new volume level from Lua
-
-    Game::Get().GetAudMgr().AdjustMasterVolume(newVolume); // Adjust the master volume
-
-    lua_pop(L, 1); // Clean up the Lua stack
-    return 1; // Return success
-}
-
-// LuaAdjustMusicVol function: Adjust the music volume across the game based on a Lua function call.
-int LuaHelper::LuaAdjustMusicVol(lua_State* L)
-{
-    float newVolume = (float)lua_tonumber(L, 1); // Retrieve the new volume level from Lua
-
-    Game::Get().GetAudMgr().AdjustMusicVolume(newVolume); // Adjust the music volume
-
-    lua_pop(L, 1); // Clean up the Lua stack
-    return 1; // Return success
-}
+// ******VARIABLES*******
 
-// LuaAdjustGameVol function: Adjust the game volume across the game based on a Lua function call.
-int LuaHelper::LuaAdjustGameVol(lua_State* L)
+// LuaGetInt function: Return an int from a Lua script based on a variable name.
+int LuaHelper::LuaGetInt(lua_State* L, const string& name, const int& default)
 {
-    float newVolume = (float)lua_tonumber(L, 1); // Retrieve the new volume level from Lua
+    lua_getglobal(L, name.c_str()); // Retrieve Lua variable by name
 
-    Game::Get().GetAudMgr().AdjustGameVolume(newVolume); // Adjust the game volume
+    int value = lua_isinteger(L, -1) ? (int)lua_tointeger(L, -1) : default;
 
     lua_pop(L, 1); // Clean up the Lua stack
-    return 1; // Return success
+    return value; // Return the retrieved integer
 }
 
-// ******VARIABLES*******
-
-// LuaGetInt function: Return an int from a Lua script based on a variable name.
-int LuaHelper::LuaGetInt(lua_State* L, const string& name, const int& default)
+// LuaGetNum function: Return a float from a Lua script based on a variable name.
+float LuaHelper::LuaGetNum(lua_State* L, const string& name, const float& default)
 {
     lua_getglobal(L, name.c_str()); // Retrieve Lua variable by name
 
-    if (!lua_isinteger(L, -1))
-    {
-        return default;
-    }
+    float value = lua_isnumber(L, -1) ? (float)lua_tonumber(L, -1) : default;
 
-    return (int)lua_tointeger(L, -1); // Return the retrieved integer
+    lua_pop(L, 1); // Clean up the Lua stack
+    return value; // Return the retrieved number
 }
 
-// LuaGetNum function: Return a float from a Lua script based on a variable name.
-float LuaHelper::LuaGetNum(lua_State* L, const string& name, const float& default)
+// LuaGetBool function: Return a bool from a Lua script based on a variable name.
+bool LuaHelper::LuaGetBool(lua_State* L, const string& name, const bool& default)
 {
     lua_getglobal(L, name.c_str()); // Retrieve Lua variable by name
 
-    if (!lua_isnumber(L, -1))
-    {
-        return default;
-    }
+    bool value = lua_isboolean(L, -1) ? lua_toboolean(L, -1) != 0 : default;
 
-    return (float)lua_tonumber(L, -1); // Return the retrieved number
+    lua_pop(L, 1); // Clean up the Lua stack
+    return value; // Return the retrieved bool
 }
 
 // LuaGetStr function: Return a string from a Lua script based on a variable name.
@@ -193,12 +160,10 @@ string LuaHelper::LuaGetStr(lua_State* L, const string& name, const string& defa
 {
     lua_getglobal(L, name.c_str()); // Retrieve Lua variable by name
 
-    if (!lua_isstring(L, -1))
-    {
-        return default;
-    }
+    string value = lua_isstring(L, -1) ? lua_tostring(L, -1) : default; // Copy before popping, Lua owns the string
 
-    return lua_tostring(L, -1); // Return the retrieved string
+    lua_pop(L, 1); // Clean up the Lua stack
+    return value; // Return the retrieved string
 }
 
 // LuaGetVec2 function: Return a vector from a Lua script based on a variable name.
@@ -217,40 +182,7 @@ Vector2 LuaHelper::LuaGetVec2(lua_State* L, const string& name)
     lua_pushstring(L, "y");
     lua_gettable(L, -2); // Retrieve 'y' component
     int y = (int)lua_tointeger(L, -1);
-    lua_pop(L, 1); // Clean up 'y' component
+    lua_pop(L, 2); // Clean up 'y' component and the table
 
     return Vector2((float)x, (float)y); // Return the constructed Vector2
 }
-
-// Static member initialization: Stores all registered commands accessible by function name.
-map<string, Dispatcher::Command> Dispatcher::library;
-
-// LuaCall function: Called from Lua to dispatch the request to the corresponding C++ function.
-int Dispatcher::LuaCall(lua_State* L)
-{
-    // Retrieve the function name from the first argument passed from Lua.
-    string fName = lua_tostring(L, 1);
-
-    // Find the command in the library map using the function name.
-    map<string, Command>::iterator it = library.find(fName);
-    // Ensure the function is registered before proceeding.
-    assert(it != library.end());
-
-    // Reference to the command associated with the function name.
-    Command& cmd = (*it).second;
-
-    // Check if the function pointer is valid before calling.
-    if (cmd.voidintfunct)
-    {
-        // Retrieve the integer parameter from Lua stack to pass to the C++ function.
-        int param = (int)lua_tointeger(L, 2);
-        // Call the registered function with the parameter.
-        cmd.voidintfunct(param);
-        // Pop the parameter off the Lua stack after use.
-        lua_pop(L, 1);
-    }
-    else
-        assert(false);  // Assert failure if the function pointer is not valid.
-
-    return 1;  // Return success status to Lua.
-}
\ No newline at end of file
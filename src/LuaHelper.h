@@ -3,8 +3,6 @@
 // Lua helper to link Lua with our C++/Game
 
 #include <string>
-#include <functional>
-#include <map>
 #include <SimpleMath.h>
 
 // Required Lua libraries
@@ -34,17 +32,9 @@ public:
     // LuaFLerpNum function: Returns a value interpolated by a Lua function between two floats over a parameter.
     static float LuaFLerpNum(lua_State* L, const std::string& fName, float a, float b, float t);
 
+    // CustomPrint function: Replaces Lua's print so script output is tagged as coming from Lua.
     static int CustomPrint(lua_State* L);
 
-    // LuaUpdateMusicVol function: Allows a Lua function to update the music volume across the game.
-    static int LuaUpdateMusicVol(lua_State* L);
-    // LuaAdjustMasterVol function: Allows a Lua function to adjust the master volume across the game.
-    static int LuaAdjustMasterVol(lua_State* L);
-    // LuaAdjustMusicVol function: Allows a Lua function to adjust the music volume across the game.
-    static int LuaAdjustMusicVol(lua_State* L);
-    // LuaAdjustGameVol function: Allows a Lua function to adjust the game volume across the game.
-    static int LuaAdjustGameVol(lua_State* L);
-
 
     // ******VARIABLES*******
 
@@ -54,6 +44,9 @@ public:
     // LuaGetNum function: Returns a float from a Lua script based on the variable name.
     static float LuaGetNum(lua_State* L, const std::string& name, const float& default);
 
+    // LuaGetBool function: Returns a bool from a Lua script based on the variable name.
+    static bool LuaGetBool(lua_State* L, const std::string& name, const bool& default);
+
     // LuaGetStr function: Returns a string from a Lua script based on the variable name.
     static std::string LuaGetStr(lua_State* L, const std::string& name, const std::string& default);
 
@@ -61,58 +54,3 @@ public:
     static DirectX::SimpleMath::Vector2 LuaGetVec2(lua_State* L, const std::string& name);
 };
 
-
-
-// ***DISPATCHER CLASS***
-// Dispatcher class: Acts as an intermediary between C++ and Lua, allowing 
-// the registration of C++ class member functions for use in Lua scripts.
-class Dispatcher
-{
-public:
-    // Command struct: Holds a function that takes an int and returns void.
-    struct Command
-    {
-        typedef std::function<void(int)> voidintfunc;  // Type definition for a function taking an int.
-        voidintfunc voidintfunct;  // Instance of the void(int) function.
-    };
-
-    // Init function: Initializes the Dispatcher by registering it with Lua.
-    void Init(lua_State* L)
-    {
-        // Registers 'CDispatcher' as a callable function from Lua scripts.
-        lua_register(L, "CDispatcher", LuaCall);
-    }
-
-    // Register function: Registers game functions with a given name to the Dispatcher.
-    void Register(const std::string& fName, Command cmd)
-    {
-        // Ensures the function is not already registered.
-        assert(library.find(fName) == library.end());
-        // Stores the command in the library map under the given function name.
-        library[fName] = cmd;
-    }
-
-    // Unregister function: Unregisters a game function previously registered with a given name.
-    void Unregister(const std::string& fName)
-    {
-        // Find the command in the library map.
-        auto it = library.find(fName);
-        // Ensure the function is actually registered before attempting to remove it.
-        if (it != library.end())
-        {
-            // Erase the command from the library map using the iterator.
-            library.erase(it);
-        }
-        else
-        {
-            // Optionally, handle the case where the function name is not found.
-            assert(false); // or some other error handling approach
-        }
-    }
-
-    // LuaCall function: Called from Lua to dispatch the request to the corresponding C++ function.
-    static int LuaCall(lua_State* L);
-
-private:
-    static std::map<std::string, Command> library;  // Map storing registered functions by name.
-};
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "ObjectRegistry.h"
+
+#include <algorithm>
+
+
+size_t ObjectRegistry::sNextSlot = 0;
+
+// Remove function: Searches the buckets for the object, removal is rare so this doesn't need to be quick.
+void ObjectRegistry::Remove(GameObj* pObj)
+{
+	size_t sz = mObjects.size();
+	assert(sz > 0);
+	mObjects.erase(std::remove(mObjects.begin(), mObjects.end(), pObj), mObjects.end());
+	assert(sz != mObjects.size());
+
+	for (Bucket& b : mBuckets)
+	{
+		std::vector<GameObj*>::iterator it = std::find(b.mObjs.begin(), b.mObjs.end(), pObj);
+		if (it == b.mObjs.end())
+			continue;
+
+		b.mObjs.erase(it);
+		b.mCached[0] = b.mCached[1] = nullptr;
+		break;
+	}
+
+	delete pObj;
+}
+
+// Clear function: Deletes every object and empties the buckets.
+void ObjectRegistry::Clear()
+{
+	for (auto& obj : mObjects)
+		delete obj;
+	mObjects.clear();
+
+	for (Bucket& b : mBuckets)
+	{
+		b.mObjs.clear();
+		b.mCached[0] = b.mCached[1] = nullptr;
+	}
+}
+
+// Find function: Returns the cached object if it's still in the wanted state, otherwise scans the bucket.
+GameObj* ObjectRegistry::Bucket::Find(bool active)
+{
+	GameObj*& cached = mCached[active ? 1 : 0];
+	if (cached && cached->mActive == active)
+		return cached;
+
+	cached = nullptr;
+	for (GameObj* obj : mObjs)
+		if (obj->mActive == active)
+		{
+			cached = obj;
+			break;
+		}
+
+	return cached;
+}
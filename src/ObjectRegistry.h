@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <typeinfo>
+#include <type_traits>
+
+#include "GameObj.h"
+
+
+// ObjectRegistry class: Owns a mode's game objects and buckets them by their concrete type.
+// Each type gets a slot number the first time it is used, so finding a type's bucket is a
+// plain vector index instead of comparing typeid against every object in the mode.
+// Each bucket also remembers the last active/inactive object it handed out and returns it
+// straight away while it is still in that state, only rescanning its own bucket when not.
+class ObjectRegistry
+{
+public:
+    ~ObjectRegistry() { Clear(); }
+
+    // Add function: Takes ownership of an object and files it under the type it was added as.
+    template<class T>
+    T* Add(T* pObj)
+    {
+        static_assert(std::is_base_of<GameObj, T>::value, "Only game objects can be registered");
+        assert(pObj);
+        assert(typeid(*pObj) == typeid(T));  // Adding through a base pointer would file it in the wrong bucket.
+
+        GetBucket(TypeSlot<T>()).mObjs.push_back(pObj);
+        mObjects.push_back(pObj);
+        return pObj;
+    }
+
+    // Remove function: Takes an object out of its bucket and deletes it.
+    void Remove(GameObj* pObj);
+
+    // Clear function: Deletes every object.
+    void Clear();
+
+    // FindFirst function: Returns an object of type T in the given active state, nullptr if there are none.
+    template<class T>
+    T* FindFirst(bool active)
+    {
+        size_t slot = TypeSlot<T>();
+        if (slot >= mBuckets.size())
+            return nullptr;
+
+        return static_cast<T*>(mBuckets[slot].Find(active));
+    }
+
+    // Get function: Returns the only object of type T, for things there is exactly one of (Player, ShelterManager).
+    template<class T>
+    T* Get()
+    {
+        size_t slot = TypeSlot<T>();
+        assert(slot < mBuckets.size() && mBuckets[slot].mObjs.size() == 1);
+        return static_cast<T*>(mBuckets[slot].mObjs[0]);
+    }
+
+    // GetAll function: Every object in the order it was added, used to update and render.
+    const std::vector<GameObj*>& GetAll() const { return mObjects; }
+
+private:
+    // Bucket struct: All the objects of a single type.
+    struct Bucket
+    {
+        std::vector<GameObj*> mObjs;
+        GameObj* mCached[2] = { nullptr, nullptr };  // Last inactive [0] and active [1] object found.
+
+        GameObj* Find(bool active);
+    };
+
+    // TypeSlot function: Hands out a new slot number the first time it is called for a type.
+    template<class T>
+    static size_t TypeSlot()
+    {
+        static const size_t slot = sNextSlot++;
+        return slot;
+    }
+
+    // GetBucket function: Grows the buckets to fit the slot if needed.
+    Bucket& GetBucket(size_t slot)
+    {
+        if (slot >= mBuckets.size())
+            mBuckets.resize(slot + 1);
+        return mBuckets[slot];
+    }
+
+    static size_t sNextSlot;  // Next slot number to hand out.
+
+    std::vector<Bucket> mBuckets;     // One bucket per slot.
+    std::vector<GameObj*> mObjects;   // All objects in the order they were added.
+};
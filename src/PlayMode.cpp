@@ -17,19 +17,15 @@ PlayMode::PlayMode()
 	: mBlackSquareSpr(WinUtil::Get().GetD3D())
 {
 	InitBgnd();              // Set up parallax background layers.
-	mObjects.reserve(1000);  // Reserve space for game objects.
 	mTexts.reserve(250);     // Reserve space for text objects.
 
-	MyD3D& d3d = WinUtil::Get().GetD3D();
 	int w, h;
 	WinUtil::Get().GetClientExtents(w, h);
 
-	// Configure the background black square sprite.
-	ID3D11ShaderResourceView* p = d3d.GetTexCache().LoadTexture(&d3d.GetDevice(), "sprites/black_square.dds");
-	mBlackSquareSpr.SetTex(*p);
+	// Configure the background black square sprite, BindTextures gives it its texture once it has loaded.
+	mBlackSquareSpr.RequestTex("sprites/black_square.dds");
 	mBlackSquareSpr.SetScale(Vector2(5.0f, 5.0f));
 	mBlackSquareSpr.colour = Vector4(1.0, 1.0, 1.0f, 0.6f);
-	mBlackSquareSpr.origin = mBlackSquareSpr.GetTexData().dim / 2.0f;
 	mBlackSquareSpr.mPos = Vector2((float)w / 2.0f, (float)h / 2.0f);
 
 	Init();  // Initialize game entities and UI texts.
@@ -39,17 +35,23 @@ PlayMode::PlayMode()
 PlayMode::~PlayMode()
 {
 	// Delete all game objects.
-	for (auto& obj : mObjects)
-		delete obj;
-	mObjects.clear();
+	mObjects.Clear();
 
 	// Delete all text objects.
 	for (auto& text : mTexts)
 		delete text;
 	mTexts.clear();
+
+	// A game quit part way through still gets a complete replay
+	if (mpSim)
+		mReplay.Close(mpSim->GetTicks(), mpSim->GetScore());
+
+	delete mpSim;
+	mpSim = nullptr;
 }
 
-// Init function: Sets up game entities like player, enemies, missiles, and UI elements.
+// Init function: Sets up game entities like player, enemies, missiles, and UI elements. The objects
+// only request their textures, the game starts when BindTextures finds they've all loaded.
 void PlayMode::Init()
 {
 	MyD3D& d3d = WinUtil::Get().GetD3D();
@@ -58,7 +60,7 @@ void PlayMode::Init()
 	WinUtil::Get().GetClientExtents(w, h);
 
 	// Initialize the game objects (Player, Missile, ShelterManager, EnemyManager) 
-	// This includes setting their positions, active states, and adding them to their vectors.
+	// These draw the simulation so only need linking to this mode and adding to the vector.
 	Player* p = new Player(d3d);
 	p->SetMode(*this);
 	p->mActive = true;
@@ -66,6 +68,7 @@ void PlayMode::Init()
  
 	Missile* m = new Missile(d3d);
 	m->SetMode(*this);
+	m->mActive = true;
 	Add(m);
 
 	ShelterManager* sM = new ShelterManager(d3d, *this);
@@ -76,7 +79,11 @@ void PlayMode::Init()
 	eM->SetMode(*this);
 	eM->mActive = true;
 	Add(eM);
-	
+
+	// The last game's simulation goes, the next can't be sized until the new objects have their textures
+	delete mpSim;
+	mpSim = nullptr;
+
 	// initialize the UI Text
 	SpriteFont* retrotechSF = d3d.GetFontCache().LoadFont(&d3d.GetDevice(), "retrotech.spritefont");
 	
@@ -113,6 +120,22 @@ void PlayMode::Init()
 	mQuitConfirmText->CentreOriginY();
 	mQuitConfirmText->scale = 0.7f;
 	Add(mQuitConfirmText);
+
+	BindTextures();  // Starts the game straight away if the textures are already loaded
+}
+
+// StartSim function: Creates the simulation now we know how big everything is on screen.
+void PlayMode::StartSim()
+{
+	assert(!mpSim);
+	SimConfig config = BuildSimConfig();
+	unsigned int seed = (unsigned int)time(0);
+	mpSim = new Simulation(config, seed);
+
+	// Record the game if the scripts ask for it, every roll comes from the seed so that's all a replay needs
+	const std::string& replayFile = Game::Get().GetVars().mReplayFile;
+	if (!replayFile.empty())
+		mReplay.Open(replayFile.c_str(), seed, config);
 }
 
 // InitBgnd function: Initializes background layers for parallax scrolling effect.
@@ -124,19 +147,33 @@ void PlayMode::InitBgnd()
 
 	// Load and set up the background textures and sprites.
 	pair<string, string> files[GC::BGND_LAYERS]{
-		{ "bgnd0", LuaHelper::LuaGetStr(Game::Get().GetLuaState(), "bgnd_01", "background_layers/background01_001.dds")},
-		{ "bgnd1", LuaHelper::LuaGetStr(Game::Get().GetLuaState(), "bgnd_02", "background_layers/background01_002.dds")}
+		{ "bgnd0", Game::Get().GetVars().mBgnd01 },
+		{ "bgnd1", Game::Get().GetVars().mBgnd02 }
 	};
-	int i = 0;
-	for (auto& f : files)
-	{
-		// Set the texture of the sprite
-		ID3D11ShaderResourceView* p = WinUtil::Get().GetD3D().GetTexCache().LoadTexture(&WinUtil::Get().GetD3D().GetDevice(), f.second, f.first);
-		if (!p)
-			assert(false);
-		mBgnd[i++].SetTex(*p);
-	}
+	// Rather than wait for them the layers draw nothing (the clear colour shows through)
+	// until BindTextures gives them their textures.
+	for (size_t i = 0; i < mBgnd.size(); i++)
+		mBgnd[i].RequestTex(files[i].second, files[i].first);
+}
 
+// BindTextures function: Cheap once everything's bound, until then it looks each texture up without waiting.
+void PlayMode::BindTextures()
+{
+	for (auto& s : mBgnd)
+		s.BindTex();
+
+	if (!mBlackSquareSpr.HasTex() && mBlackSquareSpr.BindTex())
+		mBlackSquareSpr.origin = mBlackSquareSpr.GetTexData().dim / 2.0f;
+
+	if (mpSim)
+		return;
+
+	// The simulation's colliders are sized from the sprites, so the game waits for all of them
+	bool bound = true;
+	for (auto& obj : mObjects.GetAll())
+		bound = obj->BindTextures() && bound;
+	if (bound)
+		StartSim();
 }
 
 // UpdateBgnd function: Updates background layers for parallax scrolling effect.
@@ -152,6 +189,9 @@ void PlayMode::UpdateBgnd(float dTime)
 void PlayMode::Update(float dTime)
 {
 	Game& gm = Game::Get();
+	BindTextures();
+	if (!mpSim)
+		return;  // Still loading, there's no game yet
 
 	// Handle score entry mode separately.
 	if (mEnteringScore)
@@ -176,9 +216,15 @@ void PlayMode::Update(float dTime)
 		return;
 	}
 
+	// Step the simulation and react to anything that happened in it.
+	SimInput input = GetSimInput();
+	mReplay.Record(input, dTime);
+	mpSim->Step(input, dTime);
+	HandleSimEvents();
+
 	// Update background and game objects.
 	UpdateBgnd(dTime);
-	for (auto& obj : mObjects)
+	for (auto& obj : mObjects.GetAll())
 		if (obj->mActive)
 			obj->Update(dTime);
 
@@ -208,9 +254,7 @@ void PlayMode::Update(float dTime)
 	mScoreText->mString = std::to_string(gm.GetScoreSys().GetCurrentScore());
 	mScoreText->CentreOriginX();
 
-	Player* p = (Player*)FindFirst(typeid(Player), true);
-
-	mLifesText->mString = std::string("Lifes: ") + std::to_string(p->GetLifes());
+	mLifesText->mString = std::string("Lifes: ") + std::to_string(mpSim->GetPlayer().mLifes);
 
 	// Check if player wants to pause to give quit confirmation.
 	if (gm.mMKIn.IsDown(VK_ESCAPE) || gm.mGamepad.GetButtonDown(XBtns.B) || gm.mGamepad.GetButtonDown(XBtns.Start))
@@ -230,8 +274,12 @@ void PlayMode::Render(float dTime, DirectX::SpriteBatch& batch)
 	for (auto& s : mBgnd)
 		s.Draw(batch);
 
+	// Just the background until the objects have their textures and the game starts.
+	if (!mpSim)
+		return;
+
 	// Render active game objects.
-	for (auto& obj : mObjects)
+	for (auto& obj : mObjects.GetAll())
 		if (obj->mActive)
 			obj->Render(dTime, batch);
 
@@ -259,9 +307,7 @@ void PlayMode::ProcessKey(char key)
 void PlayMode::Reset()
 {
 	// Clear all objects and texts
-	for (auto& obj : mObjects)
-		delete obj;
-	mObjects.clear();
+	mObjects.Clear();
 
 	for (auto& text : mTexts)
 		delete text;
@@ -277,16 +323,14 @@ void PlayMode::Reset()
 	// Reset our score
 	Game::Get().GetScoreSys().ClearCurrentScore();
 
+	// Finish the last game's replay before Init starts the next one
+	if (mpSim)
+		mReplay.Close(mpSim->GetTicks(), mpSim->GetScore());
+
 	// Reinitialize the Game
 	Init();
 }
 
-// Add function: Adds a new game object to the play mode.
-void PlayMode::Add(GameObj* pObj) {
-	assert(pObj);
-	mObjects.push_back(pObj);
-}
-
 // Add function: Adds a new text object to the play mode.
 void PlayMode::Add(Text* pTxt)
 {
@@ -296,22 +340,7 @@ void PlayMode::Add(Text* pTxt)
 
 // Remove function: Removes and deletes a game object from the play mode.
 void PlayMode::Remove(GameObj* pObj) {
-	size_t sz = mObjects.size();
-	assert(sz > 0);
-	mObjects.erase(std::remove(mObjects.begin(), mObjects.end(), pObj));
-	assert(sz != mObjects.size());
-	delete pObj;
-}
-
-// FindFirst function: Finds the first game object of a specified type.
-GameObj* PlayMode::FindFirst(const std::type_info& type, bool active) {
-	size_t i = 0;
-	// Iterate through the objects vector to find the first matching game object.
-	while (i < mObjects.size() && (typeid(*mObjects[i]) != type || mObjects[i]->mActive != active))
-		++i;
-	if (i >= mObjects.size())
-		return nullptr;
-	return mObjects[i];
+	mObjects.Remove(pObj);
 }
 
 // GameIsOver function: Handles the transition to the game over state.
@@ -321,21 +350,109 @@ void PlayMode::GameIsOver()
 		return; // Prevent multiple triggers of game over logic.
 
 	mIsGameOver = true; // Set the game over flag.
-
-	// Deactivate any missiles in the game.
-	GameObj* m = FindFirst(typeid(Missile), true);
-	if (m != nullptr)
-		m->mActive = false;
+	mReplay.Close(mpSim->GetTicks(), mpSim->GetScore());
 
 	// Prepare for score entry.
 	mScoreData.InputScore(Game::Get().GetScoreSys().GetCurrentScore());
+}
+
+// BuildSimConfig function: Gathers the script variables, window and sprite sizes for the simulation.
+SimConfig PlayMode::BuildSimConfig()
+{
+	SimConfig config;
+
+	WinUtil::Get().GetClientExtents(config.mScreenWidth, config.mScreenHeight);
+
+	// Take our variables from the snapshot of the Lua script.
+	Game::Get().GetVars().ApplyTo(config);
+
+	// Size the colliders from the sprites our objects loaded.
+	auto toSim = [](const Vector2& v) { return SimVec2(v.x, v.y); };
+
+	config.mPlayerSize = toSim(Get<Player>()->mSpr.GetScreenSize());
+	config.mMissileSize = toSim(Get<Missile>()->GetFrameScreenSize());
+	config.mShelterSize = toSim(Get<ShelterManager>()->GetShelterSize());
+
+	EnemyManager* eM = Get<EnemyManager>();
+	config.mOctopusSize = toSim(eM->GetEnemySize(Simulation::OCTOPUS));
+	config.mCrabSize = toSim(eM->GetEnemySize(Simulation::CRAB));
+	config.mSquidSize = toSim(eM->GetEnemySize(Simulation::SQUID));
+	config.mUfoSize = toSim(eM->GetEnemySize(Simulation::UFO));
+	config.mLaserSize = toSim(eM->GetLaserSize());
+
+	return config;
+}
+
+// GetSimInput function: Converts the keyboard/gamepad state into simulation input.
+SimInput PlayMode::GetSimInput() const
+{
+	Game& gm = Game::Get();
+	SimInput input;
+
+	// Fire with space, the left mouse button, A or the right trigger.
+	input.mFire = gm.mMKIn.IsPressed(VK_SPACE) || gm.mMKIn.GetMouseButton(MouseAndKeys::ButtonT::LBUTTON) ||
+		gm.mGamepad.GetButtonPressed(XBtns.A) || gm.mGamepad.RightTrigger() > 0.5f;
 
-	// Handle player's lives and transition to score entry if needed.
-	Player* p = (Player*)FindFirst(typeid(Player), true);
-	int playerLifes = p->GetLifes();
-	if (playerLifes > 0)
-		for (int i = 0; i < playerLifes; i++)
-			p->Hit();
+	// Handle movement via keyboard
+	bool keypressed = gm.mMKIn.IsPressed(VK_RIGHT) || gm.mMKIn.IsPressed(VK_LEFT) ||
+		gm.mMKIn.IsPressed(VK_D) || gm.mMKIn.IsPressed(VK_A);
+	if (keypressed)
+	{
+		if (gm.mMKIn.IsPressed(VK_RIGHT) || gm.mMKIn.IsPressed(VK_D))
+			input.mMoveX += 1.0f;
+		if (gm.mMKIn.IsPressed(VK_LEFT) || gm.mMKIn.IsPressed(VK_A))
+			input.mMoveX -= 1.0f;
+	}
+	// If the keyboard isn't being used then check the gamepad
+	else if (gm.mGamepad.IsConnected() && !gm.mGamepad.LStickInDeadzone())
+	{
+		input.mMoveX = gm.mGamepad.LeftStickX();
+	}
+
+	return input;
+}
+
+// HandleSimEvents function: Plays sounds, rumbles and scores for what happened in the last step.
+void PlayMode::HandleSimEvents()
+{
+	Game& gm = Game::Get();
+	AudioManager& audMgr = gm.GetAudMgr();
+
+	for (const SimEvent& ev : mpSim->GetEvents())
+	{
+		switch (ev.mType)
+		{
+		case SimEvent::MISSILE_SHOOT:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::MISSILE_SHOOT);
+			break;
+		case SimEvent::LASER_SHOOT:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::LAZER_SHOOT);
+			break;
+		case SimEvent::MISSILE_EXPLODE:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::EXPLOSION);
+			break;
+		case SimEvent::ENEMY_HIT:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::HIT);
+			gm.GetScoreSys().AddCurrentPoints(ev.mValue);
+			if (gm.mGamepad.IsConnected())
+				gm.mGamepad.VibrateOnTimer(0.2f, 0.02f, 0.02f); // Provide feedback on destruction
+			break;
+		case SimEvent::PLAYER_HIT:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::HIT);
+			if (gm.mGamepad.IsConnected())
+				gm.mGamepad.VibrateOnTimer(0.2f, 0.1f, 0.1f);  // Provide feedback on hit
+			break;
+		case SimEvent::SHELTER_HIT:
+			audMgr.CreateSFXInstance(AudioManager::SoundList::HIT);
+			break;
+		case SimEvent::WAVE_CLEARED:
+			gm.GetScoreSys().AddCurrentPoints(ev.mValue);
+			break;
+		case SimEvent::GAME_OVER:
+			GameIsOver();
+			break;
+		}
+	}
 }
 
 // EnterScoreData Constructor: Initializes UI elements for score entry.
@@ -8,7 +8,10 @@
 #include "Singleton.h"
 #include "ModeMgr.h"
 #include "GameObj.h"
+#include "ObjectRegistry.h"
 #include "Text.h"
+#include "Simulation.h"
+#include "Replay.h"
 
 
 // PlayMode class: Manages the gameplay mechanics for a space invaders styled game.
@@ -41,8 +44,9 @@ public:
     // Reset function: Resets the game mode to its initial state.
     void Reset() override;
 
-    // Add function: Adds a GameObj to the gameplay mode.
-    void Add(GameObj* pObj);
+    // Add function: Adds a GameObj to the gameplay mode, filed under its type T.
+    template<class T>
+    void Add(T* pObj) { mObjects.Add(pObj); }
 
     // Add function: Adds a Text object to the gameplay mode.
     void Add(Text* pTxt);
@@ -50,8 +54,13 @@ public:
     // Remove function: Removes and deletes a specified GameObj from the game mode.
     void Remove(GameObj* pObj);
 
-    // FindFirst function: Finds the first matching GameObj based on type and active state.
-    GameObj* FindFirst(const std::type_info& type, bool active);
+    // FindFirst function: Finds a GameObj of type T in the given active state.
+    template<class T>
+    T* FindFirst(bool active) { return mObjects.FindFirst<T>(active); }
+
+    // Get function: Returns the only GameObj of type T (Player, ShelterManager, etc).
+    template<class T>
+    T* Get() { return mObjects.Get<T>(); }
 
     // GameIsOver function: Marks the game as over and handles related logic.
     void GameIsOver();
@@ -59,9 +68,15 @@ public:
     // IsGameOver function: Checks if the game is over.
     bool IsGameOver() const { return mIsGameOver; }
 
+    // GetSim function: Returns the simulation being rendered by this mode.
+    const Simulation& GetSim() const {
+        assert(mpSim);
+        return *mpSim;
+    }
+
 private:
     std::vector<Sprite> mBgnd;       // Background sprites for parallax effect.
-    std::vector<GameObj*> mObjects;  // Game objects for update and render.
+    ObjectRegistry mObjects;         // Game objects for update and render.
     std::vector<Text*> mTexts;       // Text objects for rendering.
 
     Text* mScoreText = nullptr;  // Text object for displaying score.
@@ -77,12 +92,31 @@ private:
 
     bool mWantsToQuit = false;  // Flag for if the game is wanting to quit.
 
+    Simulation* mpSim = nullptr;  // The game being played, our objects just draw it. Null while their textures load.
+    ReplayWriter mReplay;         // Records the game when the replayFile script variable is set.
+
+    // BuildSimConfig function: Gathers the script variables, window and sprite sizes for the simulation.
+    SimConfig BuildSimConfig();
+
+    // GetSimInput function: Converts the keyboard/gamepad state into simulation input.
+    SimInput GetSimInput() const;
+
+    // HandleSimEvents function: Plays sounds, rumbles and scores for what happened in the last step.
+    void HandleSimEvents();
+
     // InitBgnd function: Initializes background elements for the parallax effect.
     void InitBgnd();
 
     // UpdateBgnd function: Updates background elements for the parallax scrolling effect.
     void UpdateBgnd(float dTime);
 
+    // BindTextures function: Gives the sprites that were made without a texture theirs once it has loaded,
+    // then starts the game once every object has its textures.
+    void BindTextures();
+
+    // StartSim function: Creates the simulation (and starts any replay) from the objects' sizes.
+    void StartSim();
+
     // EnterScoreData struct: Manages score entry process after game session.
     struct EnterScoreData
     {
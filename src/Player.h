@@ -4,55 +4,40 @@
 #include "PlayMode.h"
 
 
-// Player class: Inherits from GameObj and is all of the logic behind 
-// the user being able to move around and shoot whilst in the PlayMode.
+// Player class: Inherits from GameObj and draws the user's ship whilst in the PlayMode.
+// Movement, shooting and health are handled by the Simulation that PlayMode wraps.
 class Player : public GameObj
 {
 public:
 	Player(MyD3D& d3d);                 // Constructor to initialize the player
 	~Player();
-	void Update(float dTime) override;  // Update function called every frame to handle player movement and actions
+	void Update(float dTime) override;  // Update function called every frame to follow the simulated player
 	void Render(float dTime, DirectX::SpriteBatch& batch) override;
-
-	void Hit();  // Logic for what happens when a player is hit
-
-	int GetLifes() const { return mLifes; }
+	bool BindTextures() override;       // Centre the sprite once its texture has loaded
 
 	// Link the player to the game mode it belongs to
 	void SetMode(PlayMode& pm) {
 		mMyMode = &pm;
 	}
 
-	void AddLifes(int amount) { mLifes += amount; }
-	void SetLifes(int amount) { mLifes = amount; }
-
-	bool IsAlive() const { 
-		if (mLifes > 0)
-			return true;
-		
-		return false;
-	}
-
 private:
-	RECTF mPlayArea;			   // Defines the area within which the player can move
 	PlayMode* mMyMode = nullptr;  // Pointer to the game mode that owns this player
-	float mFireTimer = 0;		   // Timer to manage the delay between firing missiles
 
-	int mLifes = 3;  // Player's current and starting lifes
-	const float mTimeToRecover = 2.5f;  // Time it takes for the little flash animation to happen
-	float mRecoveryTimer = 0.0f;
-	bool mRecovering = false;
-
-	void Init();  // Initialize or reset the player's state and position
+	void Init();  // Request and orient the player's sprite
 };
 
-// Missile class: Also inherits from GameObj and is "shot" from the
-// players ship and then continuously moves up until it hits or goes off screen.
+// Missile class: Also inherits from GameObj and draws every missile "shot" from
+// the players ship as they continuously move up until they hit or go off screen.
 class Missile : public GameObj
 {
 public:
 	Missile(MyD3D& d3d);                // Constructor to initialize the missile
-	void Update(float dTime) override;  // Update function called every frame to handle missile movement and animation
+	void Update(float dTime) override;  // Update function called every frame to animate the missiles
+	void Render(float dTime, DirectX::SpriteBatch& batch) override;
+	bool BindTextures() override;       // Start the spin animation once the texture has loaded
+
+	// GetFrameScreenSize function: Screen size of a single frame of the spin animation
+	DirectX::SimpleMath::Vector2 GetFrameScreenSize() const;
 
 	// Link the missile to the game mode it belongs to
 	void SetMode(PlayMode& pm) {
@@ -60,4 +45,4 @@ public:
 	}
 private:
 	PlayMode* mMyMode = nullptr;  // Pointer to the game mode that owns this player
-};
\ No newline at end of file
+};
@@ -22,19 +22,15 @@ ScoreMenuMode::ScoreMenuMode()
 	SpriteFont* retrotechSF = d3d.GetFontCache().LoadFont(&d3d.GetDevice(), "retrotech.spritefont");
 	SpriteFont* lRetrotechSF = d3d.GetFontCache().LoadFont(&d3d.GetDevice(), "retrotech-60.spritefont");
 
-	ConvertScoresToString(); // Convert scores to a string format for display.
-	mScoresSize = Game::Get().GetScoreSys().GetParsedScoresSize();
-	
 	// Set up text elements for displaying scores and the score menu title.
 	mScoresText = new Text(d3d);
 	mScoresText->SetFont(*retrotechSF);
 	mScoresText->mActive = true;
-	mScoresText->mString = mScoreSStream.str();
-	mScoresText->mPos = Vector2((float)w / 2.0f, GC::SCROLL_LIST_MAX * GC::MAX_SCORES_SAVE);
+	mScoresText->mPos = Vector2((float)w / 2.0f, GC::SCROLL_LIST_MAX * GC::MAX_SCORES_SHOWN);
 	mScoresText->scale = 1.0f;
 	mScoresText->colour = Colors::DarkGray;
-	mScoresText->CentreOriginX();
 	mTexts.push_back(mScoresText);
+	RefreshScores(); // Convert scores to a string format for display.
 
 	mScoreTitleText = new Text(d3d);
 	mScoreTitleText->SetFont(*lRetrotechSF);
@@ -83,10 +79,25 @@ void ScoreMenuMode::Update(float dTime)
 		newY -= GC::SCROLL_LIST_INC * dTime;
 	}
 
-	if (newY < GC::SCROLL_LIST_MAX * GC::MAX_SCORES_SAVE && newY > GC::SCROLL_LIST_MIN * GC::MAX_SCORES_SAVE)
+	if (newY < GC::SCROLL_LIST_MAX * GC::MAX_SCORES_SHOWN && newY > GC::SCROLL_LIST_MIN * GC::MAX_SCORES_SHOWN)
 		mScoresText->mPos.y = newY;
 
 	mUIMgr.HandleInput();  // Handle UI input interactions.
+
+	// Keep asking the shared leaderboard for its top scores, it only sends them again if they've changed.
+	ScoreSystem& scoreSys = gm.GetScoreSys();
+	if (scoreSys.GetLeaderboardClient().IsOpen())
+	{
+		mRefreshTimer -= dTime;
+		if (mRefreshTimer <= 0.0f)
+		{
+			scoreSys.RequestSharedTop(GC::MAX_SCORES_SHOWN);
+			mRefreshTimer = GC::LEADERBOARD_REFRESH_TIME;
+		}
+
+		if (scoreSys.GetLeaderboardClient().GetTopLists() != mShownLists)
+			RefreshScores();
+	}
 }
 
 // Render function: Draws the score menu UI elements.
@@ -104,36 +115,60 @@ void ScoreMenuMode::Render(float dTime, DirectX::SpriteBatch& batch)
 void ScoreMenuMode::Reset()
 {
 	mUIMgr.Reset(); // Reset the UI manager state.
+	mRefreshTimer = 0.0f; // Ask the shared leaderboard straight away.
 
-	ConvertScoresToString(); // Update the score string representation.
-	mScoresSize = Game::Get().GetScoreSys().GetParsedScoresSize();
+	RefreshScores(); // Update the score string representation.
+}
+
+// RefreshScores function: Updates the scores text, noting which shared top list it shows.
+void ScoreMenuMode::RefreshScores()
+{
+	ConvertScoresToString();
 	mScoresText->mString = mScoreSStream.str(); // Update the scores text.
 	mScoresText->CentreOriginX(); // Re-center the scores text.
 }
 
 // ConvertScoresToString function: Converts the stored scores to a string for display.
+// The shared leaderboard's top scores are shown once it has sent them, this cabinet's own scores until then.
 void ScoreMenuMode::ConvertScoresToString()
 {
-	Game& gm = Game::Get();
-	std::vector<ScoreSystem::Score> scores = gm.GetScoreSys().GetParsedScores();
+	const ScoreSystem& scoreSys = Game::Get().GetScoreSys();
+	const LeaderboardClient& client = scoreSys.GetLeaderboardClient();
 	mScoreSStream.str("");
 
-	// If we have no scores then just exit the code.
-	if (scores.size() <= 0)
-		return;
-
-	// Format and append each score to the string stream.
-	for (int i = 0; i < GC::MAX_SCORES_SAVE; i++)
+	mShownLists = client.GetTopLists();
+	if (client.IsOpen() && client.HasTop())
 	{
-		if ((size_t)i < gm.GetScoreSys().GetParsedScoresSize())
+		const std::vector<Leaderboard::Entry>& top = client.GetTop();
+		mScoresSize = client.GetTopTotal();
+		for (size_t i = 0; i < (size_t)GC::MAX_SCORES_SHOWN; i++)
 		{
-			mScoreSStream << scores[i].id + 1 << ": Points - " << scores[i].points << ", Name - " << scores[i].name;
-			mScoreSStream << "\n";
-		}
-		else
-		{
-			mScoreSStream << i + 1 << ": NO SCORE SAVED FOR SLOT";
+			if (i < top.size())
+				mScoreSStream << i + 1 << ": Points - " << top[i].mPoints << ", Name - " << top[i].mName;
+			else
+				mScoreSStream << i + 1 << ": NO SCORE SAVED FOR SLOT";
 			mScoreSStream << "\n";
 		}
+		return;
+	}
+
+	const Leaderboard& leaderboard = scoreSys.GetLeaderboard();
+	mScoresSize = leaderboard.Size();
+
+	// If we have no scores then just exit the code.
+	if (leaderboard.Empty())
+		return;
+
+	// Format and append each of the top scores to the string stream, straight from the leaderboard.
+	leaderboard.ForEach(0, GC::MAX_SCORES_SHOWN, [this](size_t rank, const Leaderboard::Entry& score) {
+		mScoreSStream << rank + 1 << ": Points - " << score.mPoints << ", Name - " << score.mName;
+		mScoreSStream << "\n";
+		});
+
+	// Fill the rest of the slots.
+	for (size_t i = leaderboard.Size(); i < (size_t)GC::MAX_SCORES_SHOWN; i++)
+	{
+		mScoreSStream << i + 1 << ": NO SCORE SAVED FOR SLOT";
+		mScoreSStream << "\n";
 	}
 }
@@ -45,5 +45,10 @@ private:
     UIManager mUIMgr;                 // UI Manager for managing UI elements in the score menu.
 
     std::stringstream mScoreSStream;  // Stream to format and store score text.
-    size_t mScoresSize;               // Size of the scores to be displayed.
+    size_t mScoresSize;               // Number of scores saved, only the top ones are displayed.
+    unsigned int mShownLists = 0;     // Shared top lists received when the text was built, 0 while showing the local scores.
+    float mRefreshTimer = 0.0f;       // Seconds until the shared top list is asked for again.
+
+    // RefreshScores function: Rebuilds the scores text from the shared or local scores.
+    void RefreshScores();
 };
\ No newline at end of file
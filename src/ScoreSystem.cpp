@@ -2,9 +2,8 @@
 #include "Game.h"
 
 #include <cassert>    // for assert()
-#include <sstream>    // for std::stringstream
-#include <fstream>    // for std::ofstream
-#include <algorithm>  // for std::sort
+
+static const int LEADERBOARD_FLUSH_MS = 1000;  // Longest the game waits on exit for the daemon to take its scores
 
 
 // Constructor: Initializes the current score and loads the existing scores from the file
@@ -12,18 +11,16 @@ ScoreSystem::ScoreSystem()
     : mCurrScore(0, 0, "NULL") // Initializing current score
 {
     // Load in the scores.dat file, if it exists
-    LoadScores(); // Load scores from the file
-
-    // If we have loaded scores, sort them
-    if (mParsedScores.size() > 0)
-        SortScoresVec();
+    LoadScores(); // Load and sort scores from the file
 }
 
 // Destructor: Saves the scores to the file when the object is destroyed
 ScoreSystem::~ScoreSystem()
 {
-    // Save the score vector
-    SaveScores(); // Save current scores into the file
+    // Save any scores not written yet
+    SaveScores();    // Queue unsaved scores
+    mWriter.Stop();  // Blocks until everything queued is on the disk
+    mClient.Flush(LEADERBOARD_FLUSH_MS);  // Gives up straight away if the daemon isn't there
 }
 
 // function to add points to the current score
@@ -38,134 +35,90 @@ void ScoreSystem::AddCurrentName(std::string _name)
     mCurrScore.name = _name; // Set name for current score
 }
 
-// function to clear the current score and add it to the vector of parsed scores
+// function to clear the current score and add it to the leaderboard
 void ScoreSystem::ClearCurrentScore()
 {
     // Add current score to the list and reset it
-    if(mCurrScore.points > 0)
-        mParsedScores.push_back(Score(mParsedScores.size(), mCurrScore.points, mCurrScore.name));
-    SortScoresVec(); // Sort the scores after adding the new one
+    if (mCurrScore.points > 0)
+    {
+        Score score(mNextId++, mCurrScore.points, mCurrScore.name);
+        mLeaderboard.Insert(score.points, score.id, score.name); // Ranked as it goes in, nothing to sort
+        mUnsavedScores.push_back(score); // Written by the next save
+    }
 
     mCurrScore = Score(0, 0, "NULL"); // Reset current score
 }
 
-// function to retrieve the highest score from the list of parsed scores
+// function to retrieve the highest score from the leaderboard
 int ScoreSystem::GetHighestScore() const
 {
-    if (!mParsedScores.empty())
-        return mParsedScores[0].points; // Return the highest score
+    if (!mLeaderboard.Empty())
+        return mLeaderboard.At(0).mPoints; // Return the highest score
     return 0; // If no scores, return 0
 }
 
 // function to save the scores to the file
 void ScoreSystem::SaveScores()
 {
-    // Create an integer for our for loop
-    int parsedScoresSize = mParsedScores.size();
-
-    // No scores to save
-    if (parsedScoresSize <= 0)
-        return;
-    else if (parsedScoresSize > GC::MAX_SCORES_SAVE)
-        parsedScoresSize = GC::MAX_SCORES_SAVE; // Limit the number of saved scores
-
-    // Ensure scores are sorted before saving
-    SortScoresVec();
-
-    // Vector to hold scores that will be saved
-    std::vector<Score> scoresToSave;
-    for (int i = 0; i < parsedScoresSize; i++)
+    // Only the new scores are written, on the end of the file by the writer's thread,
+    // so saving never waits on the disk
+    for (const Score& score : mUnsavedScores)
     {
-        mParsedScores[i].id = i; // Reassign the ids for consistency
-        scoresToSave.push_back(mParsedScores[i]); // Add to the save list
-    }
-
-    mParsedScores = scoresToSave; // Replace current scores with the ones to save
+        mWriter.Queue(score.points, score.name);
 
-    // Serialize and encrypt the scores before saving
-    std::string serialized = SerializeScores();
-    std::string encrypted = EncryptDecrypt(serialized);
-
-    // Write the encrypted scores to the file
-    std::ofstream file(GC::SCORE_FILE_PATH, std::ios::out | std::ios::binary);
-    if (file)
-    {
-        file << encrypted; // Write encrypted data to file
-        file.close();
+        // The local id goes with it, the daemon uses it to ignore a score it already has
+        if (mClient.IsOpen())
+            mClient.Submit((uint32_t)score.id, score.points, score.name);
     }
-    else
-        assert(file); // Ensure the file is openable, else assert
-}
-
-// function to load the scores from the file
-void ScoreSystem::LoadScores()
-{
-    // Read the encrypted data from the file
-    std::ifstream file(GC::SCORE_FILE_PATH, std::ios::in | std::ios::binary);
-    std::string encrypted((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    file.close();
-
-    // Decrypt and deserialize the scores
-    std::string decrypted = EncryptDecrypt(encrypted);
-    DeserializeScores(decrypted);
+    mUnsavedScores.clear();
 }
 
-// function to encrypt or decrypt the data
-std::string ScoreSystem::EncryptDecrypt(const std::string& data)
+// function to connect to the shared leaderboard, nothing changes if it's already connected to the same one
+void ScoreSystem::ConnectLeaderboard(const std::string& _address, const std::string& _cabinet)
 {
-    std::string result = data;
+    if (_address == mClientAddress && _cabinet == mClientCabinet)
+        return;
 
-    // Simple XOR encryption/decryption
-    for (size_t i = 0; i < data.size(); i++)
-        result[i] = data[i] ^ GC::ENCRYPT_KEY[i % GC::ENCRYPT_KEY.size()];
+    mClientAddress = _address;
+    mClientCabinet = _cabinet;
+    if (_address.empty())
+    {
+        mClient.Close(); // Scores are only kept locally from now on
+        return;
+    }
 
-    return result;
+    bool started = Net::Init();
+    assert(started); // Ensure networking is available, else assert
+    // Reopening keeps any scores the old daemon hadn't acknowledged, they go to the new one
+    if (!mClient.Open(_address, _cabinet, mStore.GetNonce()))
+        DBOUT("Cannot reach the leaderboard at " << _address << ", scores are kept until it's there\n");
 }
 
-// function to serialize scores into a string
-std::string ScoreSystem::SerializeScores()
+// function to send any saved scores and top list requests, and take the replies
+void ScoreSystem::UpdateLeaderboard()
 {
-    std::stringstream ss;
-    for (const auto& score : mParsedScores)
-        ss << score.id << ',' << score.points << ',' << score.name << ';';
-
-    return ss.str(); // Return the serialized string
+    mClient.Pump();
 }
 
-// function to deserialize scores from a string
-void ScoreSystem::DeserializeScores(const std::string& data)
-{
-    std::stringstream ss(data);
-    std::string segment;
-    mParsedScores.clear();
 
-    // Parse each score segment and add it to the vector
-    while (std::getline(ss, segment, ';'))
-    {
-        std::stringstream segmentStream(segment);
-        std::string part;
-        int id, points;
-        std::string name;
+// function to load the scores from the file
+void ScoreSystem::LoadScores()
+{
+    // The writer has to finish with the file before it's reopened
+    mWriter.Stop();
 
-        // Extract id, points, and name
-        std::getline(segmentStream, part, ',');
-        id = std::stoi(part);
+    // Maps the file and reads its records, converting a file from before the record format
+    bool loaded = mStore.Open(GC::SCORE_FILE_PATH, GC::ENCRYPT_KEY);
+    assert(loaded); // Ensure the file is readable, else assert
 
-        std::getline(segmentStream, part, ',');
-        points = std::stoi(part);
+    mUnsavedScores.clear();
+    mNextId = mStore.GetNextId();
 
-        std::getline(segmentStream, part, ',');
-        name = part;
+    // Rank every saved score, the whole history is kept
+    mLeaderboard.Clear();
+    mLeaderboard.Reserve(mStore.GetRecords().size());
+    for (const ScoreRecord& record : mStore.GetRecords())
+        mLeaderboard.Insert(record.mPoints, record.mId, record.GetName());
 
-        mParsedScores.emplace_back(id, points, name); // Add to parsed scores
-    }
+    mWriter.Start(mStore);
 }
-
-// function to sort the vector of scores
-void ScoreSystem::SortScoresVec()
-{
-    // Sort the vectors by points Highest = first, Lowest = last
-    std::sort(mParsedScores.begin(), mParsedScores.end(), [](const Score& lhs, const Score& rhs) {
-        return lhs.points > rhs.points; // Sorting in descending order
-        });
-}
\ No newline at end of file
@@ -3,6 +3,11 @@
 #include <string>  // for std::vector
 #include <vector>  // for std::string
 
+#include "ScoreStore.h"
+#include "Leaderboard.h"
+#include "ScoreWriter.h"
+#include "LeaderboardClient.h"
+
 
 // ScoreSystem class to manage game scores
 class ScoreSystem
@@ -31,21 +36,29 @@ public:
 	void ClearCurrentScore();  // Reset the current score
 
 	int GetCurrentScore() const { return mCurrScore.points; }  // Get the current score points
-	int GetHighestScore() const ;                              // Get the highest score from the saved scores
+	int GetHighestScore() const;                               // Get the highest score from the saved scores
 
-	void SaveScores();  // Save scores to the file
+	void SaveScores();  // Queue the scores added since the last save to be written in the background
 	void LoadScores();  // Load scores from the file
 
-	std::vector<Score> GetParsedScores() { return mParsedScores; }
-	size_t GetParsedScoresSize() { return mParsedScores.size(); }
-
-private:
-	std::string EncryptDecrypt(const std::string& data);  // Encrypt or decrypt data
-	std::string SerializeScores();                        // Serialize scores into a string
-	void DeserializeScores(const std::string& data);      // Deserialize scores from a string
+	// Every score ever saved, ranked, query it for the top scores, ranks and each name's best
+	const Leaderboard& GetLeaderboard() const { return mLeaderboard; }
 
-	void SortScoresVec();  // Sort the scores vector
+	// Shared leaderboard: Saved scores are also submitted to the venue's leaderboard daemon,
+	// an empty address leaves this cabinet offline. The local scores stay the fallback.
+	void ConnectLeaderboard(const std::string& _address, const std::string& _cabinet);
+	void UpdateLeaderboard();  // Talks to the daemon without blocking, call once a frame
+	void RequestSharedTop(unsigned int _count) { mClient.RequestTop(_count); }
+	const LeaderboardClient& GetLeaderboardClient() const { return mClient; }
 
+private:
 	Score mCurrScore;                  // Current active score
-	std::vector<Score> mParsedScores;  // Vector of all parsed scores
+	Leaderboard mLeaderboard;          // Every score, saved or not, ranked
+	std::vector<Score> mUnsavedScores; // Scores added since the last save
+	unsigned int mNextId = 0;          // Id the next score gets, the store gives them out in the same order
+	ScoreStore mStore;                 // The score file, only touched by the writer while it's running
+	ScoreWriter mWriter;               // Writes saved scores to the file off the main thread
+	LeaderboardClient mClient;         // Connection to the shared leaderboard, if there is one
+	std::string mClientAddress;        // Address and cabinet name the client was opened with
+	std::string mClientCabinet;
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "ScriptCache.h"
+
+#include "LuaHelper.h"
+
+#include <cstdio>
+#include <iostream>
+#include <filesystem>
+
+using namespace std;
+
+// Cache file: magic "IALC", version, hash of the source, bytecode size, bytecode.
+static const uint32_t CACHE_MAGIC = 0x434C4149;
+static const uint32_t CACHE_VERSION = 1;
+
+
+// ReadFile function: Reads a whole file, false if it can't be opened.
+static bool ReadFile(const string& path, string& out)
+{
+	FILE* pFile = fopen(path.c_str(), "rb");
+	if (!pFile)
+		return false;
+
+	char buffer[4096];
+	size_t got;
+	out.clear();
+	while ((got = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+		out.append(buffer, got);
+
+	fclose(pFile);
+	return true;
+}
+
+// HashSource function: FNV-1a of the script's text.
+static uint64_t HashSource(const string& source)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : source)
+		hash = (hash ^ c) * 1099511628211ull;
+	return hash;
+}
+
+// DoFile function: Loads the chunk from whichever of the cache or source it can, then runs it.
+bool ScriptCache::DoFile(lua_State* L, const string& path)
+{
+	string source;
+	if (!ReadFile(path, source))
+	{
+		cout << "Cannot open " << path << endl;
+		return false;
+	}
+
+	uint64_t hash = HashSource(source);
+	string cachePath = GetCachePath(path);
+	string chunkName = "@" + path;  // Errors and the profiler name the script, not the cache
+
+	string bytecode;
+	bool loaded = false;
+	if (ReadCache(cachePath, hash, bytecode))
+	{
+		// Bytecode from another build of Lua is refused here, so it's only ever a miss
+		loaded = luaL_loadbufferx(L, bytecode.data(), bytecode.size(), chunkName.c_str(), "b") == LUA_OK;
+		if (!loaded)
+			lua_pop(L, 1);  // Clean up the error message
+	}
+
+	if (loaded)
+		mHits++;
+	else
+	{
+		mMisses++;
+		if (!LuaHelper::LuaOK(L, luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t")))
+		{
+			lua_pop(L, 1);  // Clean up the error message
+			return false;
+		}
+
+		if (mCooking)
+		{
+			bytecode.clear();
+			lua_dump(L, [](lua_State*, const void* p, size_t size, void* ud) {
+				static_cast<string*>(ud)->append(static_cast<const char*>(p), size);
+				return 0;
+				}, &bytecode, 0);
+
+			if (!WriteCache(cachePath, hash, bytecode))
+				cout << "Cannot write " << cachePath << endl;
+		}
+	}
+
+	if (!LuaHelper::LuaOK(L, lua_pcall(L, 0, 0, 0)))
+	{
+		lua_pop(L, 1);  // Clean up the error message
+		return false;
+	}
+	return true;
+}
+
+// GetCachePath function: data/scripts/Foo.lua is cached as <cache dir>/Foo.luac.
+string ScriptCache::GetCachePath(const string& path) const
+{
+	filesystem::path p(path);
+	return (filesystem::path(mCacheDir) / p.stem()).string() + ".luac";
+}
+
+// ReadCache function: Only succeeds if the file was cooked from source with the same hash.
+bool ScriptCache::ReadCache(const string& cachePath, uint64_t sourceHash, string& outBytecode) const
+{
+	FILE* pFile = fopen(cachePath.c_str(), "rb");
+	if (!pFile)
+		return false;
+
+	uint32_t magic = 0, version = 0;
+	uint64_t hash = 0, size = 0;
+	bool ok = fread(&magic, sizeof(magic), 1, pFile) == 1 && magic == CACHE_MAGIC &&
+		fread(&version, sizeof(version), 1, pFile) == 1 && version == CACHE_VERSION &&
+		fread(&hash, sizeof(hash), 1, pFile) == 1 && hash == sourceHash &&
+		fread(&size, sizeof(size), 1, pFile) == 1 && size > 0;
+
+	if (ok)
+	{
+		outBytecode.resize((size_t)size);
+		ok = fread(&outBytecode[0], 1, outBytecode.size(), pFile) == outBytecode.size();
+	}
+
+	fclose(pFile);
+	return ok;
+}
+
+// WriteCache function: Writes to a temporary file first so a crash can't leave half a cache behind.
+bool ScriptCache::WriteCache(const string& cachePath, uint64_t sourceHash, const string& bytecode) const
+{
+	error_code ec;
+	filesystem::create_directories(mCacheDir, ec);
+
+	string tempPath = cachePath + ".tmp";
+	FILE* pFile = fopen(tempPath.c_str(), "wb");
+	if (!pFile)
+		return false;
+
+	uint64_t size = bytecode.size();
+	bool ok = fwrite(&CACHE_MAGIC, sizeof(CACHE_MAGIC), 1, pFile) == 1 &&
+		fwrite(&CACHE_VERSION, sizeof(CACHE_VERSION), 1, pFile) == 1 &&
+		fwrite(&sourceHash, sizeof(sourceHash), 1, pFile) == 1 &&
+		fwrite(&size, sizeof(size), 1, pFile) == 1 &&
+		fwrite(bytecode.data(), 1, bytecode.size(), pFile) == bytecode.size();
+	ok = fclose(pFile) == 0 && ok;
+
+	if (ok)
+	{
+		filesystem::rename(tempPath, cachePath, ec);
+		ok = !ec;
+	}
+	if (!ok)
+		filesystem::remove(tempPath, ec);
+	return ok;
+}
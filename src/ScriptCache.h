@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+struct lua_State;
+
+
+// ScriptCache class: Runs scripts from precompiled bytecode instead of parsing them every launch.
+// A cooked script is stored in the cache directory as its bytecode (from lua_dump) tagged
+// with a hash of the source it was made from. DoFile reads the source, and if the hash
+// still matches it loads the bytecode, skipping the parser. Anything else (no cache,
+// edited source, bytecode from another Lua build) falls back to compiling the source,
+// which is also when a cooking cache writes the bytecode for next time.
+class ScriptCache
+{
+public:
+    explicit ScriptCache(const std::string& cacheDir) : mCacheDir(cacheDir) {}
+
+    // SetCooking function: Whether scripts that had to be compiled from source are written to the cache.
+    void SetCooking(bool _cooking) { mCooking = _cooking; }
+
+    // DoFile function: Runs a script like luaL_dofile, from the cache when it's up to date.
+    // Returns false if the script fails to compile or run, after printing why.
+    bool DoFile(lua_State* L, const std::string& path);
+
+    int GetHits() const { return mHits; }      // Scripts run from bytecode.
+    int GetMisses() const { return mMisses; }  // Scripts compiled from source.
+
+private:
+    std::string GetCachePath(const std::string& path) const;
+    bool ReadCache(const std::string& cachePath, uint64_t sourceHash, std::string& outBytecode) const;
+    bool WriteCache(const std::string& cachePath, uint64_t sourceHash, const std::string& bytecode) const;
+
+    std::string mCacheDir;
+    bool mCooking = false;
+    int mHits = 0;
+    int mMisses = 0;
+};
@@ -0,0 +1,164 @@
+#include "ScriptCallbacks.h"
+
+#include "LuaHelper.h"
+#include "ScriptMonitor.h"
+
+#include <cassert>
+#include <chrono>
+
+using namespace std;
+
+
+// Release function: Unrefs every function, leaving the callbacks registered but unresolved.
+void ScriptCallbacks::Release()
+{
+	if (!mpLuaState)
+		return;
+
+	for (Callback& cb : mCallbacks)
+	{
+		luaL_unref(mpLuaState, LUA_REGISTRYINDEX, cb.mRef);
+		cb.mRef = LUA_NOREF;
+	}
+}
+
+// Register function: Returns the existing Id if the function is already registered.
+ScriptCallbacks::Id ScriptCallbacks::Register(const string& fName)
+{
+	assert(mpLuaState);
+	for (size_t i = 0; i < mCallbacks.size(); i++)
+		if (mCallbacks[i].mName == fName)
+			return (Id)i;
+
+	Callback cb;
+	cb.mName = fName;
+	cb.mRef = LUA_NOREF;
+	mCallbacks.push_back(cb);
+
+	Id id = (Id)mCallbacks.size() - 1;
+	lua_getglobal(mpLuaState, fName.c_str());
+	if (lua_isfunction(mpLuaState, -1))
+		mCallbacks[id].mRef = luaL_ref(mpLuaState, LUA_REGISTRYINDEX);  // Pops the function
+	else
+		lua_pop(mpLuaState, 1);
+
+	return id;
+}
+
+// Resolve function: Swaps each reference for whatever function the global holds now.
+void ScriptCallbacks::Resolve()
+{
+	assert(mpLuaState);
+	for (Callback& cb : mCallbacks)
+	{
+		luaL_unref(mpLuaState, LUA_REGISTRYINDEX, cb.mRef);
+		cb.mRef = LUA_NOREF;
+
+		lua_getglobal(mpLuaState, cb.mName.c_str());
+		if (lua_isfunction(mpLuaState, -1))
+			cb.mRef = luaL_ref(mpLuaState, LUA_REGISTRYINDEX);
+		else
+			lua_pop(mpLuaState, 1);
+	}
+}
+
+// Call function: Calls a callback with no parameters or return values.
+void ScriptCallbacks::Call(Id id)
+{
+	if (!Push(id))
+		return;
+
+	Invoke(id, 0, 0);
+}
+
+// Call function: Calls a callback, passing a single float parameter.
+void ScriptCallbacks::Call(Id id, float number)
+{
+	if (!Push(id))
+		return;
+
+	lua_pushnumber(mpLuaState, number);  // Push the float parameter onto the Lua stack
+	Invoke(id, 1, 0);
+}
+
+// CallNum function: Calls a callback with three floats and returns the float it returns, a if it can't.
+float ScriptCallbacks::CallNum(Id id, float a, float b, float t)
+{
+	if (!Push(id))
+		return a;
+
+	lua_pushnumber(mpLuaState, a);
+	lua_pushnumber(mpLuaState, b);
+	lua_pushnumber(mpLuaState, t);
+	if (!Invoke(id, 3, 1))
+		return a;
+
+	float returnedVariable = lua_isnumber(mpLuaState, -1) ? (float)lua_tonumber(mpLuaState, -1) : a;  // Retrieve the result
+	lua_pop(mpLuaState, 1);  // Clean up the Lua stack
+	return returnedVariable;
+}
+
+// ResetStats function: Starts counting again, e.g. once loading has finished.
+void ScriptCallbacks::ResetStats()
+{
+	for (Callback& cb : mCallbacks)
+	{
+		cb.mCalls = 0;
+		cb.mTotalTime = 0;
+		cb.mLastTime = 0;
+		cb.mSkipped = 0;
+	}
+}
+
+// Invoke function: Times the pcall, pops the error message and asserts if the script failed.
+// Going over budget isn't a script bug so that doesn't assert, and once over, calls are skipped.
+bool ScriptCallbacks::Invoke(Id id, int nArgs, int nResults)
+{
+	Callback& cb = mCallbacks[id];
+	if (mpMonitor && mpMonitor->IsExhausted())
+	{
+		lua_pop(mpLuaState, nArgs + 1);  // The function and its arguments
+		cb.mSkipped++;
+		return false;
+	}
+
+	if (mpMonitor)
+		mpMonitor->BeginCall();
+	auto start = chrono::steady_clock::now();
+	int result = lua_pcall(mpLuaState, nArgs, nResults, 0);
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (mpMonitor)
+		mpMonitor->EndCall();
+
+	cb.mCalls++;
+	cb.mTotalTime += seconds;
+	cb.mLastTime = seconds;
+
+	if (!LuaHelper::LuaOK(mpLuaState, result))
+	{
+		lua_pop(mpLuaState, 1);  // Clean up the error message
+		if (mpMonitor && mpMonitor->IsExhausted())
+		{
+			cb.mSkipped++;
+			return false;
+		}
+
+		assert(false);
+		return false;
+	}
+	return true;
+}
+
+// Push function: Fetches the function from the registry by its reference.
+bool ScriptCallbacks::Push(Id id)
+{
+	assert(mpLuaState && id >= 0 && id < (Id)mCallbacks.size());
+	if (mCallbacks[id].mRef == LUA_NOREF)
+	{
+		assert(false);  // The scripts don't define this function
+		return false;
+	}
+
+	lua_rawgeti(mpLuaState, LUA_REGISTRYINDEX, mCallbacks[id].mRef);
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct lua_State;
+class ScriptMonitor;
+
+
+// ScriptCallbacks class: The script functions the game calls every frame, looked up once.
+// Register resolves a global function into a reference in the Lua registry, after that
+// a call fetches it by integer index instead of hashing its name, and every call is
+// counted and timed so what the scripts cost each frame shows in the debug overlay.
+class ScriptCallbacks
+{
+public:
+    typedef int Id;  // Index of a registered callback.
+
+    // Callback struct: A registered script function and what calling it has cost.
+    struct Callback
+    {
+        std::string mName;     // Global the function was found under.
+        int mRef;              // Registry reference, LUA_NOREF if the script doesn't define it.
+        unsigned int mCalls = 0;
+        double mTotalTime = 0;  // Seconds spent in the function over mCalls calls.
+        double mLastTime = 0;   // Seconds the latest call took.
+        unsigned int mSkipped = 0;  // Calls skipped or stopped because the frame's script budget ran out.
+    };
+
+    ~ScriptCallbacks() { Release(); }
+
+    // Init function: Sets the Lua state callbacks are looked up and called in.
+    void Init(lua_State* L) { mpLuaState = L; }
+
+    // SetMonitor function: Budgets every call with a monitor, calls are skipped once it's exhausted.
+    void SetMonitor(ScriptMonitor* pMonitor) { mpMonitor = pMonitor; }
+
+    // Release function: Drops every reference so Lua can collect the functions.
+    void Release();
+
+    // Register function: Looks up a global function once and returns the Id to call it by.
+    Id Register(const std::string& fName);
+
+    // Resolve function: Looks every callback up again, needed after scripts that redefine them are rerun.
+    void Resolve();
+
+    // Call functions: Call a callback with no parameters, a float, or three floats returning a float
+    // (the shapes LuaHelper's CallVoidVoidCFunc and LuaFLerpNum take). CallNum returns a when the
+    // call is skipped over budget or doesn't give back a number, so the caller's value is left as it was.
+    void Call(Id id);
+    void Call(Id id, float number);
+    float CallNum(Id id, float a, float b, float t);
+
+    // ResetStats function: Zeroes every callback's counts and times.
+    void ResetStats();
+
+    const Callback& Get(Id id) const { return mCallbacks[id]; }
+    size_t Size() const { return mCallbacks.size(); }
+
+private:
+    // Invoke function: Calls a callback whose arguments are already pushed, timing it. False if it failed.
+    bool Invoke(Id id, int nArgs, int nResults);
+
+    // Push function: Pushes a callback's function, false if the script doesn't define it.
+    bool Push(Id id);
+
+    lua_State* mpLuaState = nullptr;
+    ScriptMonitor* mpMonitor = nullptr;
+    std::vector<Callback> mCallbacks;
+};
@@ -0,0 +1,141 @@
+#include "ScriptMonitor.h"
+
+#include "LuaHelper.h"
+
+#include <cassert>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+
+// Init function: The monitor is kept in the state's extra space so the hook can find it without a lookup.
+void ScriptMonitor::Init(lua_State* L)
+{
+	assert(L);
+	Release();
+
+	mpLuaState = L;
+	*(ScriptMonitor**)lua_getextraspace(L) = this;
+	lua_sethook(L, &ScriptMonitor::Hook, LUA_MASKCOUNT, HOOK_INSTRUCTIONS);
+}
+
+// Release function: Takes the hook back out so the state can outlive us.
+void ScriptMonitor::Release()
+{
+	if (!mpLuaState)
+		return;
+
+	lua_sethook(mpLuaState, nullptr, 0, 0);
+	*(ScriptMonitor**)lua_getextraspace(mpLuaState) = nullptr;
+	mpLuaState = nullptr;
+}
+
+// SetBudget function: Negative limits are treated as no limit.
+void ScriptMonitor::SetBudget(long long instructions, double seconds)
+{
+	mInstructionBudget = max(instructions, 0LL);
+	mTimeBudget = max(seconds, 0.0);
+}
+
+// BeginFrame function: Clears this frame's usage.
+void ScriptMonitor::BeginFrame()
+{
+	mExhausted = false;
+	mFrameInstructions = 0;
+	mFrameTime = 0;
+}
+
+// BeginCall function: Starts the clock on a call.
+void ScriptMonitor::BeginCall()
+{
+	mInCall = true;
+	mCallStart = Clock::now();
+	mLastSample = mCallStart;
+}
+
+// EndCall function: Adds the call's time to the frame's.
+void ScriptMonitor::EndCall()
+{
+	mFrameTime += chrono::duration<double>(Clock::now() - mCallStart).count();
+	mInCall = false;
+}
+
+// Hook function: Lua only calls this with LUA_HOOKCOUNT as that's all we asked for.
+void ScriptMonitor::Hook(lua_State* L, lua_Debug* ar)
+{
+	ScriptMonitor* pMonitor = *(ScriptMonitor**)lua_getextraspace(L);
+	if (pMonitor)
+		pMonitor->OnCount(L);
+}
+
+// OnCount function: Samples, then checks the budget. Nothing here may need destroying as luaL_error doesn't return.
+void ScriptMonitor::OnCount(lua_State* L)
+{
+	if (!mInCall)
+		return;  // Script loading and reloading isn't budgeted
+
+	Clock::time_point now = Clock::now();
+	if (mProfiling)
+		Sample(L, chrono::duration<double>(now - mLastSample).count());
+	mLastSample = now;
+
+	mFrameInstructions += HOOK_INSTRUCTIONS;
+	double used = mFrameTime + chrono::duration<double>(now - mCallStart).count();
+
+	if ((mInstructionBudget > 0 && mFrameInstructions > mInstructionBudget) ||
+		(mTimeBudget > 0 && used > mTimeBudget))
+	{
+		mExhausted = true;
+		mOverruns++;
+		luaL_error(L, "script stopped for going over its per frame budget");
+	}
+}
+
+// Sample function: Walks out from the running function, then writes the frames root first.
+// Each frame is "name source:line", the line being where that function is up to.
+void ScriptMonitor::Sample(lua_State* L, double seconds)
+{
+	const int maxDepth = 64;
+	lua_Debug frames[maxDepth];
+	int depth = 0;
+	while (depth < maxDepth && lua_getstack(L, depth, &frames[depth]))
+	{
+		lua_getinfo(L, "nSl", &frames[depth]);
+		depth++;
+	}
+
+	mStack.clear();
+	for (int i = depth - 1; i >= 0; i--)
+	{
+		const lua_Debug& ar = frames[i];
+		mStack += ar.name ? ar.name : (*ar.what == 'm' ? "main" : "?");
+		mStack += ' ';
+		mStack += ar.short_src;
+		if (ar.currentline > 0)
+		{
+			mStack += ':';
+			mStack += to_string(ar.currentline);
+		}
+		if (i > 0)
+			mStack += ';';
+	}
+
+	mSamples[mStack] += seconds;
+}
+
+// WriteFolded function: Sorted by stack so profiles diff cleanly.
+bool ScriptMonitor::WriteFolded(const string& path) const
+{
+	FILE* pFile = fopen(path.c_str(), "w");
+	if (!pFile)
+		return false;
+
+	vector<pair<string, double>> samples(mSamples.begin(), mSamples.end());
+	sort(samples.begin(), samples.end());
+	for (const auto& s : samples)
+		fprintf(pFile, "%s %lld\n", s.first.c_str(), (long long)(s.second * 1e6 + 0.5));
+
+	return fclose(pFile) == 0;
+}
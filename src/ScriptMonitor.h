@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <unordered_map>
+
+struct lua_State;
+struct lua_Debug;
+
+
+// ScriptMonitor class: Keeps the scripts to a budget each frame and profiles where their time goes.
+// A count hook runs every HOOK_INSTRUCTIONS Lua instructions while a callback is being called.
+// It adds up the instructions and time used so far this frame, and once either goes over
+// its limit the script is stopped with an error, so a runaway script costs one frame at
+// worst instead of hanging the game. When profiling, each hook also samples the Lua stack,
+// charging the time since the last sample to it, and the totals can be written out as
+// folded stacks ("outer;inner;leaf seconds") for flame graph tools.
+class ScriptMonitor
+{
+public:
+    static constexpr int HOOK_INSTRUCTIONS = 1000;  // Instructions between each budget check/sample.
+
+    ~ScriptMonitor() { Release(); }
+
+    // Init function: Installs the hook in a Lua state.
+    void Init(lua_State* L);
+
+    // Release function: Removes the hook.
+    void Release();
+
+    // SetBudget function: Most instructions and seconds the scripts may use each frame, 0 for no limit.
+    void SetBudget(long long instructions, double seconds);
+
+    void SetProfiling(bool _profiling) { mProfiling = _profiling; }
+    bool IsProfiling() const { return mProfiling; }
+
+    // BeginFrame function: Gives the scripts a fresh budget, call once at the start of every frame.
+    void BeginFrame();
+
+    // BeginCall/EndCall functions: Bracket every call into the scripts that should count towards the budget.
+    void BeginCall();
+    void EndCall();
+
+    // IsExhausted function: Whether the scripts have used up this frame's budget, calls should be skipped until the next.
+    bool IsExhausted() const { return mExhausted; }
+
+    long long GetFrameInstructions() const { return mFrameInstructions; }  // Roughly, counted HOOK_INSTRUCTIONS at a time.
+    double GetFrameTime() const { return mFrameTime; }                     // Seconds spent in calls so far this frame.
+    unsigned int GetOverruns() const { return mOverruns; }                 // Calls stopped for going over budget.
+
+    // WriteFolded function: Writes the profile as folded stacks with microseconds as the counts.
+    bool WriteFolded(const std::string& path) const;
+
+    // ResetProfile function: Throws away every sample so far.
+    void ResetProfile() { mSamples.clear(); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static void Hook(lua_State* L, lua_Debug* ar);  // Finds the monitor in the state's extra space and passes the hook on.
+    void OnCount(lua_State* L);
+    void Sample(lua_State* L, double seconds);       // Charges seconds to the stack that's running.
+
+    lua_State* mpLuaState = nullptr;
+
+    long long mInstructionBudget = 0;
+    double mTimeBudget = 0;
+    bool mProfiling = false;
+
+    bool mInCall = false;
+    bool mExhausted = false;
+    long long mFrameInstructions = 0;
+    double mFrameTime = 0;
+    unsigned int mOverruns = 0;
+    Clock::time_point mCallStart;
+    Clock::time_point mLastSample;
+
+    std::string mStack;  // Scratch for building a sample's folded stack.
+    std::unordered_map<std::string, double> mSamples;  // Seconds by folded stack.
+};
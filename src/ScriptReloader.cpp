@@ -0,0 +1,113 @@
+#include "ScriptReloader.h"
+
+#include "LuaHelper.h"
+
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+
+// Start function: Opens the watcher and starts the thread that waits on it.
+bool ScriptReloader::Start(const string& directory)
+{
+	Stop();
+
+	if (!mWatcher.Open(directory, ".lua"))
+		return false;
+
+	mRunning = true;
+	mThread = thread(&ScriptReloader::Run, this);
+	return true;
+}
+
+// Stop function: The thread wakes at least every Wait timeout, so it notices mRunning quickly.
+void ScriptReloader::Stop()
+{
+	mRunning = false;
+	if (mThread.joinable())
+		mThread.join();
+
+	mWatcher.Close();
+	mReady.clear();
+}
+
+// Run function: Compiles every script the watcher reports, replacing any older version still waiting.
+void ScriptReloader::Run()
+{
+	vector<string> changed;
+	while (mRunning)
+	{
+		changed.clear();
+		if (!mWatcher.Wait(changed, 100))
+			continue;
+
+		for (const string& path : changed)
+		{
+			Compiled c;
+			c.mPath = path;
+			Compile(path, c.mBytecode, c.mError);
+
+			lock_guard<mutex> lock(mMutex);
+			auto it = find_if(mReady.begin(), mReady.end(), [&path](const Compiled& r) { return r.mPath == path; });
+			if (it != mReady.end())
+				*it = std::move(c);
+			else
+				mReady.push_back(std::move(c));
+		}
+	}
+}
+
+// Apply function: Loads each chunk as binary only, so nothing is parsed on this thread, then runs it.
+int ScriptReloader::Apply(lua_State* L)
+{
+	vector<Compiled> ready;
+	{
+		lock_guard<mutex> lock(mMutex);
+		if (mReady.empty())
+			return 0;
+		ready.swap(mReady);
+	}
+
+	int applied = 0;
+	for (const Compiled& c : ready)
+	{
+		if (!c.mError.empty())
+		{
+			cout << "Not reloading " << c.mPath << ": " << c.mError << endl;
+			continue;
+		}
+
+		string chunkName = "@" + c.mPath;  // Keeps the file name in error messages
+		if (!LuaHelper::LuaOK(L, luaL_loadbufferx(L, c.mBytecode.data(), c.mBytecode.size(), chunkName.c_str(), "b")) ||
+			!LuaHelper::LuaOK(L, lua_pcall(L, 0, 0, 0)))
+		{
+			lua_pop(L, 1);  // Clean up the error message
+			continue;
+		}
+
+		cout << "Reloaded " << c.mPath << endl;
+		applied++;
+	}
+
+	return applied;
+}
+
+// Compile function: lua_dump hands us the bytecode a piece at a time.
+bool ScriptReloader::Compile(const string& path, string& outBytecode, string& outError)
+{
+	lua_State* C = luaL_newstate();
+	bool ok = luaL_loadfile(C, path.c_str()) == LUA_OK;
+	if (ok)
+	{
+		lua_dump(C, [](lua_State*, const void* p, size_t size, void* ud) {
+			static_cast<string*>(ud)->append(static_cast<const char*>(p), size);
+			return 0;
+			}, &outBytecode, 0);
+	}
+	else
+		outError = lua_tostring(C, -1);
+
+	lua_close(C);
+	return ok;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+#include "FileWatcher.h"
+
+struct lua_State;
+
+
+// ScriptReloader class: Hot reloads the Lua scripts while the game is running.
+// A background thread waits on a FileWatcher and compiles each script that changes
+// to bytecode in a Lua state of its own, so reading and parsing never stall a frame
+// and a script with a syntax error is reported without touching the game's state.
+// The game's state isn't thread safe, so the compiled chunks wait until Apply is
+// called between frames to be run in it.
+class ScriptReloader
+{
+public:
+    ~ScriptReloader() { Stop(); }
+
+    // Start function: Begins watching directory for changed .lua files, returns false if it can't be watched.
+    bool Start(const std::string& directory);
+
+    // Stop function: Stops watching and throws away anything compiled but not yet applied.
+    void Stop();
+
+    // Apply function: Runs every script compiled since the last call in L, returns how many ran.
+    // Only call this between frames, from the thread that owns L.
+    int Apply(lua_State* L);
+
+    bool IsRunning() const { return mRunning; }
+
+private:
+    // Compiled struct: A changed script, ready to run or with the reason it couldn't be compiled.
+    struct Compiled
+    {
+        std::string mPath;
+        std::string mBytecode;
+        std::string mError;  // Empty if it compiled.
+    };
+
+    void Run();  // The watching thread's loop.
+
+    // Compile function: Loads a script into a throwaway Lua state and dumps it as bytecode.
+    static bool Compile(const std::string& path, std::string& outBytecode, std::string& outError);
+
+    FileWatcher mWatcher;
+    std::thread mThread;
+    std::atomic<bool> mRunning{ false };
+
+    std::mutex mMutex;              // Guards mReady.
+    std::vector<Compiled> mReady;   // Compiled and waiting for Apply, one per script.
+};
@@ -46,25 +46,14 @@ SettingsMenuMode::SettingsMenuMode()
 	backButton.mText.mPos = Vector2(20 + bBScreenSize.x / 2, 20);
 	mUIMgr.AddButton(backButton);
 
-	// Load and configure the up and down arrow sprites for the counter.
-	ID3D11ShaderResourceView* p = d3d.GetTexCache().LoadTexture(&d3d.GetDevice(), "ui/arrows.dds");
+	// Request and configure the up and down arrow sprites for the counter, each counter
+	// gives them their halves of the sheet once it has loaded (see UICounter::BindArrows).
 	Sprite upArrowSprite(d3d);
-	upArrowSprite.SetTex(*p);
-	RECTF arrowsRect = upArrowSprite.GetTexRect();
-	arrowsRect.right /= 2.0f;
-	upArrowSprite.SetTexRect(arrowsRect);
+	upArrowSprite.RequestTex("ui/arrows.dds");
 	upArrowSprite.SetScale(Vector2(0.2f, 0.2f));
-	upArrowSprite.origin = (upArrowSprite.GetTexData().dim / 2.0f) / 2.0f;
 	upArrowSprite.rotation = PI * 10.0f;
 
-	Sprite downArrowSprite(d3d);
-	downArrowSprite.SetTex(*p);
-	arrowsRect = downArrowSprite.GetTexRect();
-	arrowsRect.left = arrowsRect.right / 2.0f;
-	downArrowSprite.SetTexRect(arrowsRect);
-	downArrowSprite.SetScale(Vector2(0.2f, 0.2f));
-	downArrowSprite.origin = (downArrowSprite.GetTexData().dim / 2.0f) / 2.0f;
-	downArrowSprite.rotation = PI * 10.0f;
+	Sprite downArrowSprite(upArrowSprite);
 
 	// Configure and initialize the master volume counter.
 	Text counterText(d3d);
@@ -1,239 +1,226 @@
 #include "Shelter.h"
-#include "Player.h"
 #include "Game.h"
+#include "WindowUtils.h"
+#include "DdsImage.h"
 
-#include <ostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
+TextureLoader::Future ShelterManager::sSheetImage;
 
-// Shelter Constructor: Initializes the shelter sprite and its properties.
-Shelter::Shelter(MyD3D& d3d)
-	: GameObj(d3d)
-{
-	// Load the texture for the shelter
-	ID3D11ShaderResourceView* p = d3d.GetTexCache().LoadTexture(&d3d.GetDevice(), "sprites/sheltersheet.dds");
-
-	// Set up the shelter sprite
-	mSpr.SetTex(*p);
-	mSpr.SetScale(Vector2(0.15f, 0.15f));
-	mSpr.origin = Vector2((mSpr.GetTexData().dim.x / (float)mTextureStates) / 2.0f, mSpr.GetTexData().dim.y / 2.0f);
-	RECTF shelterRect = mSpr.GetTexRect();
-	// The sprite sheet isn't an equal amount so over time the pixels
-	// from the next sprite seem to leak over, subtracting the 1 seems
-	// to fix this issue
-	mShelterRectRightAmt = (shelterRect.right / (float)mTextureStates) - 1;
-	shelterRect.right = mShelterRectRightAmt;
-
-	// Pixel seems to be wrapping from the top and left 
-	// too now not sure why but this will fix it
-	shelterRect.top += 5;
-	shelterRect.left += 5;
-	mSpr.SetTexRect(shelterRect);
-
-	mActive = true;
-}
-
-// Update function: Updates the bounding box of the shelter based on its remaining life.
-void Shelter::Update(float dTime)
-{
-	// Adjust the collider size based off of it's 
-	// textureState and update its bounding box accordingly.
-	float colliderYSlice = ((float)mLifes / (float)mTextureStates);
-
-	Vector2 screenSize = mSpr.GetScreenSize();
-	float prevScreenSizeY = screenSize.y;
-	screenSize.y *= colliderYSlice;
-
-	screenSize.x /= (float)mTextureStates;
-
-	Vector2 spritePos = mSpr.mPos;
-	if (prevScreenSizeY != screenSize.y)
-		spritePos.y += (prevScreenSizeY - screenSize.y) / 2;
 
-	mBoundingBox.UpdateBox(spritePos, screenSize, 0.95f);
-}
-
-// UpdateTexture function: Updates the sprite's texture rectangle to reflect damage.
-void Shelter::UpdateTexture()
+// ShelterManager Constructor: Creates a mask texture for each shelter, BindTextures sizes them once the sprite sheet has loaded.
+ShelterManager::ShelterManager(MyD3D& d3d, PlayMode& pM)
+	: GameObj(d3d), mMyMode(&pM), mShelterSize(0, 0)
 {
-	MyD3D& d3d = WinUtil::Get().GetD3D();
+	// The shelters are still sized from a single state of the sprite sheet so the layout doesn't change,
+	// mSpr is never drawn, it's just how big the sheet is on screen
+	mSpr.RequestTex("sprites/sheltersheet.dds");
+	mSpr.SetScale(Vector2(0.15f, 0.15f));
 
-	if (mTextureState < 9)
-		mTextureState++;
+	// The art comes from the same read of the sheet as the texture, the shelters are a flat colour until it's in
+	if (!sSheetImage.valid())
+		sSheetImage = d3d.GetTexCache().Request("sprites/sheltersheet.dds");
 
-	// Move the texture's rect to the next damaged sprite.
-	RECTF newShelterRect = mSpr.GetTexRect();
-	newShelterRect.left = mShelterRectRightAmt * mTextureState;
-	newShelterRect.right = mShelterRectRightAmt * (mTextureState + 1);
+	const int w = GC::SHELTER_MASK_WIDTH, h = GC::SHELTER_MASK_HEIGHT;
+	mPixels.resize(w * h);
+	mArt.assign(w * h, GC::SHELTER_PIXEL_COLOUR);
 
-	mSpr.SetTexRect(newShelterRect);
-}
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = w;
+	desc.Height = h;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
-// Hit function: Reduces the shelter's life and updates its texture or deactivates it if life is zero.
-void Shelter::Hit()
-{
-	// Reduce the life of the shelter
-	mLifes--;
-
-	// Check if it should be demolished
-	if (mLifes < 1)
+	for (int i = 0; i < GC::NUM_SHELTERS; i++)
 	{
-		mActive = false;
-		return;
+		ID3D11Texture2D* pTex = nullptr;
+		ID3D11ShaderResourceView* pSRV = nullptr;
+		if (d3d.GetDevice().CreateTexture2D(&desc, nullptr, &pTex) != S_OK ||
+			d3d.GetDevice().CreateShaderResourceView(pTex, nullptr, &pSRV) != S_OK)
+			assert(false);
+
+		// The cache owns the view, we keep the texture to upload into
+		d3d.GetTexCache().Add("shelterMask" + std::to_string(i), pSRV);
+		mMaskTextures.push_back(pTex);
+
+		Sprite spr(d3d);
+		spr.SetTex(*pSRV);
+		spr.origin = Vector2(w / 2.0f, h / 2.0f);
+		mShelterSprs.push_back(spr);
 	}
 
-	// Update the texture to reflect the damage
-	UpdateTexture();
+	mUploadedVersions.assign(GC::NUM_SHELTERS, 0);
+	UpdateArt();
 }
 
-// ShelterManager Constructor: Creates and positions multiple shelters in the game.
-ShelterManager::ShelterManager(MyD3D& d3d, PlayMode& pM)
-	: GameObj(d3d), mMyMode(&pM)
+// ShelterManager Destructor: The cache releases the views, we just release our texture references.
+ShelterManager::~ShelterManager()
 {
-	// Position shelters based on the game's width and player's position.
-	float perShelterPos = (float)WinUtil::Get().GetClientWidth() / GC::NUM_SHELTERS;
-	Player* p = (Player*)mMyMode->FindFirst(typeid(Player), true);  // Retrieve the player from our PlayMode
-
-	// Fill our array with shelters
-	for (int i = 0; i < 4; i++)
-	{
-		mShelters[i] = new Shelter(d3d);
-		mShelters[i]->SetPosition(Vector2((perShelterPos - (mShelters[i]->mSpr.GetScreenSize().x / (float)GC::SHELTER_TEXTURE_STATES) / 2.0f) * (float)(i + 1),
-			p->mSpr.mPos.y - GC::SHELTER_OFFSET_Y));
-	}
+	for (ID3D11Texture2D*& pTex : mMaskTextures)
+		ReleaseCOM(pTex);
+	mMaskTextures.clear();
 }
 
-// Update function: Updates each active shelter.
-void ShelterManager::Update(float dTime)
+// BindTextures function: Sizes the shelters from the sheet, and each mask's texels to cover one.
+bool ShelterManager::BindTextures()
 {
-	// Loop through and update all active shelters.
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
-		if (mShelters[i]->mActive)
-			mShelters[i]->Update(dTime);
-
+	if (mSpr.HasTex())
+		return true;
+	if (!mSpr.BindTex())
+		return false;
+
+	mShelterSize = mSpr.GetScreenSize();
+	mShelterSize.x /= (float)GC::SHELTER_TEXTURE_STATES;
+	for (Sprite& spr : mShelterSprs)
+		spr.SetScale(Vector2(mShelterSize.x / GC::SHELTER_MASK_WIDTH, mShelterSize.y / GC::SHELTER_MASK_HEIGHT));
+	return true;
 }
 
-// Render function: Renders each active shelter.
+// Render function: Renders each active shelter with its current damage.
 void ShelterManager::Render(float dTime, DirectX::SpriteBatch& batch)
 {
+	const std::vector<Simulation::ShelterState>& shelters = mMyMode->GetSim().GetShelters();
+	UpdateArt();
+
 	// Draw each active shelter in the game.
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
-		if (mShelters[i]->mActive)
-			mShelters[i]->Render(dTime, batch);
+	for (size_t i = 0; i < shelters.size() && i < mShelterSprs.size(); i++)
+	{
+		const Simulation::ShelterState& s = shelters[i];
+		if (!s.mActive)
+			continue;
 
+		UpdateTexture(i, s.mMask);
 
+		Sprite& spr = mShelterSprs[i];
+		spr.mPos = Vector2(s.mPos.x, s.mPos.y);
+		spr.Draw(batch);
+
+#if defined(DEBUG) || (_DEBUG)
+		mBoundingBox = s.mBoundingBox;
+		mBoundingBox.DebugDraw(batch);
+#endif
+	}
 }
 
-// Hit function: Determines which shelter is closest to a given hit position and damages it.
-void ShelterManager::Hit(float _hitX)
+// UpdateTexture function: Finds the range of rows changed since the last upload and only rewrites those.
+void ShelterManager::UpdateTexture(size_t _shelter, const ShelterMask& _mask)
 {
-	// Find the closest active shelter to the hit position and trigger its Hit function.
-
-	int closestIndex = -1;  // Index of the closest shelter
-	float closestDistance = 9000;  // Initialize with max float value
+	uint32_t uploaded = mUploadedVersions[_shelter];
+	if (_mask.GetVersion() == uploaded)
+		return;
 
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
-	{
-		if (mShelters[i]->mActive)  // Check if the shelter is active
+	// A version older than ours means the mask was replaced by a new game's, redo everything
+	bool all = _mask.GetVersion() < uploaded;
+	int first = _mask.GetHeight(), last = -1;
+	for (int y = 0; y < _mask.GetHeight(); y++)
+		if (all || _mask.GetRowVersion(y) > uploaded)
 		{
-			// Calculate the distance from _hitX to the center of the shelter
-			float distance = std::abs(mShelters[i]->mSpr.mPos.x - _hitX);
-
-			// Check if this shelter is closer than the currently closest
-			if (distance < closestDistance)
-			{
-				closestDistance = distance;  // Update the closest distance
-				closestIndex = i;  // Update the index of the closest shelter
-			}
+			first = std::min(first, y);
+			last = y;
 		}
-	}
 
-	// If a closest shelter wasn't found (closestIndex is -1), return out of the function
-	if (closestIndex == -1)
-	{
+	mUploadedVersions[_shelter] = _mask.GetVersion();
+	if (last < 0)
 		return;
+
+	// Expand each row's bits into texels, standing pixels show the art and the rest are see through
+	const int w = _mask.GetWidth();
+	for (int y = first; y <= last; y++)
+	{
+		const ShelterMask::Word* row = _mask.GetRow(y);
+		const uint32_t* art = &mArt[y * w];
+		uint32_t* texels = &mPixels[y * w];
+		for (int x = 0; x < w; x++)
+			texels[x] = ((row[x / ShelterMask::WORD_BITS] >> (x % ShelterMask::WORD_BITS)) & 1) ? art[x] : 0u;
 	}
 
-	// Otherwise we tell the specific shelter to process the hit
-	mShelters[closestIndex]->Hit();
+	D3D11_BOX box = { 0, (UINT)first, 0, (UINT)w, (UINT)last + 1, 1 };
+	WinUtil::Get().GetD3D().GetDeviceCtx().UpdateSubresource(mMaskTextures[_shelter], 0, &box,
+		&mPixels[first * w], w * sizeof(uint32_t), 0);
 }
 
-// CheckLaserCollision function: Checks and handles collisions between lasers and shelters.
-void ShelterManager::CheckLaserCollision(Laser* _laser)
+// UpdateArt function: Cheap once the art is in, the textures are redone in full as every standing pixel changes.
+void ShelterManager::UpdateArt()
 {
-	Game& gm = Game::Get();
-
-	// Check for collisions between the laser and each shelter.
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
+	if (mArtLoaded)
+		return;
+	if (!sSheetImage.valid())
 	{
-		if (mShelters[i] != nullptr && mShelters[i]->mActive)
-		{
-			// Check if one object is to the mLeft of the other
-			if (mShelters[i]->mBoundingBox.mRight < _laser->mBoundingBox.mLeft || _laser->mBoundingBox.mRight < mShelters[i]->mBoundingBox.mLeft)
-				continue; // No collision on the X axis
-
-			// Check if one object is above the other
-			if (mShelters[i]->mBoundingBox.mTop > _laser->mBoundingBox.mBottom || _laser->mBoundingBox.mTop > mShelters[i]->mBoundingBox.mBottom)
-				continue; // No collision on the Y axis
-
-			// If past this then it hit this shelter
-
-			// Handle the hit and play sound effects.
-
-			_laser->mActive = false;  // Deactivate the laser
-			_laser->mBoundingBox.UpdateBox(0.0f, 0.0f, 0.0f, 0.0f);
+		DBOUT("Shelters drawn without their art, the sprite sheet was loaded before they asked for it\n");
+		mArtLoaded = true;
+		return;
+	}
+	if (sSheetImage.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
 
-			// Tell the shelter it was hit
-			mShelters[i]->Hit();
-			gm.GetAudMgr().CreateSFXInstance(AudioManager::SoundList::HIT); // Trigger hit sound
-			return;
-		}
+	mArtLoaded = true;
+	TextureLoader::ResultPtr result = sSheetImage.get();
+	if (!result->mOk)
+	{
+		DBOUT("Shelters drawn without their art, " << result->mPath << ": " << result->mError << "\n");
+		return;
 	}
+	LoadArt(result->mImage);
+	mUploadedVersions.assign(GC::NUM_SHELTERS, UINT32_MAX);  // Newer than any mask so UpdateTexture redoes them all
 }
 
-// CheckMissileCollision function: Checks and handles collisions between missiles and shelters.
-void ShelterManager::CheckMissileCollision(Missile* _missile)
+// LoadArt function: Each mask pixel gets the average of the sheet pixels it covers, weighted by
+// their alpha so the see through edges don't darken it. The flat shelter colour is kept if the
+// sheet isn't in a 32 bit RGBA or BGRA format that can be read here.
+void ShelterManager::LoadArt(const DdsImage& _sheet)
 {
-	Game& gm = Game::Get();
+	const int w = GC::SHELTER_MASK_WIDTH, h = GC::SHELTER_MASK_HEIGHT;
+	bool rgba = _sheet.mFormat == Dds::FORMAT_R8G8B8A8_UNORM || _sheet.mFormat == Dds::FORMAT_R8G8B8A8_UNORM_SRGB;
+	bool bgra = _sheet.mFormat == Dds::FORMAT_B8G8R8A8_UNORM || _sheet.mFormat == Dds::FORMAT_B8G8R8A8_UNORM_SRGB;
+	uint32_t frameW = _sheet.mWidth / GC::SHELTER_TEXTURE_STATES, frameH = _sheet.mHeight;
+	if ((!rgba && !bgra) || frameW == 0 || frameH == 0)
+	{
+		DBOUT("Shelters drawn without their art, the sprite sheet isn't 32 bit RGBA\n");
+		return;
+	}
 
-	// Check for collisions between the missile and each shelter.
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
+	const DdsImage::Level& level = _sheet.mLevels[0];
+	const uint8_t* pixels = _sheet.GetData() + level.mOffset;
+	for (int y = 0; y < h; y++)
 	{
-		if (mShelters[i] != nullptr && mShelters[i]->mActive)
+		uint32_t y0 = y * frameH / h, y1 = std::max(y0 + 1, (y + 1) * frameH / h);
+		for (int x = 0; x < w; x++)
 		{
-			// Check if one object is to the mLeft of the other
-			if (mShelters[i]->mBoundingBox.mRight < _missile->mBoundingBox.mLeft || _missile->mBoundingBox.mRight < mShelters[i]->mBoundingBox.mLeft)
-				continue; // No collision on the X axis
-
-			// Check if one object is above the other
-			if (mShelters[i]->mBoundingBox.mTop > _missile->mBoundingBox.mBottom || _missile->mBoundingBox.mTop > mShelters[i]->mBoundingBox.mBottom)
-				continue; // No collision on the Y axis
-
-			// If past this then it hit this shelter
-			
-			// Handle the hit and play sound effects.
-
-			_missile->mActive = false;  // Deactivate the laser
-			gm.GetAudMgr().CreateSFXInstance(AudioManager::SoundList::EXPLOSION); // Trigger explosion sound
-
+			uint32_t x0 = x * frameW / w, x1 = std::max(x0 + 1, (x + 1) * frameW / w);
+			uint32_t sum[4] = {};
+			for (uint32_t sy = y0; sy < y1; sy++)
+			{
+				const uint8_t* texel = pixels + sy * level.mRowPitch + x0 * 4;
+				for (uint32_t sx = x0; sx < x1; sx++, texel += 4)
+				{
+					sum[0] += texel[0] * texel[3];
+					sum[1] += texel[1] * texel[3];
+					sum[2] += texel[2] * texel[3];
+					sum[3] += texel[3];
+				}
+			}
 
-			// Tell the laser it was hit
-			mShelters[i]->Hit();
-			gm.GetAudMgr().CreateSFXInstance(AudioManager::SoundList::HIT); // Trigger hit sound
-			return;
+			uint32_t count = (x1 - x0) * (y1 - y0);
+			uint8_t out[4] = {};
+			if (sum[3] > 0)
+			{
+				for (int c = 0; c < 3; c++)
+					out[c] = (uint8_t)(sum[c] / sum[3]);
+				out[3] = (uint8_t)(sum[3] / count);
+			}
+			if (bgra)
+				std::swap(out[0], out[2]);
+			memcpy(&mArt[y * w + x], out, sizeof(uint32_t));
 		}
 	}
 }
-
-// AnySheltersLeft function: Checks if there are any active shelters left.
-bool ShelterManager::AnySheltersLeft() const
-{
-	// Return true if there's at least one active shelter, otherwise false.
-	for (int i = 0; i < GC::NUM_SHELTERS; i++)
-		if (mShelters[i] != nullptr && mShelters[i]->mActive)
-			return true;
-
-	return false;
-}
@@ -1,44 +1,48 @@
 #pragma once
 
+#include <vector>
+
 #include "GameObj.h"
 #include "PlayMode.h"
-#include "Enemy.h"
 #include "Game.h"
 
-// Shelter class: Represents a protective structure in the game.
-class Shelter : public GameObj
-{
-public:
-    Shelter(MyD3D& d3d);
-    void Update(float dTime) override;  // Update the shelter's state each frame.
-    void UpdateTexture();               // Update the shelter's texture to reflect damage.
-    void Hit();                         // Respond to being hit by an enemy or projectile.
-
-private:
-    int mLifes = 10;                 // The number of hits the shelter can take before being destroyed.
-    int mTextureState = 0;           // Current state of the shelter's texture (to show damage).
-    float mShelterRectRightAmt = 0;  // Amount to adjust the texture rectangle for damage states.
-
-    const static int mTextureStates = 10;  // Number of texture states to show different damage levels.
-};
-
-// ShelterManager class: Manages a collection of shelters in the game.
+// ShelterManager class: Draws the collection of shelters in the game.
+// Shelter damage and collisions are handled by the Simulation that PlayMode wraps,
+// each shelter is drawn from a texture that mirrors its damage mask pixel for pixel, every
+// standing pixel showing the sprite sheet's art under it.
 class ShelterManager : public GameObj
 {
 public:
-    ShelterManager(MyD3D& d3d, PlayMode& pM);  // Constructor to initialize the shelter manager.
-    void Update(float dTime) override;         // Update each shelter managed by this class.
+    ShelterManager(MyD3D& d3d, PlayMode& pM);  // Constructor to create the shelter textures.
+    ~ShelterManager();                         // Destructor to release our references to them.
+    void Update(float dTime) override {}       // Nothing to do, the simulation damages the shelters.
     void Render(float dTime, DirectX::SpriteBatch& batch) override;  // Render the shelters.
+    bool BindTextures() override;                                    // Size the shelters once the sprite sheet has loaded.
+
+    // Screen size of a shelter, used to size the simulation's colliders. Zero until BindTextures is true.
+    DirectX::SimpleMath::Vector2 GetShelterSize() const { return mShelterSize; }
 
-    void Hit(float _hitX);  // Handle a hit on the shelter closest to the specified X coordinate.
+private:
+    // UpdateTexture function: Regenerates the rows of a shelter's texture that changed since it was last drawn.
+    void UpdateTexture(size_t _shelter, const ShelterMask& _mask);
 
-    void CheckLaserCollision(Laser* _laser);        // Check and handle collisions with lasers.
-    void CheckMissileCollision(Missile* _missile);  // Check and handle collisions with missiles.
+    // UpdateArt function: Builds mArt once the texture loader has read the sprite sheet, never waits for it.
+    void UpdateArt();
 
-    bool AnySheltersLeft() const;  // Check if any shelters are still active.
+    // LoadArt function: Scales the first frame of the sprite sheet down to one texel per mask pixel.
+    void LoadArt(const DdsImage& _sheet);
 
-private:
     PlayMode* mMyMode;  // Pointer to the game mode that owns this shelter manager.
 
-    Shelter* mShelters[GC::NUM_SHELTERS];  // Array of shelters managed by this class.
-};
\ No newline at end of file
+    std::vector<Sprite> mShelterSprs;                // One sprite for each shelter so each can show its own damage.
+    std::vector<ID3D11Texture2D*> mMaskTextures;     // Texture each sprite draws, one texel per mask pixel.
+    std::vector<uint32_t> mUploadedVersions;         // Mask version each texture was last brought up to date with.
+    std::vector<uint32_t> mPixels;                   // Scratch rows for uploading.
+    std::vector<uint32_t> mArt;                      // Undamaged shelter, the texel each standing mask pixel shows.
+    bool mArtLoaded = false;                         // mArt is the flat shelter colour until the sheet is read.
+    DirectX::SimpleMath::Vector2 mShelterSize;       // Screen size of a shelter, from the sprite sheet mSpr loads.
+
+    // The sprite sheet's image from the texture loader. The cache only hands it out while the
+    // sheet is loading, so it's kept for the shelters of the games after the first.
+    static TextureLoader::Future sSheetImage;
+};
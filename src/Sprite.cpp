@@ -65,12 +65,16 @@ Sprite& Sprite::operator=(const Sprite& rhs) {
     mpTex = rhs.mpTex;
     mpTexData = rhs.mpTexData;
     mAnim = rhs.mAnim;
+    mPendingTex = rhs.mPendingTex;
     return *this;
 }
 
-// Draw function: Renders the sprite using the provided SpriteBatch.
+// Draw function: Renders the sprite using the provided SpriteBatch, nothing if its texture isn't set yet.
 void Sprite::Draw(SpriteBatch& batch)
 {
+    if (!mpTex)
+        return;
+
     // Draw the sprite with current properties.
     batch.Draw(mpTex, mPos, &(RECT)mTexRect, colour, rotation, origin, scale, DirectX::SpriteEffects::SpriteEffects_None, depth);
 }
@@ -89,6 +93,32 @@ void Sprite::SetTex(ID3D11ShaderResourceView& tex, const RECTF& texRect)
     }
 }
 
+// RequestTex function: The file loads on the cache's threads, nothing that needs the texture can be done until BindTex.
+void Sprite::RequestTex(const std::string& fileName, const std::string& texName, const std::vector<RECTF>* frames)
+{
+    mD3D.GetTexCache().Request(fileName, texName, true, frames);
+    mPendingTex = TexCache::GetTexName(fileName, texName);
+}
+
+// BindTex function: Never waits, cheap once the texture is set so it can be called every frame.
+bool Sprite::BindTex()
+{
+    if (mpTex)
+        return true;
+
+    assert(!mPendingTex.empty() && "BindTex without RequestTex");
+    TexCache& cache = mD3D.GetTexCache();
+    ID3D11ShaderResourceView* p = cache.Find(mPendingTex);
+    if (!p)
+    {
+        assert(cache.IsLoading(mPendingTex) && "Failed to load a sprite's texture");
+        return false;
+    }
+
+    SetTex(*p);
+    return true;
+}
+
 // SetTexRect function: Updates the texture rectangle for the sprite.
 void Sprite::SetTexRect(const RECTF& texRect) {
     mTexRect = texRect;
@@ -103,9 +133,9 @@ void Sprite::Scroll(float x, float y) {
     mTexRect.bottom += y;
 }
 
-// SetFrame function: Sets the sprite's frame for animation.
+// SetFrame function: Sets the sprite's frame for animation, from the texture data SetTex looked up.
 void Sprite::SetFrame(int id)
 {
-    const TexCache::Data& data = mD3D.GetTexCache().Get(mpTex);
-    SetTexRect(data.frames.at(id)); // Set the texture rectangle based on frame id.
+    assert(mpTexData);
+    SetTexRect(mpTexData->frames.at(id)); // Set the texture rectangle based on frame id.
 }
\ No newline at end of file
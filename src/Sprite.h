@@ -46,6 +46,7 @@ private:
 	DirectX::SimpleMath::Vector2 scale;  // Scaling factor of the sprite.
 	const TexCache::Data* mpTexData;     // Pointer to the texture data.
 	Animate mAnim;                       // Animation handler for the sprite.
+	std::string mPendingTex;             // Nickname of the texture RequestTex asked for, until BindTex sets it.
 
 public:
 	DirectX::SimpleMath::Vector2 mPos;   // Position of the sprite.
@@ -78,6 +79,12 @@ public:
 	// SetTex method: Changes the texture of the sprite. Optionally isolates part of the texture.
 	void SetTex(ID3D11ShaderResourceView& tex, const RECTF& texRect = RECTF{ 0,0,0,0 });
 
+	// RequestTex method: Starts loading a texture without waiting for it, BindTex sets it once it's ready.
+	void RequestTex(const std::string& fileName, const std::string& texName = "", const std::vector<RECTF>* frames = nullptr);
+
+	// BindTex method: Sets the requested texture if the cache has created it, true once the sprite has one.
+	bool BindTex();
+
 	// SetTexRect method: Changes which part of the texture is displayed.
 	void SetTexRect(const RECTF& texRect);
 
@@ -102,6 +109,7 @@ public:
 		assert(mpTex);
 		return *mpTex;
 	}
+	bool HasTex() const { return mpTex != nullptr; }  // False until SetTex, such a sprite draws nothing.
 	void SetScale(const DirectX::SimpleMath::Vector2& s) {
 		scale = s;
 	}
@@ -2,74 +2,230 @@
 
 #include <DDSTextureLoader.h>
 #include <filesystem>
+#include <chrono>
 
 using namespace std;
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
+// The parser hands back DXGI_FORMAT values without including any Direct3D headers.
+static_assert(Dds::FORMAT_R8G8B8A8_UNORM == DXGI_FORMAT_R8G8B8A8_UNORM && Dds::FORMAT_B8G8R8A8_UNORM == DXGI_FORMAT_B8G8R8A8_UNORM &&
+	Dds::FORMAT_BC1_UNORM == DXGI_FORMAT_BC1_UNORM && Dds::FORMAT_BC3_UNORM == DXGI_FORMAT_BC3_UNORM &&
+	Dds::FORMAT_BC7_UNORM_SRGB == DXGI_FORMAT_BC7_UNORM_SRGB && Dds::FORMAT_B4G4R4A4_UNORM == DXGI_FORMAT_B4G4R4A4_UNORM,
+	"Dds formats are numbered as DXGI_FORMAT");
+
+
 // Release function: Releases all textures stored in the cache.
 void TexCache::Release()
 {
+	std::lock_guard<std::mutex> lock(mMutex);
 	for (auto& pair : mCache)
 		ReleaseCOM(pair.second.pTex);  // Release each texture resource.
 	mCache.clear();  // Clear the texture cache.
+	mByHandle.clear();
+	mPending.clear();  // The loader finishes reading them, no one's waiting.
 }
 
-// LoadTexture function: Loads a texture, either from the cache or from the file.
+// LoadTexture function: Loads a texture, either from the cache, from a request already loading, or from the file.
 ID3D11ShaderResourceView* TexCache::LoadTexture(ID3D11Device* pDevice, const std::string& fileName, const std::string& texName,
 	bool appendPath, const vector<RECTF>* frames)
 {
-	string name = texName;
-	// Generate a texture name from the file name if texName is empty.
-	if (name.empty())
-	{
-		std::filesystem::path p(fileName);
-		name = p.stem().string();
-	}
+	std::unique_lock<std::mutex> lock(mMutex);
+	string name = GetTexName(fileName, texName);
 
 	// Search the cache for the texture.
 	MyMap::iterator it = mCache.find(name);
 	if (it != mCache.end())
 		return (*it).second.pTex;  // Return the cached texture.
 
-	// Prepare the file path for loading.
-	const string* pPath = &fileName;
-	string path;
-	if (appendPath)
+	// Wait for just this file, and without the cache, so Update and the model loading thread
+	// carry on while it's read. Whoever has the cache once it's ready creates the texture.
+	TextureLoader::Future future = (*RequestLocked(fileName, name, appendPath, frames)).second.future;
+	lock.unlock();
+	future.wait();
+	lock.lock();
+
+	ID3D11ShaderResourceView* pT = nullptr;
+	it = mCache.find(name);
+	if (it != mCache.end())
+		pT = (*it).second.pTex;  // Update got to it first
+	else
+	{
+		PendingMap::iterator pending = mPending.find(name);
+		if (pending != mPending.end())
+			pT = Finish(pDevice, pending);
+	}
+	assert(pT);
+	return pT;
+}
+
+// Request function: Loads a texture's file in the background, Update or LoadTexture creates the texture.
+TextureLoader::Future TexCache::Request(const std::string& fileName, const std::string& texName, bool appendPath, const std::vector<RECTF>* _frames)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	string name = GetTexName(fileName, texName);
+	if (mCache.find(name) != mCache.end())
+		return TextureLoader::Future();
+
+	return (*RequestLocked(fileName, name, appendPath, _frames)).second.future;
+}
+
+// Update function: Skips a frame rather than wait if the model loading thread has the cache.
+void TexCache::Update(ID3D11Device* pDevice)
+{
+	std::unique_lock<std::mutex> lock(mMutex, std::try_to_lock);
+	if (!lock.owns_lock())
+		return;
+
+	PendingMap::iterator it = mPending.begin();
+	while (it != mPending.end())
+	{
+		PendingMap::iterator next = std::next(it);
+		if ((*it).second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			Finish(pDevice, it);
+		it = next;
+	}
+}
+
+// Find function: Never waits for a texture that's still loading.
+ID3D11ShaderResourceView* TexCache::Find(const std::string& texName)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	MyMap::iterator it = mCache.find(texName);
+	return it != mCache.end() ? (*it).second.pTex : nullptr;
+}
+
+bool TexCache::IsLoading(const std::string& texName)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mPending.find(texName) != mPending.end();
+}
+
+TexCache::Data& TexCache::Get(const std::string& texName)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCache.at(texName);
+}
+
+// Add function: Stores a texture that wasn't loaded from a file, releasing any it replaces.
+void TexCache::Add(const std::string& texName, ID3D11ShaderResourceView* pTex)
+{
+	assert(pTex);
+	std::lock_guard<std::mutex> lock(mMutex);
+	MyMap::iterator it = mCache.find(texName);
+	if (it != mCache.end())
+	{
+		mByHandle.erase((*it).second.pTex);
+		ReleaseCOM((*it).second.pTex);
+		mCache.erase(it);
+	}
+	mPending.erase(texName);  // Anything still loading under the name would replace this one.
+
+	Insert(texName, Data(texName, pTex, GetDimensions(pTex)));
+}
+
+// Get function: Finds a texture by its DirectX handle, one hash lookup however many textures there are.
+const TexCache::Data& TexCache::Get(ID3D11ShaderResourceView* pTex)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	HandleMap::iterator it = mByHandle.find(pTex);
+	assert(it != mByHandle.end());
+	return *(*it).second;
+}
+
+// GetTexName function: Generate a texture name from the file name if texName is empty.
+string TexCache::GetTexName(const std::string& fileName, const std::string& texName)
+{
+	if (!texName.empty())
+		return texName;
+
+	std::filesystem::path p(fileName);
+	return p.stem().string();
+}
+
+// RequestLocked function: Queues the file unless it's already loading, frames given now replace any given with the request.
+TexCache::PendingMap::iterator TexCache::RequestLocked(const std::string& fileName, const std::string& name, bool appendPath,
+	const std::vector<RECTF>* _frames)
+{
+	PendingMap::iterator it = mPending.find(name);
+	if (it == mPending.end())
 	{
-		path = mAssetPath + fileName;  // Append the asset path.
-		pPath = &path;
+		// Prepare the file path for loading.
+		Pending pending;
+		pending.fileName = fileName;
+		pending.path = appendPath ? mAssetPath + fileName : fileName;
+		pending.future = mLoader.Load(pending.path);
+		it = mPending.insert(PendingMap::value_type(name, pending)).first;
 	}
-	std::wstring ws(pPath->begin(), pPath->end());
 
-	// Load the texture from the file.
-	DDS_ALPHA_MODE alpha;
-	ID3D11ShaderResourceView* pT;
-	if (CreateDDSTextureFromFile(pDevice, ws.c_str(), nullptr, &pT, 0, &alpha) != S_OK)
+	if (_frames)
+		(*it).second.frames = *_frames;
+	return it;
+}
+
+// Finish function: A file the parser doesn't handle is loaded the way it always was, by DirectXTK.
+// Returns nullptr if that can't load it either, it's up to the caller whether that's fatal.
+ID3D11ShaderResourceView* TexCache::Finish(ID3D11Device* pDevice, PendingMap::iterator it)
+{
+	const string name = (*it).first;
+	Pending pending = (*it).second;
+	mPending.erase(it);
+
+	TextureLoader::ResultPtr result = pending.future.get();
+	ID3D11ShaderResourceView* pT = result->mOk ? CreateTexture(pDevice, result->mImage) : nullptr;
+	if (!pT)
 	{
-		DBOUT("Cannot load " << *pPath << "\n");
-		assert(false);
+		if (!result->mOk)
+			DBOUT("Cannot parse " << pending.path << " (" << result->mError << "), loading it with DirectXTK\n");
+
+		std::wstring ws(pending.path.begin(), pending.path.end());
+		DDS_ALPHA_MODE alpha;
+		if (CreateDDSTextureFromFile(pDevice, ws.c_str(), nullptr, &pT, 0, &alpha) != S_OK)
+		{
+			DBOUT("Cannot load " << pending.path << "\n");
+			return nullptr;
+		}
 	}
 
 	// Save the loaded texture in the cache.
-	assert(pT);
-	mCache.insert(MyMap::value_type(name, Data(fileName, pT, GetDimensions(pT), frames)));
+	Insert(name, Data(pending.fileName, pT, GetDimensions(pT), &pending.frames));
 	return pT;
 }
 
-// Get function: Finds a texture by its DirectX handle.
-const TexCache::Data& TexCache::Get(ID3D11ShaderResourceView* pTex)
+// CreateTexture function: The device upload, every mip level goes in as the texture's initial data.
+ID3D11ShaderResourceView* TexCache::CreateTexture(ID3D11Device* pDevice, const DdsImage& image)
 {
-	MyMap::iterator it = mCache.begin();
-	Data* p = nullptr;
-	while (it != mCache.end() && !p)
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = image.mWidth;
+	desc.Height = image.mHeight;
+	desc.MipLevels = (UINT)image.mLevels.size();
+	desc.ArraySize = 1;
+	desc.Format = (DXGI_FORMAT)image.mFormat;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	vector<D3D11_SUBRESOURCE_DATA> levels(image.mLevels.size());
+	for (size_t i = 0; i < levels.size(); i++)
 	{
-		if ((*it).second.pTex == pTex)
-			p = &(*it).second;
-		++it;
+		levels[i].pSysMem = image.GetData() + image.mLevels[i].mOffset;
+		levels[i].SysMemPitch = (UINT)image.mLevels[i].mRowPitch;
+		levels[i].SysMemSlicePitch = (UINT)image.mLevels[i].mSize;
 	}
-	assert(p);
-	return *p;
+
+	ID3D11Texture2D* pTex = nullptr;
+	ID3D11ShaderResourceView* pSRV = nullptr;
+	if (pDevice->CreateTexture2D(&desc, levels.data(), &pTex) == S_OK)
+		pDevice->CreateShaderResourceView(pTex, nullptr, &pSRV);
+	ReleaseCOM(pTex);  // The view keeps its own reference
+	return pSRV;
+}
+
+// Insert function: Adds a texture to the cache and indexes it by handle too.
+void TexCache::Insert(const std::string& texName, const Data& data)
+{
+	MyMap::iterator it = mCache.insert(MyMap::value_type(texName, data)).first;
+	mByHandle[data.pTex] = &(*it).second;
 }
 
 // GetDimensions function: Retrieves the dimensions of the texture.
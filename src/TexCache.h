@@ -2,9 +2,11 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 #include <d3d11.h>
 
 #include "D3DUtil.h"
+#include "TextureLoader.h"
 
 // RECTF Struct: Defines a rectangle with floating-point coordinates.
 struct RECTF
@@ -45,6 +47,12 @@ struct RECTF
 };
 
 // TexCache Class: Manages texture resources to ensure each texture is only loaded once.
+// Files are read and parsed on the loader's threads (see TextureLoader), only creating the
+// texture from the parsed image happens on the calling thread. Request starts a load without
+// waiting for it, so a mode can ask for everything it needs up front and the files load side
+// by side. LoadTexture still returns a ready texture, waiting only for that file (and without
+// holding up the rest of the cache) if it isn't done yet. Sprites never wait, they Request
+// theirs (see Sprite::RequestTex) and pick it up with Find once Update has created it.
 class TexCache
 {
 public:
@@ -69,28 +77,74 @@ public:
 		std::vector<RECTF> frames;  // Frame data for animated textures.
 	};
 
-	// Release all textures managed by this cache.
+	// Release all textures managed by this cache, requests still loading are dropped.
 	void Release();
 
 	// Load texture if it's new, or return handle if already loaded.
 	ID3D11ShaderResourceView* LoadTexture(ID3D11Device* pDevice, const std::string& fileName, const std::string& texName = "", bool appendPath = true, const std::vector<RECTF>* _frames = nullptr);
 
+	// Start loading a texture on the loader's threads and return straight away. The future is
+	// ready once the file is parsed, and isn't valid if the texture was already loaded.
+	TextureLoader::Future Request(const std::string& fileName, const std::string& texName = "", bool appendPath = true, const std::vector<RECTF>* _frames = nullptr);
+
+	// Create every requested texture whose file is ready, never waiting on the rest. Call once a frame.
+	void Update(ID3D11Device* pDevice);
+
+	// Find a texture by nickname, nullptr while it's still loading so the caller can draw a placeholder.
+	ID3D11ShaderResourceView* Find(const std::string& texName);
+	bool IsLoading(const std::string& texName);  // Requested but not created yet.
+
+	// Add a texture created at runtime, the cache takes ownership and replaces any texture with the same name.
+	void Add(const std::string& texName, ID3D11ShaderResourceView* pTex);
+
 	// Set and get asset path for textures.
 	void SetAssetPath(const std::string& path) { mAssetPath = path; }
 	const std::string& GetAssetPath() const { return mAssetPath; }
 
 	// Retrieve texture data by nickname for fast access.
-	Data& Get(const std::string& texName) { return mCache.at(texName); }
+	Data& Get(const std::string& texName);
 
-	// Find a texture by handle (slower method).
+	// Find a texture by handle, through the handle index so it costs the same as by name.
 	const Data& Get(ID3D11ShaderResourceView* pTex);
 
+	// The nickname a texture is cached under, texName or else the file name without its folder and extension.
+	static std::string GetTexName(const std::string& fileName, const std::string& texName);
+
 private:
+	// Pending struct: A requested texture whose file is still being read, or is waiting to be created.
+	struct Pending
+	{
+		std::string fileName;
+		std::string path;           // fileName with the asset path added, if it was.
+		std::vector<RECTF> frames;
+		TextureLoader::Future future;
+	};
+	typedef std::unordered_map<std::string, Pending> PendingMap;  // By nickname, like mCache.
+
+	static const size_t LOADER_THREADS = 4;  // Enough to keep the disk busy without crowding the game's threads.
+
 	// Get the dimensions of a texture.
 	DirectX::SimpleMath::Vector2 GetDimensions(ID3D11ShaderResourceView* pTex);
 
+	// The rest expect mMutex to be held.
+	PendingMap::iterator RequestLocked(const std::string& fileName, const std::string& name, bool appendPath, const std::vector<RECTF>* _frames);
+	ID3D11ShaderResourceView* Finish(ID3D11Device* pDevice, PendingMap::iterator it);  // Waits for the file, creates and caches the texture, nullptr if it can't.
+	ID3D11ShaderResourceView* CreateTexture(ID3D11Device* pDevice, const DdsImage& image);
+	void Insert(const std::string& texName, const Data& data);
+
 	typedef std::unordered_map<std::string, Data> MyMap;  // Hash map for texture data.
 	MyMap mCache;  // Cache of texture data.
 
+	// Handle index: Each texture's handle to its entry in mCache. Entries in an unordered_map
+	// never move, so the pointers stay good until that texture is replaced or released.
+	typedef std::unordered_map<const ID3D11ShaderResourceView*, Data*> HandleMap;
+	HandleMap mByHandle;
+
+	PendingMap mPending;      // Requested textures not created yet.
+	TextureLoader mLoader{ LOADER_THREADS };
+
+	// Guards the maps, the models are loaded (textures and all) on a thread of their own.
+	std::mutex mMutex;
+
 	std::string mAssetPath;  // Asset path for textures.
 };
\ No newline at end of file
@@ -22,6 +22,26 @@ void UICounter::SetPosition(const Vector2& position)
     mDownArrow.mPos.y = mText.mPos.y;
 }
 
+// BindArrows function: The sheet has the up arrow on its left half and the down arrow on its right.
+bool UICounter::BindArrows()
+{
+    if (mUpArrow.HasTex() && mDownArrow.HasTex())
+        return true;
+    if (!mUpArrow.BindTex() || !mDownArrow.BindTex())
+        return false;
+
+    RECTF arrowsRect = mUpArrow.GetTexRect();
+    arrowsRect.right /= 2.0f;
+    mUpArrow.SetTexRect(arrowsRect);
+    mUpArrow.origin = (mUpArrow.GetTexData().dim / 2.0f) / 2.0f;
+
+    arrowsRect = mDownArrow.GetTexRect();
+    arrowsRect.left = arrowsRect.right / 2.0f;
+    mDownArrow.SetTexRect(arrowsRect);
+    mDownArrow.origin = (mDownArrow.GetTexData().dim / 2.0f) / 2.0f;
+    return true;
+}
+
 void UICounter::Increment()
 {
     if (mValue < mMaxValue) {
@@ -30,6 +30,10 @@ public:
     // TriggerCallback function: Executes the callback function, if defined.
     void TriggerCallback();
 
+    // BindArrows function: Gives the arrows their halves of the arrow sheet once it has loaded, never waits for it.
+    // True once they have them, the arrows aren't drawn or clickable until then.
+    bool BindArrows();
+
     // Draw function: Renders the counter's text and arrow sprites.
     void Draw(DirectX::SpriteBatch& batch);
 
@@ -188,6 +188,10 @@ void UIManager::HandleCounterInput()
     DirectX::SimpleMath::Vector2 mousePos = gm.mMKIn.GetMousePos(true);
 
     for (auto& counter : mCounters) {
+        // The arrows can't be clicked until they have their texture
+        if (!counter.BindArrows())
+            continue;
+
         // Check if the mouse clicks on the up arrow
         if (gm.mMKIn.GetMouseButtonDown(MouseAndKeys::ButtonT::LBUTTON) &&
             counter.GetUpArrowBounds().Contains(mousePos)) {
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "GameConstants.h"
+
 // GC (Game Constants) Namespace: Contains constants used throughout the game for easy management and accessibility.
+// Gameplay constants shared with the simulation core are in GameConstants.h.
 namespace GC {
 	// UI Constants
 	const DirectX::SimpleMath::Vector4 UI_SELECT_COLOR = { 0.5f, 0.5f, 0.5f, 1.0f };    // Color for selected UI element.
@@ -18,6 +21,7 @@ namespace GC {
 	// PlayMode Constants
 	const float GAME_OVER_TRANSITION_TIME = 5.0f;  // Time before transitioning to the game over state.
 	const int BGND_LAYERS = 2;                     // Number of background layers in PlayMode.
+	const uint32_t SHELTER_PIXEL_COLOUR = 0xFF3CD23C;  // Colour of a standing shelter pixel if the sprite sheet can't be read (R8G8B8A8, so read as ABGR).
 	const RECTF MISSILE_SPIN_FRAMES[]{
 		// Frames for animating missile spin.
 		{ 1,  0, 36, 52},
@@ -31,51 +35,18 @@ namespace GC {
 	const float SCROLL_LIST_MAX = 1.1f;
 	const float SCROLL_LIST_MIN = -20.0f;
 
-	// Player Constants
-	const float SHIP_SPEED = 350.0f;     // Speed of the player's ship.
-	const float MISSILE_SPEED = 450.0f;  // Speed of the missiles fired by the player.
+	// Background Constants
 	const float SCROLL_SPEED = 50.0f;	 // Speed of the background scroll in PlayMode.
-	const float FIRE_DELAY = 0.3f;		 // Delay between fires.
-
-	// Shelter Constants
-	const static int NUM_SHELTERS = 4;			   // Number of shelters in the game.
-	const float SHELTER_OFFSET_Y = 110.0f;         // Vertical offset of the shelters.
-	const static int SHELTER_TEXTURE_STATES = 10;  // Number of texture states for the shelter damage.
-
-	// Enemy Constants
-	const static int NUM_ENEMIES = 55;  // Int that holds the maximum amount of enemies
-
-	const float ENEMY_SPEED_INC = 3.5f;    // Speed increase of enemies over time.
-	const float ENEMY_UFO_SPEED = 200.0f;  // Speed of the UFO enemy.
-	const float LASER_SPEED = 200.0f;      // Speed of the enemy lasers.
-
-	const static int ENEMY_TIME_BTWN_SHOTS = 1;  // Amount of time between the chance to shoot
-	const static int ENEMY_SHOOT_CHANCE = 3;     // (0-100) Example: 34 equals a 34% chance for the enemy to shoot
-
-	const static int ENEMY_UFO_CHANCE = 5;  // Chance of a ufo spawning (from 0-100) everytime the enemies move down
-
-	// Constant variables used for enemy behavior and positioning
-	const static int ENEMY_DOWNSTEP = 15;     // Vertical step for enemies after reaching a boundary
-	const static int ENEMY_LIMIT_OFFSET = 25;  // Offset from screen edges for enemy movement
-
-	// Enemy positioning and scoring values
-	const static int ENEMIES_PER_ROW = 11;   // Number of enemies per row
-	const static int NUM_ROWS = 5;           // Total number of rows of enemies
-	const static int ROWX_SPACING = 10;      // Horizontal spacing between rows
-	const static int ROWY_SPACING = 50;      // Vertical spacing between rows
-	const static int ENEMY_INITIAL_Y = 120;  // Initial Y position for the top row
-	const static int UFO_INITIAL_Y = 50;     // Initial Y position for the ufo
 
 	// Score Constants
 	const std::string SCORE_FILE_PATH = "data/scores.dat";             // Path to the score file.
-	const std::string ENCRYPT_KEY = "=ami%#Ip,Mo@l+sMI]/t$j$`KDwzbQ";  // Key for encrypting and decrypting scores.
-	const static int MAX_SCORES_SAVE = 100;                            // Maximum number of scores to save.
+	const static int MAX_SCORES_SHOWN = 100;                           // Number of scores listed on the score menu, every score is saved.
+	const float LEADERBOARD_REFRESH_TIME = 2.0f;                       // Seconds between asking the shared leaderboard for its top scores.
 
-	const static int OCTOPUS_POINTS = 10;          // Points for defeating an octopus enemy.
-	const static int CRAB_POINTS = 20;             // Points for defeating a crab enemy.
-	const static int SQUID_POINTS = 40;            // Points for defeating a squid enemy.
-	const int UFO_POINTS[4] = { 50,100,150,300 };  // Randomly selected points for defeating a UFO enemy.
-	const static int WAVE_FINISH_POINTS = 1000;    // Bonus points for completing a wave.
+	// Script Constants
+	const char* const SCRIPTS_PATH = "data/scripts";                                // Every .lua in here is run at startup.
+	const char* const GAME_VARIABLES_SCRIPT = "data/scripts/GameVariables.lua";  // Script GameVariables is read from.
+	const char* const SCRIPT_CACHE_PATH = "data/scripts/cache";                    // Cooked bytecode of the scripts.
 
 #if defined(DEBUG) || (_DEBUG)
 	// Debugging Constants
@@ -1,11 +1,14 @@
 #include <windows.h>
 #include <string>
+#include <cstring>
 #include <cassert>
 #include <d3d11.h>
 
 #include "WindowUtils.h"
 #include "LuaHelper.h"
 #include "Game.h"
+#include "FixedTimestep.h"
+#include "ScriptCache.h"
 
 using namespace std;
 using namespace DirectX;
@@ -36,9 +39,13 @@ LRESULT CALLBACK MainWndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 	return WinUtil::DefaultMssgHandler(hwnd, msg, wParam, lParam);
 }
 
-// Function to load and parse Lua scripts from a directory
+// Function to load and parse Lua scripts from a directory, from their cooked bytecode where it's up to date.
+// Launching with -cookscripts writes the bytecode for any script that had to be parsed.
 void LoadLuaScripts(lua_State* L, const std::string& directory)
 {
+	ScriptCache cache(GC::SCRIPT_CACHE_PATH);
+	cache.SetCooking(strstr(GetCommandLineA(), "-cookscripts") != nullptr);
+
 	WIN32_FIND_DATA findFileData;
 	HANDLE hFind = FindFirstFile((directory + "\\*.lua").c_str(), &findFileData);
 
@@ -50,13 +57,14 @@ void LoadLuaScripts(lua_State* L, const std::string& directory)
 	do
 	{
 		std::string filePath = directory + "\\" + findFileData.cFileName;
-		if (!LuaHelper::LuaOK(L, luaL_dofile(L, filePath.c_str())))
+		if (!cache.DoFile(L, filePath))
 		{
 			assert(false); // Assert if Lua script loading fails
 		}
 	} while (FindNextFile(hFind, &findFileData) != 0);
 
 	FindClose(hFind);
+	DBOUT("Loaded scripts, " << cache.GetHits() << " from bytecode and " << cache.GetMisses() << " parsed\n");
 }
 
 void EntryPoint(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE prevInstance,
@@ -80,34 +88,42 @@ void EntryPoint(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE prevInstance,
 	d3d.GetTexCache().SetAssetPath("data/");
 	d3d.GetFontCache().SetAssetPath("data/fonts/");
 
-	srand((unsigned int)time(0));  // Seed the random number generator.
-
 	// Initialize Lua
 	lua_State* L = luaL_newstate();
 	luaL_openlibs(L);  // Open main libraries for scripts
 
 	// Load and parse Lua scripts
-	LoadLuaScripts(L, "data/scripts");
+	LoadLuaScripts(L, GC::SCRIPTS_PATH);
 
 	// Register functions
 	lua_pushcfunction(L, LuaHelper::CustomPrint);
 	lua_setglobal(L, "print");
 
-	Dispatcher D;
-	D.Init(L);
+	new Game(L);  // Instantiate and initialize the Game object.
 
-	new Game(L, D);  // Instantiate and initialize the Game object.
+	// The game updates in fixed ticks however fast we render, so it plays the same on every machine.
+	// The game owns the timestep so reloading the variables changes the tick rate too.
+	Game& gm = Game::Get();
+	FixedTimestep& timestep = gm.GetTimestep();
 
 	// Main game loop.
 	bool canUpdateRender;
 	float dTime = 0;
-	Game& gm = Game::Get();
 	while (WinUtil::Get().BeginLoop(canUpdateRender))
 	{
 		if (canUpdateRender && dTime > 0)
 		{
-			gm.Update(dTime);  // Update game logic.
-			gm.Render(dTime);  // Render the game.
+			// Swap in any scripts saved since last frame and reset the scripts' budget.
+			gm.BeginFrame();
+
+			// Update game logic once for every tick due this frame.
+			int ticks = timestep.Advance(dTime);
+			for (int i = 0; i < ticks; i++)
+				gm.Update(timestep.GetStep());
+
+			// Render the game, blending between the last two ticks.
+			gm.SetInterpolation(timestep.GetAlpha());
+			gm.Render(dTime);
 		}
 		dTime = WinUtil::Get().EndLoop(canUpdateRender);  // Get the delta time for the next loop.
 	}
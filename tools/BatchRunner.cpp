@@ -0,0 +1,121 @@
+// BatchRunner: Plays many complete games at once for balance tuning and AI evaluation.
+// Every game is its own Simulation with its own seed, config and score, they are stepped
+// a slice at a time on a work stealing TaskPool and the aggregate frames per second is
+// reported for each thread count so the scaling can be checked.
+//
+// Usage: BatchRunner [games] [maxTicks] [threads...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include "Simulation.h"
+#include "TaskPool.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int SLICE_TICKS = 600;  // Ticks a task steps a game for before giving the thread back.
+static const float TICK_TIME = 1.0f / 60.0f;
+
+
+// BatchGame struct: One game of the batch, only ever touched by the task stepping it.
+struct BatchGame
+{
+    unsigned int mSeed = 0;
+    Simulation* mpSim = nullptr;
+    int mScore = 0;
+    int mWave = 0;
+    unsigned int mTicks = 0;
+};
+
+// StepSlice function: Steps a game for a slice of ticks, queues its next slice if it isn't over yet.
+// The game is created by its first slice so its memory is allocated by the thread that uses it.
+static void StepSlice(TaskPool& pool, BatchGame& game, const SimConfig& config, unsigned int maxTicks)
+{
+	if (!game.mpSim)
+		game.mpSim = new Simulation(config, game.mSeed);
+
+	Simulation& sim = *game.mpSim;
+	SimInput input;
+	input.mFire = true;
+
+	// Sweep back and forth, each seed with its own period so the games play out differently
+	unsigned int period = 60 + game.mSeed % 120;
+	for (int t = 0; t < SLICE_TICKS && !sim.IsGameOver() && sim.GetTicks() < maxTicks; t++)
+	{
+		input.mMoveX = ((sim.GetTicks() / period) % 2) ? 1.0f : -1.0f;
+		sim.Step(input, TICK_TIME);
+	}
+
+	if (!sim.IsGameOver() && sim.GetTicks() < maxTicks)
+	{
+		pool.Push([&pool, &game, &config, maxTicks] { StepSlice(pool, game, config, maxTicks); });
+		return;
+	}
+
+	game.mScore = sim.GetScore();
+	game.mWave = sim.GetWave();
+	game.mTicks = sim.GetTicks();
+	delete game.mpSim;
+	game.mpSim = nullptr;
+}
+
+// Run function: Plays the whole batch with the given amount of threads and prints the results.
+static void Run(size_t numGames, unsigned int maxTicks, size_t threads)
+{
+	SimConfig config;
+	std::vector<BatchGame> games(numGames);
+	for (size_t i = 0; i < numGames; i++)
+		games[i].mSeed = 1000 + (unsigned int)i;
+
+	Clock::time_point start = Clock::now();
+	{
+		TaskPool pool(threads);
+		threads = pool.GetThreadCount();
+
+		for (BatchGame& game : games)
+			pool.Push([&pool, &game, &config, maxTicks] { StepSlice(pool, game, config, maxTicks); });
+		pool.Wait();
+	}
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	// The checksum only depends on the seeds, so it must match for every thread count
+	unsigned long long ticks = 0, scores = 0, waves = 0, checksum = 0;
+	for (const BatchGame& game : games)
+	{
+		ticks += game.mTicks;
+		scores += game.mScore;
+		waves += game.mWave;
+		checksum = checksum * 31 + (unsigned long long)game.mScore * 7919 + game.mTicks;
+	}
+
+	printf("%3zu threads: %zu games, %llu ticks in %.3f s = %.0f fps, mean score %.1f, mean waves %.2f, checksum %016llx\n",
+		threads, numGames, ticks, seconds, (double)ticks / seconds,
+		(double)scores / numGames, (double)waves / numGames, checksum);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t hardwareThreads = std::thread::hardware_concurrency();
+	if (hardwareThreads == 0)
+		hardwareThreads = 1;
+
+	size_t numGames = argc > 1 ? (size_t)atoi(argv[1]) : hardwareThreads * 8;
+	unsigned int maxTicks = argc > 2 ? (unsigned int)atoi(argv[2]) : 36000;
+
+	std::vector<size_t> threadCounts;
+	for (int i = 3; i < argc; i++)
+		threadCounts.push_back((size_t)atoi(argv[i]));
+	if (threadCounts.empty())
+	{
+		threadCounts.push_back(1);
+		if (hardwareThreads > 1)
+			threadCounts.push_back(hardwareThreads);
+	}
+
+	for (size_t threads : threadCounts)
+		Run(numGames, maxTicks, threads);
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+// BoxKernelBench: Times the batched box overlap kernel against testing one pair at a time
+// with SimBox::Overlaps, which is how every collision site used to do it.
+//
+// Usage: BoxKernelBench [boxes] [queries]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "BoxKernel.h"
+#include "SimdConfig.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+
+// RandomBox function: A box of a similar size to the game's sprites somewhere on a 1024x768 screen.
+static SimBox RandomBox(std::mt19937& rng)
+{
+	std::uniform_real_distribution<float> posX(0.0f, 1024.0f), posY(0.0f, 768.0f), size(10.0f, 60.0f);
+
+	SimBox box;
+	box.UpdateBox(SimVec2(posX(rng), posY(rng)), SimVec2(size(rng), size(rng)));
+	return box;
+}
+
+// Run function: Calls test once per query box and returns the average nanoseconds per box tested.
+template<typename Test>
+static double Run(const std::vector<SimBox>& queries, size_t count, Test test)
+{
+	Clock::time_point start = Clock::now();
+	for (const SimBox& q : queries)
+		test(q);
+	double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+	return ns / ((double)queries.size() * (double)count);
+}
+
+int main(int argc, char* argv[])
+{
+	size_t numBoxes = argc > 1 ? (size_t)atoi(argv[1]) : 4096;
+	size_t numQueries = argc > 2 ? (size_t)atoi(argv[2]) : 4096;
+
+	std::mt19937 rng(1234);
+	std::vector<SimBox> boxes(numBoxes), queries(numQueries);
+	BoxBatch batch;
+	for (SimBox& b : boxes)
+	{
+		b = RandomBox(rng);
+		batch.Add(b);
+	}
+	for (SimBox& q : queries)
+		q = RandomBox(rng);
+
+	size_t words = BoxKernel::MaskWords(numBoxes);
+	std::vector<uint32_t> pairMasks(words), scalarMasks(words), simdMasks(words);
+	size_t mismatches = 0, hits = 0;
+
+	// Make sure all three agree before timing anything
+	for (const SimBox& q : queries)
+	{
+		std::fill(pairMasks.begin(), pairMasks.end(), 0);
+		for (size_t i = 0; i < numBoxes; i++)
+			if (q.Overlaps(boxes[i]))
+				pairMasks[i / 32] |= 1u << (i % 32);
+
+		BoxKernel::OverlapScalar(q, batch.GetLefts(), batch.GetTops(), batch.GetRights(), batch.GetBottoms(), numBoxes, scalarMasks.data());
+		BoxKernel::Overlap(q, batch.GetLefts(), batch.GetTops(), batch.GetRights(), batch.GetBottoms(), numBoxes, simdMasks.data());
+
+		if (pairMasks != scalarMasks || pairMasks != simdMasks)
+			mismatches++;
+		for (uint32_t w : pairMasks)
+			for (; w; w &= w - 1)
+				hits++;
+	}
+
+	double pairNs = Run(queries, numBoxes, [&](const SimBox& q)
+		{
+			std::fill(pairMasks.begin(), pairMasks.end(), 0);
+			for (size_t i = 0; i < numBoxes; i++)
+				if (q.Overlaps(boxes[i]))
+					pairMasks[i / 32] |= 1u << (i % 32);
+		});
+	double scalarNs = Run(queries, numBoxes, [&](const SimBox& q)
+		{
+			BoxKernel::OverlapScalar(q, batch.GetLefts(), batch.GetTops(), batch.GetRights(), batch.GetBottoms(), numBoxes, scalarMasks.data());
+		});
+	double simdNs = Run(queries, numBoxes, [&](const SimBox& q)
+		{
+			BoxKernel::Overlap(q, batch.GetLefts(), batch.GetTops(), batch.GetRights(), batch.GetBottoms(), numBoxes, simdMasks.data());
+		});
+
+#if defined(IA_SIMD_AVX)
+	const char* isa = "AVX";
+#elif defined(IA_SIMD_SSE)
+	const char* isa = "SSE2";
+#else
+	const char* isa = "scalar";
+#endif
+
+	printf("%zu boxes x %zu queries, %zu hits, %zu mismatches\n", numBoxes, numQueries, hits, mismatches);
+	printf("  SimBox::Overlaps pairs  %7.3f ns/box\n", pairNs);
+	printf("  BoxKernel scalar        %7.3f ns/box  (%.2fx)\n", scalarNs, pairNs / scalarNs);
+	printf("  BoxKernel %-6s        %7.3f ns/box  (%.2fx)\n", isa, simdNs, pairNs / simdNs);
+
+	return mismatches ? 1 : 0;
+}
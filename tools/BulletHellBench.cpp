@@ -0,0 +1,89 @@
+// BulletHellBench: Runs the bullet hell variant headless and reports how long each stage
+// of Simulation::Step takes with 1k, 10k and 100k lasers in flight.
+//
+// Usage: BulletHellBench [ticks] [projectiles...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Simulation.h"
+#include "SimdConfig.h"
+
+
+static const char* STAGE_NAMES[Simulation::STAGE_COUNT] = { "player", "move", "spawn", "enemies", "collision" };
+
+// Run function: Steps a bullet hell game for the given amount of ticks and prints the average time of each stage.
+static void Run(int projectiles, int ticks)
+{
+	SimConfig config;
+	config.mBulletHellProjectiles = projectiles;
+	config.mPlayerLifes = 1000000;  // Keep the player alive so every tick does the full amount of work
+
+	const float dTime = 1.0f / 60.0f;
+	Simulation* pSim = new Simulation(config, 42);
+	SimInput input;
+	input.mFire = true;
+
+	double totals[Simulation::STAGE_COUNT] = {};
+	size_t liveTotal = 0;
+	int restarts = 0;
+
+	// Give the lasers time to fill the screen before measuring, then time the rest
+	int warmup = (int)(GC::BULLET_HELL_FILL_TIME / dTime) * 3;
+	for (int t = 0; t < warmup + ticks; t++)
+	{
+		if (pSim->IsGameOver())
+		{
+			delete pSim;
+			pSim = new Simulation(config, 42 + ++restarts);
+		}
+
+		input.mMoveX = ((t / 120) % 2) ? 1.0f : -1.0f;
+		pSim->SetProfiling(t >= warmup);
+		pSim->Step(input, dTime);
+
+		if (t < warmup)
+			continue;
+
+		for (int s = 0; s < Simulation::STAGE_COUNT; s++)
+			totals[s] += pSim->GetStageTime((Simulation::Stage)s);
+		liveTotal += pSim->GetProjectiles().GetLiveCount();
+	}
+
+	double totalMs = 0.0;
+	printf("%d projectiles, %d ticks, %.0f live on average, %d restarts\n", projectiles, ticks, (double)liveTotal / ticks, restarts);
+	for (int s = 0; s < Simulation::STAGE_COUNT; s++)
+	{
+		double ms = totals[s] * 1000.0 / ticks;
+		totalMs += ms;
+		printf("  %-10s %8.4f ms/tick\n", STAGE_NAMES[s], ms);
+	}
+	printf("  %-10s %8.4f ms/tick\n", "total", totalMs);
+
+	delete pSim;
+}
+
+int main(int argc, char* argv[])
+{
+	int ticks = argc > 1 ? atoi(argv[1]) : 600;
+
+	std::vector<int> counts;
+	for (int i = 2; i < argc; i++)
+		counts.push_back(atoi(argv[i]));
+	if (counts.empty())
+		counts = { 1000, 10000, 100000 };
+
+#if defined(IA_SIMD_AVX)
+	printf("SIMD: AVX\n");
+#elif defined(IA_SIMD_SSE)
+	printf("SIMD: SSE2\n");
+#else
+	printf("SIMD: scalar\n");
+#endif
+
+	for (int count : counts)
+		Run(count, ticks);
+
+	return 0;
+}
@@ -0,0 +1,138 @@
+// LeaderboardBench: Times the leaderboard index against keeping the scores in a vector that
+// is sorted again after every new score, which is how ScoreSystem used to do it, and checks
+// every rank, position and top list it gives matches the sorted vector.
+//
+// Usage: LeaderboardBench [scores...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "Leaderboard.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int SORTED_INSERTS = 10;   // New scores timed going into the sorted vector.
+static const int QUERIES = 100000;
+static const size_t TOP_COUNT = 100;    // Length of the list the score menu shows.
+
+
+static double Since(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Ranks function: The order the old score vector was sorted in, with ties going to the earlier score.
+static bool Ranks(const Leaderboard::Entry& a, const Leaderboard::Entry& b)
+{
+	return a.mPoints != b.mPoints ? a.mPoints > b.mPoints : a.mId < b.mId;
+}
+
+// Run function: Benchmarks one history size, false if the index disagrees with the sorted vector.
+static bool Run(size_t count)
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> points(10, 50000);
+	std::vector<Leaderboard::Entry> entries(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		entries[i].mPoints = points(rng);
+		entries[i].mId = (uint32_t)i;
+		entries[i].mName = std::string(1, (char)('A' + rng() % 26)) + (char)('A' + rng() % 26);
+	}
+
+	Leaderboard board;
+	Clock::time_point start = Clock::now();
+	for (const Leaderboard::Entry& e : entries)
+		board.Insert(e.mPoints, e.mId, e.mName);
+	double insert = Since(start) / (double)count;
+
+	std::vector<Leaderboard::Entry> sorted = entries;
+	std::sort(sorted.begin(), sorted.end(), Ranks);
+
+	// The old way, a new score is pushed on the end then everything is sorted again
+	std::vector<Leaderboard::Entry> resorted = sorted;
+	start = Clock::now();
+	for (int i = 0; i < SORTED_INSERTS; i++)
+	{
+		resorted.push_back({ points(rng), (uint32_t)(count + i), "NEW" });
+		std::sort(resorted.begin(), resorted.end(), Ranks);
+	}
+	double sortInsert = Since(start) / SORTED_INSERTS;
+
+	bool ok = board.Size() == count;
+	for (size_t i = 0; ok && i < count; i++)
+		ok = board.At(i).mId == sorted[i].mId;
+
+	std::vector<int> queryPoints(QUERIES);
+	std::vector<size_t> queryRanks(QUERIES);
+	for (int i = 0; i < QUERIES; i++)
+	{
+		queryPoints[i] = points(rng);
+		queryRanks[i] = rng() % count;
+	}
+
+	start = Clock::now();
+	size_t rankSum = 0;
+	for (int p : queryPoints)
+		rankSum += board.GetRank(p);
+	double rank = Since(start) / QUERIES;
+
+	size_t expectedSum = 0;
+	for (int p : queryPoints)
+		expectedSum += std::lower_bound(sorted.begin(), sorted.end(), p, [](const Leaderboard::Entry& e, int v) { return e.mPoints >= v; }) - sorted.begin();
+	ok = ok && rankSum == expectedSum;
+
+	start = Clock::now();
+	uint64_t idSum = 0;
+	for (size_t r : queryRanks)
+		idSum += board.At(r).mId;
+	double at = Since(start) / QUERIES;
+
+	// A page of the score menu from a random place in the list
+	std::vector<const Leaderboard::Entry*> top;
+	start = Clock::now();
+	for (int i = 0; i < QUERIES / 100; i++)
+	{
+		board.GetTop(queryRanks[i], TOP_COUNT, top);
+		idSum += top.size();
+	}
+	double topK = Since(start) / (QUERIES / 100);
+	board.GetTop(0, TOP_COUNT, top);
+	for (size_t i = 0; ok && i < top.size(); i++)
+		ok = top[i]->mId == sorted[i].mId;
+	ok = ok && top.size() == std::min(count, TOP_COUNT);
+
+	const Leaderboard::Entry* pBest = board.GetBest(sorted.back().mName);
+	for (const Leaderboard::Entry& e : sorted)
+		if (ok && e.mName == sorted.back().mName)
+		{
+			ok = pBest && pBest->mId == e.mId;
+			break;
+		}
+
+	printf("%9zu | %10.3f %10.3f | %10.3f %10.3f %10.3f | %s\n", count, sortInsert * 1e6, insert * 1e6,
+		rank * 1e6, at * 1e6, topK * 1e6, ok ? "ok" : "FAILED");
+	return ok && idSum > 0;
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<size_t> counts;
+	for (int i = 1; i < argc; i++)
+		counts.push_back((size_t)atoll(argv[i]));
+	if (counts.empty())
+		counts = { 100, 10000, 1000000 };
+
+	printf("          |        insert (us)    |            query (us)            |\n");
+	printf("   scores |     resort  leaderbd  |       rank         at  top %3zu   |\n", TOP_COUNT);
+
+	bool ok = true;
+	for (size_t count : counts)
+		ok = count > 0 && Run(count) && ok;
+	return ok ? 0 : 1;
+}
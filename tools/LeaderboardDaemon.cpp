@@ -0,0 +1,82 @@
+// LeaderboardDaemon: The shared leaderboard for every cabinet at a venue.
+// Cabinets submit their scores to it over a Unix socket or loopback TCP (set
+// leaderboardServer in GameVariables.lua) and show its top list on their score menu,
+// each still keeps its own scores.dat for when the daemon isn't there. The board is
+// saved in the daemon's own score file, in the same format, and reloaded on start,
+// along with how far each cabinet's scores have got (in "<scoreFile>.cabinets").
+//
+// Usage: LeaderboardDaemon [address] [scoreFile]
+
+#include <cstdio>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+
+#include "LeaderboardServer.h"
+#include "GameConstants.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int REPORT_SECONDS = 10;  // How often the stats are printed while anything is happening.
+
+static std::atomic<bool> sStop{ false };
+
+
+static void OnSignal(int)
+{
+	sStop = true;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* address = argc > 1 ? argv[1] : GC::LEADERBOARD_ADDRESS;
+	const char* scoreFile = argc > 2 ? argv[2] : "leaderboard.dat";
+
+	if (!Net::Init())
+	{
+		printf("Can't start networking\n");
+		return 1;
+	}
+
+	LeaderboardServer server;
+	if (!server.Open(address, scoreFile, GC::ENCRYPT_KEY))
+	{
+		printf("Can't load %s or listen on %s\n", scoreFile, address);
+		return 1;
+	}
+
+	signal(SIGINT, OnSignal);
+	signal(SIGTERM, OnSignal);
+	printf("Listening on %s, %zu scores loaded from %s\n", address, server.GetLeaderboard().Size(), scoreFile);
+
+	Clock::time_point nextReport = Clock::now() + std::chrono::seconds(REPORT_SECONDS);
+	uint64_t reported = server.GetAccepted();
+	uint64_t refused = 0;
+	while (!sStop)
+	{
+		server.Poll(100);  // Short so a signal is noticed quickly
+
+		if (server.GetRefused() != refused)
+		{
+			refused = server.GetRefused();
+			printf("Refused a cabinet already connected under the same name (%llu so far), give each cabinet its own cabinetName\n",
+				(unsigned long long)refused);
+		}
+
+		if (Clock::now() >= nextReport)
+		{
+			if (server.GetAccepted() != reported)
+			{
+				printf("%zu cabinets connected, %zu scores on the board, %llu new (%llu resent and ignored)\n",
+					server.GetConnections(), server.GetLeaderboard().Size(),
+					(unsigned long long)(server.GetAccepted() - reported), (unsigned long long)server.GetDuplicates());
+				reported = server.GetAccepted();
+			}
+			nextReport += std::chrono::seconds(REPORT_SECONDS);
+		}
+	}
+
+	server.Close();  // Writes any scores still queued
+	printf("Stopped with %zu scores on the board\n", server.GetLeaderboard().Size());
+	return 0;
+}
@@ -0,0 +1,160 @@
+// LeaderboardLoadGen: Floods a leaderboard daemon with scores from many simulated cabinets and
+// reports how many submissions a second it takes and the latency from sending a batch to its
+// acknowledgement. Each cabinet keeps several batches in flight and asks for the top list
+// now and then, the way a busy venue would. Without an address it runs its own daemon on a
+// thread (against a scratch score file) and checks every acknowledged score reached the board.
+//
+// Usage: LeaderboardLoadGen [cabinets] [seconds] [batch] [address]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "LeaderboardClient.h"
+#include "LeaderboardServer.h"
+#include "GameConstants.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* LOCAL_ADDRESS = "tcp:127.0.0.1:7399";
+static const char* LOCAL_FILE = "LeaderboardLoadGen.dat";
+static const char* LOCAL_CABINETS = "LeaderboardLoadGen.dat.cabinets";
+static const size_t PIPELINE_DEPTH = 8;   // Batches a cabinet has in flight before it waits.
+static const int TOP_EVERY = 50;          // Batches between top list refreshes.
+
+
+// CabinetResult struct: What one simulated cabinet saw.
+struct CabinetResult
+{
+    uint64_t mAcked = 0;
+    unsigned int mTopLists = 0;
+    unsigned int mTopSame = 0;
+    bool mConnected = false;
+    bool mFlushed = false;
+    std::vector<double> mLatencies;
+};
+
+// RunCabinet function: Submits batches until the time is up, then waits for the last acknowledgements.
+// Every run is a new score file as far as the daemon's concerned, the ids start from 0 each time.
+static void RunCabinet(const std::string& address, int index, uint32_t nonce, double seconds, size_t batch, CabinetResult& result)
+{
+	LeaderboardClient client;
+	client.Open(address, "loadgen-" + std::to_string(index), nonce);
+	while (client.IsConnecting())
+		client.Wait(10);
+	result.mConnected = client.IsConnected();
+	if (!result.mConnected)
+		return;
+	client.SetRecordLatency(true);
+
+	Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+	uint32_t id = 0;
+	unsigned int lcg = 777u + (unsigned int)index;
+	for (int b = 0; Clock::now() < end && client.IsConnected(); b++)
+	{
+		for (size_t i = 0; i < batch; i++)
+		{
+			lcg = lcg * 1664525u + 1013904223u;
+			client.Submit(id++, (int)(lcg >> 16), "LOADGEN");
+		}
+		if (b % TOP_EVERY == 0)
+			client.RequestTop(100);
+
+		client.Pump();
+		while (client.GetUnacknowledged() > batch * PIPELINE_DEPTH && client.IsConnected())
+			client.Wait(10);
+	}
+
+	result.mFlushed = client.Flush(5000);
+	result.mAcked = client.GetAcknowledged();
+	result.mTopLists = client.GetTopLists();
+	result.mTopSame = client.GetTopSame();
+	result.mLatencies = client.GetLatencies();
+}
+
+int main(int argc, char* argv[])
+{
+	int cabinets = argc > 1 ? atoi(argv[1]) : 8;
+	double seconds = argc > 2 ? atof(argv[2]) : 3.0;
+	size_t batch = argc > 3 ? (size_t)atoi(argv[3]) : 16;
+	bool local = argc <= 4;
+	std::string address = local ? LOCAL_ADDRESS : argv[4];
+
+	if (!Net::Init() || cabinets <= 0 || batch == 0)
+		return 1;
+
+	// Without an address, run the daemon here on its own thread
+	LeaderboardServer server;
+	std::atomic<bool> stopServer{ false };
+	std::thread serverThread;
+	if (local)
+	{
+		remove(LOCAL_FILE);
+		remove(LOCAL_CABINETS);
+		if (!server.Open(address, LOCAL_FILE, GC::ENCRYPT_KEY))
+		{
+			printf("Can't listen on %s\n", address.c_str());
+			return 1;
+		}
+		serverThread = std::thread([&] {
+			while (!stopServer)
+				server.Poll(10);
+			});
+	}
+
+	printf("%d cabinets submitting batches of %zu to %s for %.1f seconds\n", cabinets, batch, address.c_str(), seconds);
+
+	uint32_t nonce = std::random_device()() | 1;
+	std::vector<CabinetResult> results(cabinets);
+	std::vector<std::thread> threads;
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < cabinets; i++)
+		threads.emplace_back(RunCabinet, address, i, nonce, seconds, batch, std::ref(results[i]));
+	for (std::thread& t : threads)
+		t.join();
+	double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+	uint64_t acked = 0;
+	unsigned int topLists = 0, topSame = 0;
+	bool ok = true;
+	std::vector<double> latencies;
+	for (const CabinetResult& r : results)
+	{
+		acked += r.mAcked;
+		topLists += r.mTopLists;
+		topSame += r.mTopSame;
+		ok = ok && r.mConnected && r.mFlushed;
+		latencies.insert(latencies.end(), r.mLatencies.begin(), r.mLatencies.end());
+	}
+
+	if (local)
+	{
+		stopServer = true;
+		serverThread.join();
+		ok = ok && server.GetAccepted() == acked;
+		server.Close();
+		remove(LOCAL_FILE);
+		remove(LOCAL_CABINETS);
+	}
+
+	if (latencies.empty())
+	{
+		printf("No batches were acknowledged, is the daemon running?\n");
+		return 1;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p) { return latencies[std::min(latencies.size() - 1, (size_t)(p * latencies.size()))] * 1e3; };
+	printf("%llu scores acknowledged, %.0f submissions per second\n", (unsigned long long)acked, (double)acked / elapsed);
+	printf("Batch latency ms: p50 %.3f  p99 %.3f  max %.3f\n", percentile(0.50), percentile(0.99), latencies.back() * 1e3);
+	printf("Top list refreshes: %u sent a list, %u unchanged\n", topLists, topSame);
+	printf("%s\n", ok ? "ok" : "FAILED: a cabinet couldn't connect or flush, or the board lost scores");
+	return ok ? 0 : 1;
+}
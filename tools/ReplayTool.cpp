@@ -0,0 +1,103 @@
+// ReplayTool: Records scripted games to replay files and plays replays back headless.
+// Playing checks the game ends with the ticks and score that were recorded, so a replay
+// works as both a bug repro and a fixed workload for spotting performance regressions.
+//
+// Usage: ReplayTool record <file> [seed] [maxTicks]
+//        ReplayTool play <file> [repeats]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+#include "Simulation.h"
+#include "Replay.h"
+
+typedef std::chrono::steady_clock Clock;
+
+
+// Record function: Plays a game with a simple sweeping player and writes it to a replay.
+static int Record(const char* path, unsigned int seed, unsigned int maxTicks)
+{
+	SimConfig config;
+	Simulation sim(config, seed);
+	ReplayWriter writer;
+	if (!writer.Open(path, seed, config))
+	{
+		printf("Can't create %s\n", path);
+		return 1;
+	}
+
+	// Vary the frame time a little like a real game loop would
+	SimInput input;
+	while (!sim.IsGameOver() && sim.GetTicks() < maxTicks)
+	{
+		unsigned int t = sim.GetTicks();
+		input.mFire = (t / 30) % 4 != 0;
+		input.mMoveX = ((t / 150) % 2) ? 1.0f : -0.75f;
+		float dTime = (t % 7 == 0) ? 1.0f / 50.0f : 1.0f / 60.0f;
+
+		writer.Record(input, dTime);
+		sim.Step(input, dTime);
+	}
+	writer.Close(sim.GetTicks(), sim.GetScore());
+
+	printf("Recorded %u ticks, score %d, seed %u to %s\n", sim.GetTicks(), sim.GetScore(), seed, path);
+	return 0;
+}
+
+// Play function: Replays the file the given amount of times, checks the result and reports the speed.
+static int Play(const char* path, int repeats)
+{
+	double seconds = 0.0;
+	unsigned long long ticks = 0;
+
+	for (int r = 0; r < repeats; r++)
+	{
+		ReplayReader reader;
+		if (!reader.Open(path))
+		{
+			printf("%s is missing or not a valid replay\n", path);
+			return 1;
+		}
+		if (r == 0 && reader.GetConfigHash() != Replay::HashConfig(SimConfig()))
+			printf("Note: recorded with a different config, playing it back with the recorded one\n");
+
+		Simulation sim(reader.GetConfig(), reader.GetSeed());
+		SimInput input;
+		float dTime = 0.0f;
+
+		Clock::time_point start = Clock::now();
+		while (reader.Next(input, dTime))
+			sim.Step(input, dTime);
+		seconds += std::chrono::duration<double>(Clock::now() - start).count();
+		ticks += sim.GetTicks();
+
+		if (!reader.IsComplete())
+		{
+			printf("%s was never closed, replayed the %u ticks it has (score %d)\n", path, sim.GetTicks(), sim.GetScore());
+			return 1;
+		}
+		if (sim.GetTicks() != reader.GetFinalTicks() || sim.GetScore() != reader.GetFinalScore())
+		{
+			printf("Desync: recorded %u ticks score %d, replayed %u ticks score %d\n",
+				reader.GetFinalTicks(), reader.GetFinalScore(), sim.GetTicks(), sim.GetScore());
+			return 1;
+		}
+	}
+
+	printf("Replayed %s %d times, matched, %.0f ticks per second\n", path, repeats, (double)ticks / seconds);
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 3 && strcmp(argv[1], "record") == 0)
+		return Record(argv[2], argc > 3 ? (unsigned int)atoi(argv[3]) : 42, argc > 4 ? (unsigned int)atoi(argv[4]) : 100000);
+	if (argc >= 3 && strcmp(argv[1], "play") == 0)
+		return Play(argv[2], argc > 3 ? atoi(argv[3]) : 1);
+
+	printf("Usage: ReplayTool record <file> [seed] [maxTicks]\n");
+	printf("       ReplayTool play <file> [repeats]\n");
+	return 1;
+}
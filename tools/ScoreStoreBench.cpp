@@ -0,0 +1,150 @@
+// ScoreStoreBench: Times the score file against the text format it replaced as the history grows.
+// For each size the old format is saved and loaded the way ScoreSystem used to (stringstream,
+// XOR, whole file every time), then converted to the record format, which is loaded, appended
+// to (synced on the calling thread, then queued to a ScoreWriter, which is all the game's
+// main thread pays), damaged with a torn write and compacted, checking the scores survive
+// every step.
+//
+// Usage: ScoreStoreBench [records...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+
+#include "ScoreStore.h"
+#include "ScoreWriter.h"
+#include "GameConstants.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const char* BENCH_FILE = "ScoreStoreBench.dat";
+static const std::string BENCH_KEY = GC::ENCRYPT_KEY;
+static const int APPENDS = 100;
+
+
+static double Since(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// SaveLegacy function: What ScoreSystem::SaveScores did, serialize everything, XOR it and rewrite the file.
+static void SaveLegacy(const std::vector<ScoreRecord>& records)
+{
+	std::stringstream ss;
+	for (size_t i = 0; i < records.size(); i++)
+		ss << i << ',' << records[i].mPoints << ',' << records[i].GetName() << ';';
+
+	std::string data = ss.str();
+	ScoreFile::Crypt(&data[0], data.size(), BENCH_KEY);
+	std::ofstream file(BENCH_FILE, std::ios::out | std::ios::binary);
+	file << data;
+}
+
+// LoadLegacy function: What ScoreSystem::LoadScores did, read it all, XOR it and parse with nested stringstreams.
+static size_t LoadLegacy()
+{
+	std::ifstream file(BENCH_FILE, std::ios::in | std::ios::binary);
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	ScoreFile::Crypt(&data[0], data.size(), BENCH_KEY);
+
+	std::stringstream ss(data);
+	std::string segment, part;
+	size_t count = 0;
+	while (std::getline(ss, segment, ';'))
+	{
+		std::stringstream segmentStream(segment);
+		std::getline(segmentStream, part, ',');
+		std::stoi(part);
+		std::getline(segmentStream, part, ',');
+		std::stoi(part);
+		std::getline(segmentStream, part, ',');
+		count++;
+	}
+	return count;
+}
+
+// Run function: Benchmarks one history size, false if the store lost or mangled a score.
+static bool Run(size_t count)
+{
+	std::vector<ScoreRecord> records(count);
+	unsigned int lcg = 12345;
+	for (size_t i = 0; i < count; i++)
+	{
+		lcg = lcg * 1664525u + 1013904223u;
+		records[i].mPoints = (int)(lcg >> 12) % 100000 + 10;
+		records[i].SetName(std::string(1 + (lcg >> 8) % 8, (char)('A' + (lcg >> 20) % 26)));
+	}
+
+	Clock::time_point start = Clock::now();
+	SaveLegacy(records);
+	double legacySave = Since(start);
+
+	start = Clock::now();
+	size_t legacyCount = LoadLegacy();
+	double legacyLoad = Since(start);
+
+	ScoreStore store;
+	start = Clock::now();
+	bool ok = store.Open(BENCH_FILE, BENCH_KEY) && store.GetRecords().size() == count;
+	double convert = Since(start);
+	for (size_t i = 0; ok && i < count; i++)
+		ok = store.GetRecords()[i].mPoints == records[i].mPoints && store.GetRecords()[i].GetName() == records[i].GetName();
+
+	start = Clock::now();
+	ok = ok && store.Open(BENCH_FILE, BENCH_KEY) && store.GetRecords().size() == count;
+	double load = Since(start);
+
+	start = Clock::now();
+	for (int i = 0; ok && i < APPENDS; i++)
+		ok = store.Append(1000 + i, "APPEND");
+	double append = Since(start) / APPENDS;
+
+	ScoreWriter writer;
+	writer.Start(store);
+	start = Clock::now();
+	for (int i = 0; i < APPENDS; i++)
+		writer.Queue(2000 + i, "QUEUED");
+	double queue = Since(start) / APPENDS;
+	writer.Stop();
+	ok = ok && writer.GetFailures() == 0 && store.GetRecords().size() == count + APPENDS * 2;
+
+	// A crash halfway through writing a record, the next open drops it and repairs the file
+	if (FILE* pFile = fopen(BENCH_FILE, "ab"))
+	{
+		fwrite("torn", 1, 4, pFile);
+		fclose(pFile);
+	}
+	ok = ok && store.Open(BENCH_FILE, BENCH_KEY) && store.GetRecords().size() == count + APPENDS * 2 &&
+		store.GetRecords().back().mPoints == 2000 + APPENDS - 1;
+
+	start = Clock::now();
+	ok = ok && store.Compact(100) && store.Open(BENCH_FILE, BENCH_KEY) && store.GetRecords().size() == std::min<size_t>(count + APPENDS * 2, 100);
+	double compact = Since(start);
+
+	printf("%9zu | %9.3f %9.3f | %9.3f %9.3f %9.2f %9.2f %9.3f | %s\n", count, legacySave * 1e3, legacyLoad * 1e3,
+		convert * 1e3, load * 1e3, append * 1e6, queue * 1e6, compact * 1e3, ok && legacyCount == count ? "ok" : "FAILED");
+
+	remove(BENCH_FILE);
+	return ok && legacyCount == count;
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<size_t> counts;
+	for (int i = 1; i < argc; i++)
+		counts.push_back((size_t)atoll(argv[i]));
+	if (counts.empty())
+		counts = { 100, 10000, 1000000 };
+
+	printf("          |     old format (ms) |                record format                      |\n");
+	printf("  records |      save      load |   convert      load append us  queue us  compact |\n");
+
+	bool ok = true;
+	for (size_t count : counts)
+		ok = Run(count) && ok;
+	return ok ? 0 : 1;
+}
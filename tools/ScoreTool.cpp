@@ -0,0 +1,365 @@
+// ScoreTool: Reads and writes score files outside the game, on any platform, replacing the
+// Windows only Utility/Score Decryptor. Files in either format (the old XORed text or the
+// record format) are read, decoded to text in the same "id:0, score:10, name:NULL" lines the
+// decryptor wrote, encoded back from that text, or converted between formats. bulk converts
+// every file in a directory on a thread pool, for score dumps collected from many cabinets,
+// and bench times the XOR every load and save goes through on multi-megabyte files.
+// Every command returns 0 on success so it can be scripted.
+//
+// Usage: ScoreTool decode <scoreFile> [textFile]
+//        ScoreTool encode <textFile> <scoreFile> [records|legacy]
+//        ScoreTool convert <scoreFile> <outFile> [records|legacy|text]
+//        ScoreTool bulk <inDir> <outDir> [records|legacy|text] [threads]
+//        ScoreTool bench [megabytes...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <random>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+
+#include "ScoreStore.h"
+#include "TaskPool.h"
+#include "GameConstants.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const std::string KEY = GC::ENCRYPT_KEY;
+static const char* BENCH_FILE = "ScoreTool.bench";
+
+// OutputFormat enum: What a command writes, a score file in either format or the decoded text.
+enum OutputFormat
+{
+	OUT_RECORDS,
+	OUT_LEGACY,
+	OUT_TEXT,
+	OUT_INVALID
+};
+
+
+static double Since(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static OutputFormat ParseFormat(const char* name)
+{
+	if (strcmp(name, "records") == 0)
+		return OUT_RECORDS;
+	if (strcmp(name, "legacy") == 0)
+		return OUT_LEGACY;
+	if (strcmp(name, "text") == 0)
+		return OUT_TEXT;
+	return OUT_INVALID;
+}
+
+// ToText function: One line per score, in the order they were saved.
+static std::string ToText(const std::vector<ScoreRecord>& records)
+{
+	std::string text;
+	text.reserve(records.size() * 40);
+	char line[96];
+	for (const ScoreRecord& r : records)
+	{
+		snprintf(line, sizeof(line), "id:%u, score:%d, name:", r.mId, r.mPoints);
+		text += line;
+		text.append(r.mName, r.mNameLength);
+		text += '\n';
+	}
+	return text;
+}
+
+// FromText function: Reads ToText's lines back, false naming the line if one isn't in that form.
+static bool FromText(const std::string& text, std::vector<ScoreRecord>& out)
+{
+	size_t pos = 0;
+	for (int lineNumber = 1; pos < text.size(); lineNumber++)
+	{
+		size_t end = text.find('\n', pos);
+		if (end == std::string::npos)
+			end = text.size();
+		std::string line = text.substr(pos, end - pos);
+		pos = end + 1;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+
+		unsigned int id;
+		int points, nameStart = -1;
+		if (sscanf(line.c_str(), "id:%u, score:%d, name:%n", &id, &points, &nameStart) != 2 || nameStart < 0)
+		{
+			printf("Line %d isn't \"id:<id>, score:<points>, name:<name>\"\n", lineNumber);
+			return false;
+		}
+
+		ScoreRecord record;
+		record.mId = id;
+		record.mPoints = points;
+		record.SetName(line.substr((size_t)nameStart));
+		out.push_back(record);
+	}
+	return true;
+}
+
+static bool ReadText(const std::string& path, std::string& text)
+{
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (!file)
+		return false;
+	text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+static bool WriteText(const std::string& path, const std::string& text)
+{
+	std::ofstream file(path, std::ios::out | std::ios::binary);
+	file.write(text.data(), (std::streamsize)text.size());
+	return (bool)file;
+}
+
+static bool WriteOutput(const std::string& path, const std::vector<ScoreRecord>& records, OutputFormat format)
+{
+	if (format == OUT_TEXT)
+		return WriteText(path, ToText(records));
+	return ScoreFile::Save(path, records, KEY, format == OUT_LEGACY ? ScoreFile::FORMAT_LEGACY : ScoreFile::FORMAT_RECORDS);
+}
+
+// Decode function: Prints the scores, or writes them to textFile.
+static int Decode(const char* scoreFile, const char* textFile)
+{
+	std::vector<ScoreRecord> records;
+	if (!ScoreFile::Load(scoreFile, KEY, records))
+	{
+		printf("Can't read %s as a score file\n", scoreFile);
+		return 1;
+	}
+
+	std::string text = ToText(records);
+	if (!textFile)
+	{
+		fwrite(text.data(), 1, text.size(), stdout);
+		return 0;
+	}
+	if (!WriteText(textFile, text))
+	{
+		printf("Can't write %s\n", textFile);
+		return 1;
+	}
+	return 0;
+}
+
+// Encode function: Turns decoded (and perhaps edited) text back into a score file, Save works out the checks.
+static int Encode(const char* textFile, const char* scoreFile, OutputFormat format)
+{
+	std::string text;
+	std::vector<ScoreRecord> records;
+	if (!ReadText(textFile, text))
+	{
+		printf("Can't read %s\n", textFile);
+		return 1;
+	}
+	if (!FromText(text, records))
+		return 1;
+
+	if (!WriteOutput(scoreFile, records, format))
+	{
+		printf("Can't write %s\n", scoreFile);
+		return 1;
+	}
+	return 0;
+}
+
+// Convert function: One score file to another format, or to text.
+static int Convert(const char* inFile, const char* outFile, OutputFormat format)
+{
+	std::vector<ScoreRecord> records;
+	if (!ScoreFile::Load(inFile, KEY, records))
+	{
+		printf("Can't read %s as a score file\n", inFile);
+		return 1;
+	}
+	if (!WriteOutput(outFile, records, format))
+	{
+		printf("Can't write %s\n", outFile);
+		return 1;
+	}
+	return 0;
+}
+
+// Bulk function: A task per file, a file that isn't a score file is reported and skipped.
+// Text output gets ".txt" on the end of the name, score files keep their names.
+static int Bulk(const char* inDir, const char* outDir, OutputFormat format, size_t threads)
+{
+	namespace fs = std::filesystem;
+	std::error_code ec;
+	std::vector<fs::path> files;
+	for (const fs::directory_entry& entry : fs::directory_iterator(inDir, ec))
+		if (entry.is_regular_file())
+			files.push_back(entry.path());
+	if (ec)
+	{
+		printf("Can't list %s\n", inDir);
+		return 1;
+	}
+	fs::create_directories(outDir, ec);
+
+	std::atomic<uint64_t> records{ 0 }, bytes{ 0 };
+	std::mutex failedMutex;
+	std::vector<std::string> failed;
+
+	Clock::time_point start = Clock::now();
+	{
+		TaskPool pool(threads);
+		for (const fs::path& file : files)
+		{
+			pool.Push([&, file] {
+				std::vector<ScoreRecord> scores;
+				fs::path out = fs::path(outDir) / file.filename();
+				if (format == OUT_TEXT)
+					out += ".txt";
+
+				std::error_code sizeEc;
+				uintmax_t size = fs::file_size(file, sizeEc);
+				if (ScoreFile::Load(file.string(), KEY, scores) && WriteOutput(out.string(), scores, format))
+				{
+					records += scores.size();
+					bytes += sizeEc ? 0 : size;
+					return;
+				}
+				std::lock_guard<std::mutex> lock(failedMutex);
+				failed.push_back(file.string());
+				});
+		}
+		pool.Wait();
+		threads = pool.GetThreadCount();
+	}
+	double seconds = Since(start);
+
+	for (const std::string& file : failed)
+		printf("Skipped %s, it isn't a score file or its output couldn't be written\n", file.c_str());
+	printf("%zu of %zu files converted on %zu threads, %llu scores, %.1f MB in %.3f s (%.1f MB/s)\n",
+		files.size() - failed.size(), files.size(), threads, (unsigned long long)records.load(),
+		(double)bytes / 1e6, seconds, (double)bytes / 1e6 / seconds);
+	return failed.empty() ? 0 : 1;
+}
+
+// Throughput function: Runs work over bytes of data repeatedly for at least a quarter of a second, returns GB/s.
+template<typename Work>
+static double Throughput(size_t bytes, Work work)
+{
+	int runs = 0;
+	Clock::time_point start = Clock::now();
+	do
+	{
+		work();
+		runs++;
+	} while (Since(start) < 0.25);
+	return (double)bytes * runs / Since(start) / 1e9;
+}
+
+// Bench function: For each size, the XOR on its own (scalar against SIMD, as a stream for the
+// text format and per record for the record format), then a whole file saved and loaded in each format.
+static int Bench(const std::vector<size_t>& megabytes)
+{
+	std::mt19937 rng(1234);
+	bool ok = true;
+
+	printf("%8s %12s %12s %12s %12s %12s %12s\n", "MB", "xor GB/s", "simd GB/s", "rec GB/s", "simd GB/s", "load rec", "load legacy");
+	for (size_t mb : megabytes)
+	{
+		size_t size = mb << 20;
+		std::vector<ScoreRecord> records(size / sizeof(ScoreRecord));
+		for (size_t i = 0; i < records.size(); i++)
+		{
+			records[i].mPoints = (int)(rng() % 100000);
+			records[i].mId = (uint32_t)i;
+			records[i].SetName("P" + std::to_string(rng() % 1000000));
+		}
+
+		// The SIMD paths have to give the same bytes, started part way into the key so they have to wrap
+		std::string scalar(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ScoreRecord));
+		std::string simd = scalar;
+		ScoreFile::CryptScalar(&scalar[0], scalar.size(), KEY, 7);
+		ScoreFile::Crypt(&simd[0], simd.size(), KEY, 7);
+		std::vector<ScoreRecord> recScalar = records, recSimd = records;
+		for (ScoreRecord& r : recScalar)
+			ScoreFile::CryptScalar(&r, sizeof(r), KEY);
+		ScoreFile::CryptRecords(recSimd.data(), recSimd.size(), KEY);
+		ok = ok && scalar == simd && memcmp(recScalar.data(), recSimd.data(), size) == 0;
+
+		// The stream XOR the text format uses
+		double xorScalar = Throughput(size, [&] { ScoreFile::CryptScalar(&scalar[0], scalar.size(), KEY, 7); });
+		double xorSimd = Throughput(size, [&] { ScoreFile::Crypt(&simd[0], simd.size(), KEY, 7); });
+
+		// Per record, what loading used to do against CryptRecords
+		double recordScalar = Throughput(size, [&] {
+			for (ScoreRecord& r : recScalar)
+				ScoreFile::CryptScalar(&r, sizeof(r), KEY);
+			});
+		double recordSimd = Throughput(size, [&] { ScoreFile::CryptRecords(recSimd.data(), recSimd.size(), KEY); });
+
+		// Whole files, read back through Load the way every command reads them
+		double load[2];
+		ScoreFile::Format formats[2] = { ScoreFile::FORMAT_RECORDS, ScoreFile::FORMAT_LEGACY };
+		for (int f = 0; f < 2; f++)
+		{
+			std::vector<ScoreRecord> loaded;
+			ScoreFile::Format format = ScoreFile::FORMAT_UNKNOWN;
+			ok = ok && ScoreFile::Save(BENCH_FILE, records, KEY, formats[f]);
+			uintmax_t fileSize = std::filesystem::file_size(BENCH_FILE);
+
+			Clock::time_point start = Clock::now();
+			ok = ok && ScoreFile::Load(BENCH_FILE, KEY, loaded, &format);
+			load[f] = (double)fileSize / Since(start) / 1e6;
+			ok = ok && format == formats[f] && loaded.size() == records.size();
+		}
+		remove(BENCH_FILE);
+
+		printf("%8zu %12.2f %12.2f %12.2f %12.2f %9.0f MB/s %6.0f MB/s\n", mb, xorScalar, xorSimd, recordScalar, recordSimd, load[0], load[1]);
+	}
+
+	printf("%s\n", ok ? "ok" : "FAILED: the SIMD XOR didn't match or a file didn't load back");
+	return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* command = argc > 1 ? argv[1] : "";
+	OutputFormat format = argc > 4 ? ParseFormat(argv[4]) : OUT_RECORDS;
+
+	if (strcmp(command, "decode") == 0 && argc >= 3)
+		return Decode(argv[2], argc > 3 ? argv[3] : nullptr);
+
+	if (strcmp(command, "encode") == 0 && argc >= 4 && (format == OUT_RECORDS || format == OUT_LEGACY))
+		return Encode(argv[2], argv[3], format);
+
+	if (strcmp(command, "convert") == 0 && argc >= 4 && format != OUT_INVALID)
+		return Convert(argv[2], argv[3], format);
+
+	if (strcmp(command, "bulk") == 0 && argc >= 4 && format != OUT_INVALID)
+		return Bulk(argv[2], argv[3], format, argc > 5 ? (size_t)atoi(argv[5]) : 0);
+
+	if (strcmp(command, "bench") == 0)
+	{
+		std::vector<size_t> megabytes;
+		for (int i = 2; i < argc; i++)
+			megabytes.push_back((size_t)atoi(argv[i]));
+		if (megabytes.empty())
+			megabytes = { 4, 32, 128 };
+		return Bench(megabytes);
+	}
+
+	printf("Usage: ScoreTool decode <scoreFile> [textFile]\n");
+	printf("       ScoreTool encode <textFile> <scoreFile> [records|legacy]\n");
+	printf("       ScoreTool convert <scoreFile> <outFile> [records|legacy|text]\n");
+	printf("       ScoreTool bulk <inDir> <outDir> [records|legacy|text] [threads]\n");
+	printf("       ScoreTool bench [megabytes...]\n");
+	return 1;
+}
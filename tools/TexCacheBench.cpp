@@ -0,0 +1,102 @@
+// TexCacheBench: Times finding a texture's data by its handle as the texture cache grows, the
+// lookup Sprite::SetTex does for every sprite. TexCache needs Direct3D, so this builds the same
+// containers it uses with stand in handles: the name map TexCache::Get used to scan end to end
+// comparing handles, against the handle index it looks them up in now.
+//
+// Usage: TexCacheBench [textures...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+typedef std::chrono::steady_clock Clock;
+
+static const size_t LOOKUPS = 200000;
+
+
+// FakeView struct: Stands in for an ID3D11ShaderResourceView, only its address is used.
+struct FakeView
+{
+	int mUnused = 0;
+};
+
+// Data struct: The same shape as TexCache::Data, so the map's nodes are the same size.
+struct Data
+{
+	std::string fileName;
+	FakeView* pTex = nullptr;
+	float dim[2] = {};
+	std::vector<float> frames;
+};
+
+typedef std::unordered_map<std::string, Data> NameMap;
+typedef std::unordered_map<const FakeView*, Data*> HandleMap;
+
+
+// ScanGet function: What TexCache::Get(pTex) did, walk the name map until the handle matches.
+static const Data* ScanGet(const NameMap& cache, const FakeView* pTex)
+{
+	for (const NameMap::value_type& pair : cache)
+		if (pair.second.pTex == pTex)
+			return &pair.second;
+	return nullptr;
+}
+
+// Time function: Returns the average nanoseconds per lookup, adding each lookup's result to check.
+template<typename Lookup>
+static double Time(const std::vector<FakeView*>& queries, size_t& check, Lookup lookup)
+{
+	Clock::time_point start = Clock::now();
+	for (const FakeView* q : queries)
+		check += (size_t)lookup(q)->dim[0];
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (double)queries.size();
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<size_t> sizes;
+	for (int i = 1; i < argc; i++)
+		sizes.push_back((size_t)atoi(argv[i]));
+	if (sizes.empty())
+		sizes = { 16, 128, 1024, 4096, 16384 };
+
+	std::mt19937 rng(1234);
+	bool ok = true;
+
+	printf("%10s %14s %14s %10s\n", "textures", "scan ns", "index ns", "speedup");
+	for (size_t count : sizes)
+	{
+		std::vector<FakeView> views(count);
+		NameMap cache;
+		HandleMap byHandle;
+		for (size_t i = 0; i < count; i++)
+		{
+			Data data;
+			data.fileName = "sprites/texture" + std::to_string(i) + ".dds";
+			data.pTex = &views[i];
+			data.dim[0] = (float)(i % 512 + 1);
+			NameMap::iterator it = cache.insert(NameMap::value_type("texture" + std::to_string(i), data)).first;
+			byHandle[&views[i]] = &(*it).second;
+		}
+
+		// Fewer scans on the big caches, each one walks every texture
+		std::vector<FakeView*> queries(std::max<size_t>(1000, LOOKUPS / count * 16));
+		for (FakeView*& q : queries)
+			q = &views[rng() % count];
+
+		size_t scanCheck = 0, indexCheck = 0;
+		double scan = Time(queries, scanCheck, [&cache](const FakeView* q) { return ScanGet(cache, q); });
+		double index = Time(queries, indexCheck, [&byHandle](const FakeView* q) { return byHandle.find(q)->second; });
+		ok = ok && scanCheck == indexCheck;
+
+		printf("%10zu %14.1f %14.1f %9.0fx\n", count, scan, index, scan / index);
+	}
+
+	printf("%s\n", ok ? "ok" : "FAILED: the index found different textures to the scan");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+// TextureLoadBench: Times reading and parsing every DDS texture under a folder one after another,
+// the way the game used to load them as each mode asked, against asking a TextureLoader for them
+// all at once and waiting for the lot, for each number of loader threads. Files it can't parse are
+// listed (the game loads those with DirectXTK instead), and the parser is checked against DDS
+// layouts the game's own files don't use: block compressed with mips, the DX10 header, and files
+// that are cut short or hold cube maps.
+//
+// Usage: TextureLoadBench [folder] [repeats] [threads...]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+
+#include "DdsImage.h"
+#include "TextureLoader.h"
+
+typedef std::chrono::steady_clock Clock;
+
+
+static double Since(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void PutU32(std::vector<uint8_t>& file, size_t offset, uint32_t value)
+{
+	memcpy(file.data() + offset, &value, sizeof(value));
+}
+
+// MakeDds function: A file of the given size and pixel bytes with the header filled in by hand.
+// A non-zero dxgiFormat adds a DX10 header, otherwise fourCC names the format.
+static std::vector<uint8_t> MakeDds(uint32_t width, uint32_t height, uint32_t mips, const char* fourCC, uint32_t dxgiFormat,
+	size_t pixelBytes, uint32_t caps2 = 0)
+{
+	size_t header = 128 + (dxgiFormat ? 20 : 0);
+	std::vector<uint8_t> file(header + pixelBytes, 0xab);
+	memset(file.data(), 0, header);
+	PutU32(file, 0, 0x20534444);
+	PutU32(file, 4, 124);
+	PutU32(file, 8, 0x1007 | (mips > 1 ? 0x20000 : 0));
+	PutU32(file, 12, height);
+	PutU32(file, 16, width);
+	PutU32(file, 28, mips);
+	PutU32(file, 76, 32);
+	PutU32(file, 80, 0x4);  // DDPF_FOURCC
+	memcpy(file.data() + 84, dxgiFormat ? "DX10" : fourCC, 4);
+	PutU32(file, 108, 0x1000);
+	PutU32(file, 112, caps2);
+	if (dxgiFormat)
+	{
+		PutU32(file, 128, dxgiFormat);
+		PutU32(file, 132, 3);  // Texture2D
+		PutU32(file, 140, 1);  // Array size
+	}
+	return file;
+}
+
+// CheckParser function: Layouts the game's files don't cover, each has to parse (or fail) as expected.
+static bool CheckParser()
+{
+	struct Case
+	{
+		const char* mName;
+		std::vector<uint8_t> mFile;
+		bool mOk;
+		uint32_t mFormat;
+		size_t mLevels;
+		size_t mLastSize;  // Bytes in the smallest level.
+	};
+
+	// 256x256 DXT1 with every mip: 8 bytes a 4x4 block, the last three levels are a block each
+	size_t dxt1Bytes = 0;
+	for (uint32_t s = 256; s > 0; s /= 2)
+		dxt1Bytes += (size_t)std::max(1u, s / 4) * std::max(1u, s / 4) * 8;
+
+	Case cases[] = {
+		{ "DXT1 with mips", MakeDds(256, 256, 9, "DXT1", 0, dxt1Bytes), true, Dds::FORMAT_BC1_UNORM, 9, 8 },
+		{ "DX10 BC7, 3 mips", MakeDds(64, 32, 3, nullptr, Dds::FORMAT_BC7_UNORM, 16 * 8 * 16 + 8 * 4 * 16 + 4 * 2 * 16), true, Dds::FORMAT_BC7_UNORM, 3, 128 },
+		{ "DX10 RGBA, 5x3", MakeDds(5, 3, 1, nullptr, Dds::FORMAT_R8G8B8A8_UNORM, 5 * 3 * 4), true, Dds::FORMAT_R8G8B8A8_UNORM, 1, 60 },
+		{ "cut short", MakeDds(256, 256, 9, "DXT1", 0, dxt1Bytes - 1), false, 0, 0, 0 },
+		{ "cube map", MakeDds(64, 64, 1, "DXT5", 0, 6 * 16 * 16 * 16, 0xfe00), false, 0, 0, 0 },
+		{ "too many mips", MakeDds(4, 4, 4, "DXT5", 0, 64), false, 0, 0, 0 },
+		{ "unknown FourCC", MakeDds(4, 4, 1, "ABCD", 0, 64), false, 0, 0, 0 },
+	};
+
+	bool ok = true;
+	for (Case& c : cases)
+	{
+		DdsImage image;
+		std::string error;
+		bool parsed = Dds::Parse(c.mFile, image, error);
+		bool pass = parsed == c.mOk && (!parsed || (image.mFormat == c.mFormat && image.mLevels.size() == c.mLevels &&
+			image.mLevels.back().mSize == c.mLastSize && image.mLevels.back().mOffset + c.mLastSize == c.mFile.size()));
+		if (!pass)
+			printf("Parser check failed: %s (%s)\n", c.mName, parsed ? "parsed" : error.c_str());
+		ok = ok && pass;
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[])
+{
+	std::string folder = argc > 1 ? argv[1] : "data";
+	int repeats = argc > 2 ? atoi(argv[2]) : 20;
+	std::vector<size_t> threadCounts;
+	for (int i = 3; i < argc; i++)
+		threadCounts.push_back((size_t)atoi(argv[i]));
+	if (threadCounts.empty())
+		threadCounts = { 1, 2, 4, 8 };
+
+	bool ok = CheckParser();
+
+	std::vector<std::string> files;
+	std::error_code ec;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(folder, ec))
+		if (entry.is_regular_file() && entry.path().extension() == ".dds")
+			files.push_back(entry.path().string());
+	if (files.empty())
+	{
+		printf("No .dds files under %s\n", folder.c_str());
+		return 1;
+	}
+
+	// Every file once, to list them and warm the OS's file cache so the timings compare the loading and not the disk
+	size_t bytes = 0, parsed = 0;
+	for (const std::string& file : files)
+	{
+		DdsImage image;
+		std::string error;
+		if (Dds::Load(file, image, error))
+		{
+			printf("  %-40s %5ux%-5u format %2u, %2zu mips, %8zu bytes\n", file.c_str(), image.mWidth, image.mHeight, image.mFormat,
+				image.mLevels.size(), image.GetPixelBytes());
+			bytes += image.GetSize();
+			parsed++;
+		}
+		else
+			printf("  %-40s can't parse: %s\n", file.c_str(), error.c_str());
+	}
+	printf("%zu of %zu files parsed, %.1f MB, each loaded %d times\n\n", parsed, files.size(), (double)bytes / 1e6, repeats);
+
+	// One after another, as the modes did
+	Clock::time_point start = Clock::now();
+	for (int r = 0; r < repeats; r++)
+	{
+		for (const std::string& file : files)
+		{
+			DdsImage image;
+			std::string error;
+			Dds::Load(file, image, error);
+		}
+	}
+	double serial = Since(start);
+	printf("%10s %12s %10s %10s\n", "threads", "ms a pass", "MB/s", "speedup");
+	printf("%10s %12.2f %10.0f %9.2fx\n", "serial", serial * 1e3 / repeats, (double)bytes * repeats / serial / 1e6, 1.0);
+
+	// Everything requested up front, then waited on in the order it was asked for and let go of once
+	// it's been looked at, as TexCache::Finish does after the upload
+	for (size_t threads : threadCounts)
+	{
+		TextureLoader loader(threads);
+		size_t loaded = 0;
+		start = Clock::now();
+		for (int r = 0; r < repeats; r++)
+		{
+			std::vector<TextureLoader::Future> futures;
+			for (const std::string& file : files)
+				futures.push_back(loader.Load(file));
+			for (TextureLoader::Future& f : futures)
+			{
+				loaded += f.get()->mOk ? 1 : 0;
+				f = TextureLoader::Future();
+			}
+		}
+		double seconds = Since(start);
+		ok = ok && loaded == parsed * repeats;
+		printf("%10zu %12.2f %10.0f %9.2fx\n", loader.GetThreadCount(), seconds * 1e3 / repeats, (double)bytes * repeats / seconds / 1e6, serial / seconds);
+	}
+
+	printf("%s\n", ok ? "ok" : "FAILED: a parser check failed or the loader didn't parse what a serial load did");
+	return ok ? 0 : 1;
+}